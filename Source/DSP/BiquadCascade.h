@@ -0,0 +1,322 @@
+#pragma once
+#include <JuceHeader.h>
+#include "SimdFloat4.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+// Normalised biquad coefficients (a0 = 1). The default is a straight wire.
+struct BiquadCoefficients
+{
+    enum FilterType
+    {
+        PEAK = 0,
+        LOW_SHELF,
+        HIGH_SHELF,
+        LOW_PASS,
+        HIGH_PASS,
+        BAND_PASS
+    };
+
+    float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f;
+    float a1 = 0.0f, a2 = 0.0f;
+
+    // Audio EQ cookbook designs; gainDb only affects the peak and shelf types
+    static BiquadCoefficients make(FilterType type, double sampleRate, float frequency, float q, float gainDb)
+    {
+        const double freq = juce::jmin(static_cast<double>(frequency), 0.49 * sampleRate);
+        const double omega = juce::MathConstants<double>::twoPi * freq / sampleRate;
+        const double sinOmega = std::sin(omega);
+        const double cosOmega = std::cos(omega);
+        const double alpha = sinOmega / (2.0 * q);
+        const double A = std::pow(10.0, gainDb / 40.0);
+        const double beta = std::sqrt(A) / q;
+
+        double a0 = 1.0, a1 = 0.0, a2 = 0.0, b0 = 1.0, b1 = 0.0, b2 = 0.0;
+
+        switch (type)
+        {
+            case PEAK:
+                a0 = 1.0 + alpha / A;
+                a1 = -2.0 * cosOmega;
+                a2 = 1.0 - alpha / A;
+                b0 = 1.0 + alpha * A;
+                b1 = -2.0 * cosOmega;
+                b2 = 1.0 - alpha * A;
+                break;
+
+            case LOW_SHELF:
+                a0 = (A + 1.0) + (A - 1.0) * cosOmega + beta * sinOmega;
+                a1 = -2.0 * ((A - 1.0) + (A + 1.0) * cosOmega);
+                a2 = (A + 1.0) + (A - 1.0) * cosOmega - beta * sinOmega;
+                b0 = A * ((A + 1.0) - (A - 1.0) * cosOmega + beta * sinOmega);
+                b1 = 2.0 * A * ((A - 1.0) - (A + 1.0) * cosOmega);
+                b2 = A * ((A + 1.0) - (A - 1.0) * cosOmega - beta * sinOmega);
+                break;
+
+            case HIGH_SHELF:
+                a0 = (A + 1.0) - (A - 1.0) * cosOmega + beta * sinOmega;
+                a1 = 2.0 * ((A - 1.0) - (A + 1.0) * cosOmega);
+                a2 = (A + 1.0) - (A - 1.0) * cosOmega - beta * sinOmega;
+                b0 = A * ((A + 1.0) + (A - 1.0) * cosOmega + beta * sinOmega);
+                b1 = -2.0 * A * ((A - 1.0) + (A + 1.0) * cosOmega);
+                b2 = A * ((A + 1.0) + (A - 1.0) * cosOmega - beta * sinOmega);
+                break;
+
+            case LOW_PASS:
+                a0 = 1.0 + alpha;
+                a1 = -2.0 * cosOmega;
+                a2 = 1.0 - alpha;
+                b0 = (1.0 - cosOmega) / 2.0;
+                b1 = 1.0 - cosOmega;
+                b2 = (1.0 - cosOmega) / 2.0;
+                break;
+
+            case HIGH_PASS:
+                a0 = 1.0 + alpha;
+                a1 = -2.0 * cosOmega;
+                a2 = 1.0 - alpha;
+                b0 = (1.0 + cosOmega) / 2.0;
+                b1 = -(1.0 + cosOmega);
+                b2 = (1.0 + cosOmega) / 2.0;
+                break;
+
+            case BAND_PASS:
+                a0 = 1.0 + alpha;
+                a1 = -2.0 * cosOmega;
+                a2 = 1.0 - alpha;
+                b0 = alpha;
+                b1 = 0.0;
+                b2 = -alpha;
+                break;
+
+            default:
+                break;
+        }
+
+        BiquadCoefficients coefficients;
+        coefficients.b0 = static_cast<float>(b0 / a0);
+        coefficients.b1 = static_cast<float>(b1 / a0);
+        coefficients.b2 = static_cast<float>(b2 / a0);
+        coefficients.a1 = static_cast<float>(a1 / a0);
+        coefficients.a2 = static_cast<float>(a2 / a0);
+        return coefficients;
+    }
+};
+
+// Up to maxBands biquads in series on one or two channels, in transposed direct form II.
+// Each group of four bands shares a SimdFloat4, one band per lane, and the lanes form a
+// pipeline: on every step lane k filters the sample that lane k - 1 finished on the step
+// before, so four bands cost one vector biquad per sample. The pipeline fills and drains
+// within each process() call, so the cascade adds no latency. Coefficients glide linearly
+// from where they are to the latest targets over the course of each call.
+class BiquadCascade
+{
+public:
+    static constexpr int maxBands = 8;
+
+    BiquadCascade()
+    {
+        for (int band = 0; band < maxBands; ++band)
+            setTarget(band, {});
+        reset();
+    }
+
+    void setTarget(int band, const BiquadCoefficients& coefficients)
+    {
+        jassert(band >= 0 && band < maxBands);
+        const int group = band / 4, lane = band % 4;
+        target[group][0][lane] = coefficients.b0;
+        target[group][1][lane] = coefficients.b1;
+        target[group][2][lane] = coefficients.b2;
+        target[group][3][lane] = coefficients.a1;
+        target[group][4][lane] = coefficients.a2;
+    }
+
+    // Clears the filter state and jumps straight to the targets
+    void reset()
+    {
+        std::memcpy(current, target, sizeof(target));
+        std::fill(&state[0][0][0][0], &state[0][0][0][0] + sizeof(state) / sizeof(float), 0.0f);
+    }
+
+    // Filters in place; right may be null for a mono buffer
+    void process(float* left, float* right, int numSamples)
+    {
+        const int activeGroups = getActiveGroupCount();
+        if (activeGroups == 0 || numSamples <= 0)
+            return;
+
+        const bool ramping = std::memcmp(current, target, sizeof(target)) != 0;
+        if (ramping)
+        {
+            const float scale = 1.0f / static_cast<float>(numSamples);
+            for (int group = 0; group < numGroups; ++group)
+                for (int k = 0; k < numCoefficients; ++k)
+                    for (int lane = 0; lane < 4; ++lane)
+                        steps[group][k][lane] = (target[group][k][lane] - current[group][k][lane]) * scale;
+        }
+
+        float* const channels[2] = { left, right };
+        const bool stereo = right != nullptr;
+
+        if (activeGroups == 1)
+        {
+            if (stereo) ramping ? run<1, 2, true>(channels, numSamples) : run<1, 2, false>(channels, numSamples);
+            else        ramping ? run<1, 1, true>(channels, numSamples) : run<1, 1, false>(channels, numSamples);
+        }
+        else
+        {
+            if (stereo) ramping ? run<2, 2, true>(channels, numSamples) : run<2, 2, false>(channels, numSamples);
+            else        ramping ? run<2, 1, true>(channels, numSamples) : run<2, 1, false>(channels, numSamples);
+        }
+
+        // The glide lands on the targets exactly, whatever the rounding along the way
+        if (ramping)
+            std::memcpy(current, target, sizeof(target));
+    }
+
+private:
+    static constexpr int numGroups = maxBands / 4;
+    static constexpr int numCoefficients = 5; // b0, b1, b2, a1, a2
+
+    // Groups up to the last one that changes the signal: a band that is not a wire, now or
+    // after the glide, or a tail still leaving the state (a wire flushes it in two samples)
+    int getActiveGroupCount() const
+    {
+        for (int group = numGroups - 1; group >= 0; --group)
+            if (!isWire(current[group]) || !isWire(target[group]) || hasState(group))
+                return group + 1;
+        return 0;
+    }
+
+    bool hasState(int group) const
+    {
+        for (int channel = 0; channel < 2; ++channel)
+            for (int k = 0; k < 2; ++k)
+                for (int lane = 0; lane < 4; ++lane)
+                    if (state[channel][group][k][lane] != 0.0f)
+                        return true;
+        return false;
+    }
+
+    static bool isWire(const float (&coefficients)[numCoefficients][4])
+    {
+        for (int lane = 0; lane < 4; ++lane)
+        {
+            if (coefficients[0][lane] != 1.0f)
+                return false;
+            for (int k = 1; k < numCoefficients; ++k)
+                if (coefficients[k][lane] != 0.0f)
+                    return false;
+        }
+        return true;
+    }
+
+    template <int NumGroups, int NumChannels, bool Ramping>
+    void run(float* const* channels, int numSamples)
+    {
+        constexpr int depth = NumGroups * 4;
+        const int numSteps = numSamples + depth - 1;
+
+        SimdFloat4 c[NumGroups][numCoefficients], dc[NumGroups][numCoefficients];
+        for (int g = 0; g < NumGroups; ++g)
+            for (int k = 0; k < numCoefficients; ++k)
+            {
+                c[g][k] = SimdFloat4::load(current[g][k]);
+                dc[g][k] = Ramping ? SimdFloat4::load(steps[g][k]) : SimdFloat4::expand(0.0f);
+            }
+
+        // y holds each lane's latest output, which the next lane takes as input
+        SimdFloat4 s1[NumChannels][NumGroups], s2[NumChannels][NumGroups], y[NumChannels][NumGroups];
+        for (int ch = 0; ch < NumChannels; ++ch)
+            for (int g = 0; g < NumGroups; ++g)
+            {
+                s1[ch][g] = SimdFloat4::load(state[ch][g][0]);
+                s2[ch][g] = SimdFloat4::load(state[ch][g][1]);
+                y[ch][g] = SimdFloat4::expand(0.0f);
+            }
+
+        // Step t feeds sample t into band 0 while band b works on sample t - b. While the
+        // pipeline fills or drains, lanes with no sample of this block must not move.
+        auto step = [&](int t, auto masked)
+        {
+            constexpr bool isMasked = decltype(masked)::value;
+            SimdFloat4 mask[NumGroups], keep[NumGroups];
+            if constexpr (isMasked)
+            {
+                auto laneActive = [numSamples](int sample) { return sample >= 0 && sample < numSamples ? 1.0f : 0.0f; };
+                for (int g = 0; g < NumGroups; ++g)
+                {
+                    const int sample = t - 4 * g;
+                    mask[g] = SimdFloat4::fromValues(laneActive(sample), laneActive(sample - 1),
+                                                     laneActive(sample - 2), laneActive(sample - 3));
+                    keep[g] = SimdFloat4::expand(1.0f) - mask[g];
+                }
+            }
+
+            for (int ch = 0; ch < NumChannels; ++ch)
+            {
+                float carry = t < numSamples ? channels[ch][t] : 0.0f;
+                for (int g = 0; g < NumGroups; ++g)
+                {
+                    const auto in = y[ch][g].shiftLanesUp(carry);
+                    carry = y[ch][g].template get<3>();
+
+                    const auto out = c[g][0] * in + s1[ch][g];
+                    const auto next1 = c[g][1] * in - c[g][3] * out + s2[ch][g];
+                    const auto next2 = c[g][2] * in - c[g][4] * out;
+                    if constexpr (isMasked)
+                    {
+                        // One of the two products is zero, so the update is exact
+                        s1[ch][g] = mask[g] * next1 + keep[g] * s1[ch][g];
+                        s2[ch][g] = mask[g] * next2 + keep[g] * s2[ch][g];
+                    }
+                    else
+                    {
+                        s1[ch][g] = next1;
+                        s2[ch][g] = next2;
+                    }
+                    y[ch][g] = out;
+                }
+
+                // The last band has just finished sample t - depth + 1
+                if (t >= depth - 1)
+                    channels[ch][t - depth + 1] = y[ch][NumGroups - 1].template get<3>();
+            }
+
+            if constexpr (Ramping)
+            {
+                for (int g = 0; g < NumGroups; ++g)
+                    for (int k = 0; k < numCoefficients; ++k)
+                    {
+                        if constexpr (isMasked)
+                            c[g][k] += mask[g] * dc[g][k];
+                        else
+                            c[g][k] += dc[g][k];
+                    }
+            }
+        };
+
+        int t = 0;
+        for (; t < juce::jmin(depth - 1, numSteps); ++t)
+            step(t, std::true_type {});
+        for (; t < numSamples; ++t)
+            step(t, std::false_type {});
+        for (; t < numSteps; ++t)
+            step(t, std::true_type {});
+
+        for (int ch = 0; ch < NumChannels; ++ch)
+            for (int g = 0; g < NumGroups; ++g)
+            {
+                s1[ch][g].store(state[ch][g][0]);
+                s2[ch][g].store(state[ch][g][1]);
+            }
+    }
+
+    alignas(16) float current[numGroups][numCoefficients][4];
+    alignas(16) float target[numGroups][numCoefficients][4];
+    alignas(16) float steps[numGroups][numCoefficients][4] {};
+    alignas(16) float state[2][numGroups][2][4]; // Channel, group, s1/s2, lane
+};
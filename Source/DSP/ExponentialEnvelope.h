@@ -0,0 +1,203 @@
+#pragma once
+#include <JuceHeader.h>
+#include <cmath>
+
+// ADSR with analog-style exponential segments, rendered as a block of gains at a time.
+// Each segment is a one-pole approach to a target just beyond its end point, so a
+// segment costs a multiply-add per sample and finishes in exactly its set time: the
+// attack charges from silence towards an overshoot like an RC stage, decay falls from
+// full level and release from the level at note off, each towards a point just below
+// its end (a retriggered attack starts higher, so it arrives early). The envelope also
+// says when it can no longer be heard, which lets a voice free itself without waiting
+// out the tail.
+class ExponentialEnvelope
+{
+public:
+    struct Parameters
+    {
+        float attack = 0.1f;  // Seconds
+        float decay = 0.8f;   // Seconds
+        float sustain = 0.3f; // Level
+        float release = 0.5f; // Seconds
+    };
+
+    // -80 dB: below this the envelope counts as silent
+    static constexpr float silenceThreshold = 1.0e-4f;
+
+    ExponentialEnvelope()
+    {
+        updateCoefficients();
+    }
+
+    void setSampleRate(double newSampleRate)
+    {
+        if (newSampleRate == sampleRate || newSampleRate <= 0.0)
+            return;
+
+        sampleRate = newSampleRate;
+        updateCoefficients();
+    }
+
+    void setParameters(const Parameters& newParameters)
+    {
+        parameters = newParameters;
+        parameters.sustain = juce::jlimit(0.0f, 1.0f, parameters.sustain);
+        updateCoefficients();
+
+        if (state == SUSTAIN)
+            level = parameters.sustain;
+    }
+
+    const Parameters& getParameters() const { return parameters; }
+
+    // Retriggers from the current level, so a stolen or repeated voice does not click
+    void noteOn()
+    {
+        state = ATTACK;
+    }
+
+    void noteOff()
+    {
+        if (state == IDLE)
+            return;
+
+        state = RELEASE;
+        releaseStartLevel = level;
+        updateReleaseCoefficient();
+    }
+
+    void reset()
+    {
+        state = IDLE;
+        level = 0.0;
+    }
+
+    bool isActive() const { return state != IDLE; }
+
+    // False once the level is below the silence threshold and is not going to rise above
+    // it again: releasing, or decaying to (or sitting at) an inaudible sustain level
+    bool isAudible() const
+    {
+        if (state == IDLE)
+            return false;
+        if (state == ATTACK || level >= silenceThreshold)
+            return true;
+        return state != RELEASE && parameters.sustain >= silenceThreshold;
+    }
+
+    float getLevel() const { return static_cast<float>(level); }
+
+    // Writes the next numSamples gains
+    void render(float* gains, int numSamples)
+    {
+        int i = 0;
+        while (i < numSamples)
+        {
+            switch (state)
+            {
+                case ATTACK:
+                    for (; i < numSamples && state == ATTACK; ++i)
+                    {
+                        level = attackBase + level * attackCoefficient;
+                        if (level >= 1.0)
+                        {
+                            level = 1.0;
+                            state = DECAY;
+                        }
+                        gains[i] = static_cast<float>(level);
+                    }
+                    break;
+
+                case DECAY:
+                    for (; i < numSamples && state == DECAY; ++i)
+                    {
+                        level = decayBase + level * decayCoefficient;
+                        if (level <= parameters.sustain)
+                        {
+                            level = parameters.sustain;
+                            state = SUSTAIN;
+                        }
+                        gains[i] = static_cast<float>(level);
+                    }
+                    break;
+
+                case SUSTAIN:
+                    for (; i < numSamples; ++i)
+                        gains[i] = static_cast<float>(level);
+                    break;
+
+                case RELEASE:
+                    for (; i < numSamples && state == RELEASE; ++i)
+                    {
+                        level = releaseBase + level * releaseCoefficient;
+                        if (level <= 0.0)
+                        {
+                            level = 0.0;
+                            state = IDLE;
+                        }
+                        gains[i] = static_cast<float>(level);
+                    }
+                    break;
+
+                case IDLE:
+                default:
+                    for (; i < numSamples; ++i)
+                        gains[i] = 0.0f;
+                    break;
+            }
+        }
+    }
+
+private:
+    enum State
+    {
+        IDLE = 0,
+        ATTACK,
+        DECAY,
+        SUSTAIN,
+        RELEASE
+    };
+
+    // How far past its end point each segment aims: a large overshoot gives the attack
+    // its rounded RC shape, a tiny one makes decay and release true exponentials
+    static constexpr double attackOvershoot = 0.3;
+    static constexpr double decayOvershoot = 1.0e-4;
+
+    // Coefficient that takes a segment from its start to its end point in the given time.
+    // Distances are to the segment's target: the end point is overshoot away from it.
+    double getCoefficient(float seconds, double startDistance, double overshoot) const
+    {
+        const double samples = seconds * sampleRate;
+        if (samples <= 1.0)
+            return 0.0;
+        return std::exp(-std::log(startDistance / overshoot) / samples);
+    }
+
+    void updateCoefficients()
+    {
+        attackCoefficient = getCoefficient(parameters.attack, 1.0 + attackOvershoot, attackOvershoot);
+        attackBase = (1.0 + attackOvershoot) * (1.0 - attackCoefficient);
+
+        decayCoefficient = getCoefficient(parameters.decay, 1.0 - parameters.sustain + decayOvershoot, decayOvershoot);
+        decayBase = (parameters.sustain - decayOvershoot) * (1.0 - decayCoefficient);
+
+        updateReleaseCoefficient();
+    }
+
+    // Release runs from wherever note off caught the envelope down to zero
+    void updateReleaseCoefficient()
+    {
+        releaseCoefficient = getCoefficient(parameters.release, releaseStartLevel + decayOvershoot, decayOvershoot);
+        releaseBase = -decayOvershoot * (1.0 - releaseCoefficient);
+    }
+
+    Parameters parameters;
+    double sampleRate = 44100.0;
+    State state = IDLE;
+    double level = 0.0; // Double: in float, the last steps of a decay to a high sustain round away
+
+    double attackCoefficient = 0.0, attackBase = 1.0;
+    double decayCoefficient = 0.0, decayBase = 0.0;
+    double releaseCoefficient = 0.0, releaseBase = 0.0;
+    double releaseStartLevel = 1.0;
+};
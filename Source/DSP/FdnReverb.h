@@ -0,0 +1,274 @@
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+#include "SimdFloat4.h"
+
+// Eight-line feedback delay network reverb. The lines are stored interleaved so the
+// eight new samples are written with two vector stores, and the feedback matrix is
+// a 2x2 Hadamard of two 4x4 Householder reflections (x - 0.5 * sum(x)), which is
+// orthogonal and needs nothing but adds, multiplies and one horizontal sum per half.
+// Each algorithm has its own delay set, input diffusion, decay range and damping.
+class FdnReverb
+{
+public:
+    static constexpr int numLines = 8;
+    static constexpr int maxDiffusionStages = 4;
+
+    enum Algorithm
+    {
+        PLATE = 0,
+        HALL,
+        VINTAGE,
+        ROOM,
+        AMBIENCE,
+        NUM_ALGORITHMS
+    };
+
+    struct AlgorithmSettings
+    {
+        float delayMs[numLines];
+        int diffusionStages;
+        float diffusionMs[maxDiffusionStages];
+        float diffusionGain;
+        float minDecaySeconds, maxDecaySeconds; // RT60 at size 0 and size 1
+        float brightCutoff, darkCutoff;         // In-loop damping at damping 0 and damping 1
+        float inputCutoff;                      // Input bandwidth
+        float earlyLevel;                       // Diffused input sent straight to the output
+    };
+
+    static const AlgorithmSettings& getSettings(int algorithm)
+    {
+        static const AlgorithmSettings settings[NUM_ALGORITHMS] =
+        {
+            // Plate: short, dense lines behind heavy diffusion, bright
+            { { 13.7f, 17.3f, 19.9f, 23.3f, 27.1f, 29.9f, 31.7f, 37.1f }, 4, { 4.7f, 3.6f, 12.7f, 9.3f }, 0.7f,
+              0.6f, 6.0f, 16000.0f, 3000.0f, 16000.0f, 0.0f },
+            // Hall: long lines, light diffusion so the build-up stays audible
+            { { 37.3f, 43.1f, 50.9f, 57.7f, 65.3f, 73.1f, 81.7f, 89.9f }, 2, { 11.3f, 7.9f, 0.0f, 0.0f }, 0.6f,
+              1.2f, 12.0f, 12000.0f, 1500.0f, 12000.0f, 0.1f },
+            // Vintage: band-limited input, dark loop, sparse diffusion
+            { { 23.1f, 29.3f, 33.7f, 41.9f, 47.3f, 53.9f, 61.1f, 67.7f }, 1, { 8.9f, 0.0f, 0.0f, 0.0f }, 0.5f,
+              0.5f, 5.0f, 7000.0f, 1200.0f, 6000.0f, 0.0f },
+            // Room: short lines with strong early reflections
+            { { 7.9f, 11.3f, 13.1f, 16.7f, 19.3f, 23.9f, 27.7f, 31.3f }, 3, { 3.1f, 5.3f, 7.7f, 0.0f }, 0.65f,
+              0.2f, 2.0f, 14000.0f, 2500.0f, 14000.0f, 0.35f },
+            // Ambience: very short, quickly decaying space
+            { { 3.3f, 4.7f, 5.9f, 7.1f, 8.3f, 9.7f, 11.9f, 13.1f }, 4, { 1.3f, 2.1f, 2.9f, 3.7f }, 0.7f,
+              0.1f, 0.8f, 18000.0f, 4000.0f, 18000.0f, 0.2f }
+        };
+
+        return settings[juce::jlimit(0, NUM_ALGORITHMS - 1, algorithm)];
+    }
+
+    // Allocates every line for the longest algorithm, so switching never allocates
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+
+        float longestDelayMs = 0.0f, longestDiffusionMs = 0.0f;
+        for (int algorithm = 0; algorithm < NUM_ALGORITHMS; ++algorithm)
+        {
+            const auto& s = getSettings(algorithm);
+            for (float ms : s.delayMs)
+                longestDelayMs = juce::jmax(longestDelayMs, ms);
+            for (float ms : s.diffusionMs)
+                longestDiffusionMs = juce::jmax(longestDiffusionMs, ms);
+        }
+
+        lineSize = juce::nextPowerOfTwo(static_cast<int>(longestDelayMs * 0.001 * sampleRate) + 2);
+        lineStorage.assign(static_cast<size_t>(lineSize * numLines + 4), 0.0f);
+
+        // Align the interleaved lines to 16 bytes for the vector loads and stores
+        lines = lineStorage.data();
+        while ((reinterpret_cast<uintptr_t>(lines) & 15) != 0)
+            ++lines;
+
+        diffusionSize = juce::nextPowerOfTwo(static_cast<int>(longestDiffusionMs * 0.001 * sampleRate) + 2);
+        for (auto& channel : diffusers)
+            for (auto& stage : channel)
+                stage.assign(static_cast<size_t>(diffusionSize), 0.0f);
+
+        setAlgorithm(algorithm);
+    }
+
+    // Clears the network, as the old tail does not fit the new delay set
+    void setAlgorithm(int newAlgorithm)
+    {
+        algorithm = juce::jlimit(0, NUM_ALGORITHMS - 1, newAlgorithm);
+        const auto& s = getSettings(algorithm);
+
+        for (int line = 0; line < numLines; ++line)
+            delayLengths[line] = juce::jlimit(1, lineSize - 1, static_cast<int>(s.delayMs[line] * 0.001 * sampleRate));
+
+        for (int stage = 0; stage < maxDiffusionStages; ++stage)
+            diffusionLengths[stage] = juce::jlimit(1, diffusionSize - 1, static_cast<int>(s.diffusionMs[stage] * 0.001 * sampleRate));
+
+        inputCoefficient = getOnePoleCoefficient(s.inputCutoff);
+        reset();
+        updateLoop();
+    }
+
+    int getAlgorithm() const { return algorithm; }
+
+    // Size and damping are 0 to 1; cheap to call once per block with unchanged values
+    void setSizeAndDamping(float newSize, float newDamping)
+    {
+        if (newSize == size && newDamping == damping)
+            return;
+
+        size = newSize;
+        damping = newDamping;
+        updateLoop();
+    }
+
+    void setWidth(float newWidth) { width = newWidth; }
+
+    // RT60 for the current algorithm and size
+    float getDecaySeconds() const
+    {
+        const auto& s = getSettings(algorithm);
+        return s.minDecaySeconds * std::pow(s.maxDecaySeconds / s.minDecaySeconds, size);
+    }
+
+    void reset()
+    {
+        std::fill(lineStorage.begin(), lineStorage.end(), 0.0f);
+        for (auto& channel : diffusers)
+            for (auto& stage : channel)
+                std::fill(stage.begin(), stage.end(), 0.0f);
+
+        std::fill(std::begin(dampingState), std::end(dampingState), 0.0f);
+        inputState[0] = inputState[1] = 0.0f;
+        writePosition = 0;
+        diffusionPosition = 0;
+    }
+
+    // Renders the wet signal only; the outputs may point at the inputs
+    void process(const float* inputLeft, const float* inputRight, float* outputLeft, float* outputRight, int numSamples)
+    {
+        if (lines == nullptr)
+            return;
+
+        const auto& s = getSettings(algorithm);
+        const int lineMask = lineSize - 1;
+        const int diffusionMask = diffusionSize - 1;
+
+        const auto decay0 = SimdFloat4::load(decayGains);
+        const auto decay1 = SimdFloat4::load(decayGains + 4);
+        const auto dampCoefficient = SimdFloat4::expand(dampingCoefficient);
+        const auto halfVector = SimdFloat4::expand(0.5f);
+        const auto invSqrt2 = SimdFloat4::expand(0.70710678f);
+        const auto tapLeft0 = SimdFloat4::fromValues(0.5f, 0.5f, -0.5f, 0.5f);
+        const auto tapLeft1 = SimdFloat4::fromValues(-0.5f, 0.5f, 0.5f, -0.5f);
+        const auto tapRight0 = SimdFloat4::fromValues(0.5f, -0.5f, 0.5f, 0.5f);
+        const auto tapRight1 = SimdFloat4::fromValues(0.5f, 0.5f, -0.5f, -0.5f);
+        const auto injectLeft = SimdFloat4::fromValues(1.0f, -1.0f, 1.0f, -1.0f);
+        const auto injectRight = SimdFloat4::fromValues(-1.0f, 1.0f, -1.0f, 1.0f);
+
+        auto lowpass0 = SimdFloat4::load(dampingState);
+        auto lowpass1 = SimdFloat4::load(dampingState + 4);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            // Band-limit and diffuse the input
+            float left = inputState[0] += inputCoefficient * (inputLeft[i] - inputState[0]);
+            float right = inputState[1] += inputCoefficient * (inputRight[i] - inputState[1]);
+
+            for (int stage = 0; stage < s.diffusionStages; ++stage)
+            {
+                left = processAllPass(diffusers[0][stage].data(), left, stage, s.diffusionGain, diffusionMask);
+                right = processAllPass(diffusers[1][stage].data(), right, stage, s.diffusionGain, diffusionMask);
+            }
+            diffusionPosition = (diffusionPosition + 1) & diffusionMask;
+
+            // Read every line (the only per-lane step) and damp it
+            const auto read0 = SimdFloat4::fromValues(readLine(0, lineMask), readLine(1, lineMask), readLine(2, lineMask), readLine(3, lineMask));
+            const auto read1 = SimdFloat4::fromValues(readLine(4, lineMask), readLine(5, lineMask), readLine(6, lineMask), readLine(7, lineMask));
+            lowpass0 += dampCoefficient * (read0 - lowpass0);
+            lowpass1 += dampCoefficient * (read1 - lowpass1);
+
+            const float wetLeft = (lowpass0 * tapLeft0 + lowpass1 * tapLeft1).sum() + left * s.earlyLevel;
+            const float wetRight = (lowpass0 * tapRight0 + lowpass1 * tapRight1).sum() + right * s.earlyLevel;
+
+            // Feedback matrix: Householder inside each half, Hadamard across the halves
+            const auto decayed0 = lowpass0 * decay0;
+            const auto decayed1 = lowpass1 * decay1;
+            const auto house0 = decayed0 - halfVector * SimdFloat4::expand(decayed0.sum());
+            const auto house1 = decayed1 - halfVector * SimdFloat4::expand(decayed1.sum());
+            const auto feedback0 = (house0 + house1) * invSqrt2 + injectLeft * SimdFloat4::expand(left);
+            const auto feedback1 = (house0 - house1) * invSqrt2 + injectRight * SimdFloat4::expand(right);
+
+            float* write = lines + writePosition * numLines;
+            feedback0.store(write);
+            feedback1.store(write + 4);
+            writePosition = (writePosition + 1) & lineMask;
+
+            // Stereo width on the wet signal only
+            const float mid = (wetLeft + wetRight) * 0.5f;
+            const float side = (wetLeft - wetRight) * 0.5f * width;
+            outputLeft[i] = mid + side;
+            outputRight[i] = mid - side;
+        }
+
+        lowpass0.store(dampingState);
+        lowpass1.store(dampingState + 4);
+    }
+
+private:
+    float readLine(int line, int lineMask) const
+    {
+        return lines[((writePosition - delayLengths[line]) & lineMask) * numLines + line];
+    }
+
+    float processAllPass(float* buffer, float input, int stage, float gain, int mask)
+    {
+        const float delayed = buffer[(diffusionPosition - diffusionLengths[stage]) & mask];
+        const float v = input + gain * delayed;
+        buffer[diffusionPosition] = v;
+        return delayed - gain * v;
+    }
+
+    float getOnePoleCoefficient(float cutoff) const
+    {
+        const double limited = juce::jmin(static_cast<double>(cutoff), sampleRate * 0.45);
+        return static_cast<float>(1.0 - std::exp(-juce::MathConstants<double>::twoPi * limited / sampleRate));
+    }
+
+    // Per-line gains so every line loses 60 dB over the decay time
+    void updateLoop()
+    {
+        const auto& s = getSettings(algorithm);
+        const double decaySeconds = getDecaySeconds();
+
+        for (int line = 0; line < numLines; ++line)
+            decayGains[line] = static_cast<float>(std::pow(10.0, -3.0 * delayLengths[line] / (decaySeconds * sampleRate)));
+
+        const float cutoff = s.brightCutoff * std::pow(s.darkCutoff / s.brightCutoff, damping);
+        dampingCoefficient = getOnePoleCoefficient(cutoff);
+    }
+
+    double sampleRate = 44100.0;
+    int algorithm = HALL;
+    float size = 0.5f;
+    float damping = 0.5f;
+    float width = 1.0f;
+
+    // Interleaved delay lines: sample n of line k lives at lines[n * numLines + k]
+    std::vector<float> lineStorage;
+    float* lines = nullptr;
+    int lineSize = 0;
+    int writePosition = 0;
+    int delayLengths[numLines] = {};
+
+    alignas(16) float decayGains[numLines] = {};
+    alignas(16) float dampingState[numLines] = {};
+    float dampingCoefficient = 1.0f;
+
+    // Input band-limiting and diffusion, per channel
+    float inputState[2] = { 0.0f, 0.0f };
+    float inputCoefficient = 1.0f;
+    std::vector<float> diffusers[2][maxDiffusionStages];
+    int diffusionSize = 0;
+    int diffusionPosition = 0;
+    int diffusionLengths[maxDiffusionStages] = {};
+};
@@ -0,0 +1,171 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include "SimdFloat4.h"
+
+// Vowel filter: the first three formants as parallel state-variable bandpasses, one per
+// SIMD lane, so all three bands advance in a single vector step. The vowel position
+// morphs continuously through a, e, i, o and u. Formant frequencies are kept as positions
+// on a 1/24-octave grid whose prewarped tan terms are tabulated once per sample rate, so
+// moving the vowel or the shift costs table lookups rather than three tan calls.
+class FormantFilter
+{
+public:
+    static constexpr int numVowels = 5; // a, e, i, o, u
+    static constexpr int controlInterval = 16; // Samples between coefficient updates while gliding
+
+    FormantFilter()
+    {
+        setSampleRate(44100.0);
+        reset();
+    }
+
+    // Rebuilds the frequency table, which only happens when the rate actually changes
+    void setSampleRate(double newSampleRate)
+    {
+        if (newSampleRate == tableSampleRate || newSampleRate <= 0.0)
+            return;
+
+        tableSampleRate = newSampleRate;
+        const double highestFrequency = 0.45 * newSampleRate;
+
+        for (int i = 0; i < tableSize; ++i)
+        {
+            const double frequency = juce::jmin(highestFrequency, lowestFrequency * std::pow(2.0, i / static_cast<double>(stepsPerOctave)));
+            tanTable[static_cast<size_t>(i)] = static_cast<float>(std::tan(juce::MathConstants<double>::pi * frequency / newSampleRate));
+        }
+
+        updateCoefficients();
+    }
+
+    // vowelPosition runs from 0 (a) to 4 (u); frequencyShift scales every formant;
+    // q sets the sharpness of all three bands
+    void setParameters(float vowelPosition, float frequencyShift, float q)
+    {
+        vowel = juce::jlimit(0.0f, static_cast<float>(numVowels - 1), vowelPosition);
+        shiftSteps = stepsPerOctave * std::log2(juce::jmax(1.0e-3f, frequencyShift));
+        k = 1.0f / juce::jlimit(0.5f, 40.0f, q);
+        updateCoefficients();
+    }
+
+    void reset()
+    {
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            for (int lane = 0; lane < 4; ++lane)
+            {
+                ic1[ch][lane] = 0.0f;
+                ic2[ch][lane] = 0.0f;
+            }
+        }
+    }
+
+    float processSample(float input, int channel)
+    {
+        const int ch = channel & 1;
+        const auto x = SimdFloat4::expand(input);
+        const auto state1 = SimdFloat4::load(ic1[ch]);
+        const auto state2 = SimdFloat4::load(ic2[ch]);
+
+        const auto v3 = x - state2;
+        const auto v1 = SimdFloat4::load(a1) * state1 + SimdFloat4::load(a2) * v3;
+        const auto v2 = state2 + SimdFloat4::load(a2) * state1 + SimdFloat4::load(a3) * v3;
+        (v1 + v1 - state1).store(ic1[ch]);
+        (v2 + v2 - state2).store(ic2[ch]);
+
+        // Bandpass outputs are k * v1; the gains already include k
+        return (SimdFloat4::load(outputGains) * v1).sum();
+    }
+
+private:
+    static constexpr double lowestFrequency = 20.0;
+    static constexpr int stepsPerOctave = 24;
+    static constexpr int tableSize = 14 * stepsPerOctave; // 20 Hz up past 0.45 of 384 kHz
+
+    // Formant centres (Hz) and levels (dB) of a sung bass voice
+    struct Vowel
+    {
+        float frequencies[3];
+        float levelsDb[3];
+    };
+
+    static const Vowel& getVowel(int index)
+    {
+        static const Vowel vowels[numVowels] = {
+            { { 600.0f, 1040.0f, 2250.0f }, { 0.0f,  -7.0f,  -9.0f } }, // a
+            { { 400.0f, 1620.0f, 2400.0f }, { 0.0f, -12.0f,  -9.0f } }, // e
+            { { 250.0f, 1750.0f, 2600.0f }, { 0.0f, -30.0f, -16.0f } }, // i
+            { { 400.0f,  750.0f, 2400.0f }, { 0.0f, -11.0f, -21.0f } }, // o
+            { { 350.0f,  600.0f, 2400.0f }, { 0.0f, -20.0f, -32.0f } }  // u
+        };
+        return vowels[index];
+    }
+
+    // The vowels as table positions and linear gains, so morphing interpolates in pitch
+    struct VowelTable
+    {
+        float positions[numVowels][3];
+        float gains[numVowels][3];
+    };
+
+    static const VowelTable& getVowelTable()
+    {
+        static const VowelTable table = []
+        {
+            VowelTable t {};
+            for (int v = 0; v < numVowels; ++v)
+            {
+                for (int band = 0; band < 3; ++band)
+                {
+                    t.positions[v][band] = static_cast<float>(stepsPerOctave * std::log2(getVowel(v).frequencies[band] / lowestFrequency));
+                    t.gains[v][band] = 0.5f * juce::Decibels::decibelsToGain(getVowel(v).levelsDb[band]);
+                }
+            }
+            return t;
+        }();
+        return table;
+    }
+
+    float lookupTan(float position) const
+    {
+        const float clamped = juce::jlimit(0.0f, static_cast<float>(tableSize - 2), position);
+        const int index = static_cast<int>(clamped);
+        const float fraction = clamped - static_cast<float>(index);
+        const float low = tanTable[static_cast<size_t>(index)];
+        return low + fraction * (tanTable[static_cast<size_t>(index + 1)] - low);
+    }
+
+    void updateCoefficients()
+    {
+        const auto& table = getVowelTable();
+        const int lower = juce::jmin(static_cast<int>(vowel), numVowels - 2);
+        const float morph = vowel - static_cast<float>(lower);
+
+        for (int band = 0; band < 3; ++band)
+        {
+            const float position = table.positions[lower][band] + morph * (table.positions[lower + 1][band] - table.positions[lower][band]);
+            const float gain = table.gains[lower][band] + morph * (table.gains[lower + 1][band] - table.gains[lower][band]);
+            const float g = lookupTan(position + shiftSteps);
+
+            a1[band] = 1.0f / (1.0f + g * (g + k));
+            a2[band] = g * a1[band];
+            a3[band] = g * a2[band];
+            outputGains[band] = gain * k;
+        }
+    }
+
+    std::array<float, tableSize> tanTable {};
+    double tableSampleRate = 0.0;
+
+    float vowel = 0.0f;
+    float shiftSteps = 0.0f;
+    float k = 0.25f;
+
+    // Lane 3 is unused: a1 = 1 and zero gain keep it silent
+    alignas(16) float a1[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    alignas(16) float a2[4] = {};
+    alignas(16) float a3[4] = {};
+    alignas(16) float outputGains[4] = {};
+    alignas(16) float ic1[2][4] = {};
+    alignas(16) float ic2[2][4] = {};
+};
@@ -0,0 +1,104 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+
+// Low-frequency oscillator that plays back a drawn shape. The shape is compiled into a
+// fixed-size table on the message thread and handed over whole, so the audio thread
+// never sees a half-written curve. The LFO is evaluated once per control block: one
+// interpolated table read, after which the phase jumps ahead by the block length.
+class LfoEngine
+{
+public:
+    static constexpr int tableSize = 256;
+    using Table = std::array<float, tableSize>; // One cycle, -1 to 1
+
+    enum Mode
+    {
+        FREE = 0,    // Runs continuously at the rate in Hz
+        RETRIGGER,   // As FREE, but every note-on restarts the cycle
+        TEMPO_SYNC   // One cycle per note division, locked to the host's beat position
+    };
+
+    // Evenly spaced points from the LFO editor (0 = bottom, 1 = top) covering one cycle
+    static Table compileTable(const std::vector<float>& points)
+    {
+        Table table {};
+        if (points.empty())
+            return table;
+
+        const int numPoints = static_cast<int>(points.size());
+        for (int i = 0; i < tableSize; ++i)
+        {
+            const float position = i * static_cast<float>(numPoints - 1) / tableSize;
+            const int index = static_cast<int>(position);
+            const float fraction = position - static_cast<float>(index);
+            const float low = points[static_cast<size_t>(index)];
+            const float high = points[static_cast<size_t>(juce::jmin(index + 1, numPoints - 1))];
+            table[static_cast<size_t>(i)] = juce::jlimit(-1.0f, 1.0f, 2.0f * (low + fraction * (high - low)) - 1.0f);
+        }
+        return table;
+    }
+
+    static Table makeSineTable()
+    {
+        Table table {};
+        for (int i = 0; i < tableSize; ++i)
+            table[static_cast<size_t>(i)] = std::sin(juce::MathConstants<float>::twoPi * i / tableSize);
+        return table;
+    }
+
+    LfoEngine()
+    {
+        table = makeSineTable();
+    }
+
+    void setSampleRate(double newSampleRate) { sampleRate = newSampleRate; }
+    void setTable(const Table& newTable) { table = newTable; }
+    void setMode(Mode newMode) { mode = newMode; }
+    Mode getMode() const { return mode; }
+    void setRateHz(float newRate) { rateHz = juce::jlimit(0.001f, 100.0f, newRate); }
+    void setSyncBeats(double beatsPerCycle) { syncBeats = juce::jmax(1.0 / 64.0, beatsPerCycle); }
+
+    // Samples between evaluations; the modulation routes are refreshed at this rate
+    void setControlInterval(int samples) { controlInterval = juce::jlimit(1, 1024, samples); }
+    int getControlInterval() const { return controlInterval; }
+
+    void retrigger() { phase = 0.0; }
+
+    // Tempo sync while the host is playing: the phase follows the host's beat position
+    void syncToPosition(double ppqPosition)
+    {
+        const double cycles = ppqPosition / syncBeats;
+        phase = cycles - std::floor(cycles);
+    }
+
+    // Value at the current phase, then moves the phase on by numSamples
+    float advance(int numSamples, double bpm)
+    {
+        const float position = static_cast<float>(phase * tableSize);
+        const int index = static_cast<int>(position);
+        const float fraction = position - static_cast<float>(index);
+        const float low = table[static_cast<size_t>(index & (tableSize - 1))];
+        const float high = table[static_cast<size_t>((index + 1) & (tableSize - 1))];
+        currentValue = low + fraction * (high - low);
+
+        const double cyclesPerSecond = mode == TEMPO_SYNC ? bpm / 60.0 / syncBeats : static_cast<double>(rateHz);
+        phase += cyclesPerSecond * numSamples / sampleRate;
+        phase -= std::floor(phase);
+
+        return currentValue;
+    }
+
+    float getCurrentValue() const { return currentValue; }
+
+private:
+    Table table {};
+    double sampleRate = 44100.0;
+    double phase = 0.0; // Cycles, 0 to 1
+    Mode mode = FREE;
+    float rateHz = 1.0f;
+    double syncBeats = 4.0; // Quarter notes per cycle
+    int controlInterval = 32;
+    float currentValue = 0.0f;
+};
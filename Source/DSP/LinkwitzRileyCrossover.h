@@ -0,0 +1,67 @@
+#pragma once
+#include <JuceHeader.h>
+
+// Fourth-order (24 dB/oct) Linkwitz-Riley crossover, built as two cascaded Butterworth
+// TPT state-variable stages. A single pass yields both the low and the high output, and
+// the two always sum to a second-order allpass, so a band split this way adds back up
+// with a flat magnitude. processAllPassSample applies that same allpass on its own, which keeps
+// a band that skipped this crossover phase-aligned with the bands that went through it.
+class LinkwitzRileyCrossover
+{
+public:
+    void prepare(double sampleRate, float frequency)
+    {
+        const double limited = juce::jlimit(20.0, sampleRate * 0.45, static_cast<double>(frequency));
+        g = static_cast<float>(std::tan(juce::MathConstants<double>::pi * limited / sampleRate));
+        h = 1.0f / (1.0f + r2 * g + g * g);
+        reset();
+    }
+
+    void reset()
+    {
+        for (int ch = 0; ch < 2; ++ch)
+            s1[ch] = s2[ch] = s3[ch] = s4[ch] = 0.0f;
+    }
+
+    // Splits one sample of the given channel (0 = left, 1 = right) into low and high.
+    // Called inline per sample, so a band-splitting loop can interleave channels and
+    // crossovers instead of waiting on one filter's feedback at a time.
+    void processSample(float input, int channel, float& low, float& high)
+    {
+        const int ch = channel & 1;
+        float lowpass, bandpass, highpass;
+        processStage(input, s1[ch], s2[ch], lowpass, bandpass, highpass);
+        const float allpass = lowpass - r2 * bandpass + highpass;
+
+        float lowpass2, bandpass2, highpass2;
+        processStage(lowpass, s3[ch], s4[ch], lowpass2, bandpass2, highpass2);
+
+        low = lowpass2;
+        high = allpass - lowpass2;
+    }
+
+    // Second-order allpass at the crossover frequency
+    float processAllPassSample(float input, int channel)
+    {
+        const int ch = channel & 1;
+        float lowpass, bandpass, highpass;
+        processStage(input, s1[ch], s2[ch], lowpass, bandpass, highpass);
+        return lowpass - r2 * bandpass + highpass;
+    }
+
+private:
+    // One Butterworth state-variable stage (Q = 1 / sqrt(2))
+    void processStage(float input, float& z1, float& z2, float& lowpass, float& bandpass, float& highpass) const
+    {
+        highpass = (input - (r2 + g) * z1 - z2) * h;
+        bandpass = g * highpass + z1;
+        z1 = g * highpass + bandpass;
+        lowpass = g * bandpass + z2;
+        z2 = g * bandpass + lowpass;
+    }
+
+    static constexpr float r2 = 1.41421356f; // 1 / Q
+    float g = 0.0f;
+    float h = 1.0f;
+    float s1[2] = {}, s2[2] = {}, s3[2] = {}, s4[2] = {};
+};
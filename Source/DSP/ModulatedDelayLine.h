@@ -0,0 +1,234 @@
+#pragma once
+#include <JuceHeader.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Sine/cosine pair from a recursive rotation: each sample turns the (cos, sin) vector by
+// the phase increment, two multiply-adds per output instead of a std::sin call. Any phase
+// offset is a fixed mix of the pair, sin(x + p) = sin(x) cos(p) + cos(x) sin(p), so one
+// oscillator drives every tap of an effect. The vector is renormalised once per block.
+class QuadratureOscillator
+{
+public:
+    void setFrequency(float frequencyHz, double sampleRate)
+    {
+        const double increment = juce::MathConstants<double>::twoPi * frequencyHz / sampleRate;
+        rotationCos = static_cast<float>(std::cos(increment));
+        rotationSin = static_cast<float>(std::sin(increment));
+    }
+
+    void reset(float phaseRadians = 0.0f)
+    {
+        cosine = std::cos(phaseRadians);
+        sine = std::sin(phaseRadians);
+    }
+
+    // Writes the next numSamples values of sin and cos
+    void fillBlock(float* sinOut, float* cosOut, int numSamples)
+    {
+        float c = cosine, s = sine;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            sinOut[i] = s;
+            cosOut[i] = c;
+            const float nextCos = c * rotationCos - s * rotationSin;
+            s = s * rotationCos + c * rotationSin;
+            c = nextCos;
+        }
+
+        // Rounding makes the vector drift off the unit circle; one Newton step pulls it back
+        const float gain = 1.5f - 0.5f * (c * c + s * s);
+        cosine = c * gain;
+        sine = s * gain;
+    }
+
+private:
+    float cosine = 1.0f, sine = 0.0f;
+    float rotationCos = 1.0f, rotationSin = 0.0f;
+};
+
+enum class DelayInterpolation
+{
+    LINEAR,  // Two taps; cheapest, slightly dulls the delayed signal as the delay moves
+    CUBIC,   // Four-point Hermite; flat response for a few more multiplies
+    ALLPASS  // First-order allpass; flat magnitude, suits feedback loops with slow sweeps
+};
+
+// Single-channel delay line for modulated effects. The buffer is a power of two so the
+// ring wraps with a mask, and the interpolation is chosen at compile time. A read gives
+// the signal delaySamples before the sample that the next write() stores, so feedback
+// effects read first and then write input plus feedback.
+template <DelayInterpolation Interpolation>
+class ModulatedDelayLine
+{
+public:
+    // Per-tap state; only the allpass interpolator remembers anything between samples
+    struct Tap
+    {
+        float allpassOutput = 0.0f;
+    };
+
+    // Shortest delay the interpolator can produce without reading the future
+    static constexpr float minimumDelay = Interpolation == DelayInterpolation::LINEAR ? 1.0f : 2.0f;
+
+    // Allocates for delays up to maxDelaySamples; only reallocates when the size changes
+    void prepare(int maxDelaySamples)
+    {
+        const int required = juce::nextPowerOfTwo(juce::jmax(4, maxDelaySamples + 4));
+        if (required != static_cast<int>(buffer.size()))
+            buffer.assign(static_cast<size_t>(required), 0.0f);
+
+        mask = required - 1;
+        maximumDelay = static_cast<float>(maxDelaySamples);
+        reset();
+    }
+
+    void reset()
+    {
+        std::fill(buffer.begin(), buffer.end(), 0.0f);
+        writeIndex = 0;
+    }
+
+    bool isPrepared() const { return !buffer.empty(); }
+    float getMaximumDelay() const { return maximumDelay; }
+
+    float read(float delaySamples, Tap& tap) const
+    {
+        const float delay = juce::jlimit(minimumDelay, maximumDelay, delaySamples);
+
+        if constexpr (Interpolation == DelayInterpolation::LINEAR)
+        {
+            juce::ignoreUnused(tap);
+            const int whole = static_cast<int>(delay);
+            const float fraction = delay - static_cast<float>(whole);
+            const float y0 = sampleAt(whole);
+            return y0 + fraction * (sampleAt(whole + 1) - y0);
+        }
+        else if constexpr (Interpolation == DelayInterpolation::CUBIC)
+        {
+            juce::ignoreUnused(tap);
+            const int whole = static_cast<int>(delay);
+            const float t = delay - static_cast<float>(whole);
+            const float ym1 = sampleAt(whole - 1);
+            const float y0 = sampleAt(whole);
+            const float y1 = sampleAt(whole + 1);
+            const float y2 = sampleAt(whole + 2);
+
+            const float c1 = 0.5f * (y1 - ym1);
+            const float c2 = ym1 - 2.5f * y0 + 2.0f * y1 - 0.5f * y2;
+            const float c3 = 0.5f * (y2 - ym1) + 1.5f * (y0 - y1);
+            return ((c3 * t + c2) * t + c1) * t + y0;
+        }
+        else
+        {
+            // Keep the allpass's own delay between 0.5 and 1.5 samples, where its
+            // coefficient stays well inside the unit circle
+            const int whole = static_cast<int>(delay - 0.5f);
+            const float fraction = delay - static_cast<float>(whole);
+            const float eta = (1.0f - fraction) / (1.0f + fraction);
+            tap.allpassOutput = eta * sampleAt(whole) + sampleAt(whole + 1) - eta * tap.allpassOutput;
+            return tap.allpassOutput;
+        }
+    }
+
+    // Convenience for the interpolators that keep no per-tap state
+    float read(float delaySamples) const
+    {
+        static_assert(Interpolation != DelayInterpolation::ALLPASS, "Allpass reads need a Tap");
+        Tap unused;
+        return read(delaySamples, unused);
+    }
+
+    void write(float sample)
+    {
+        writeIndex = (writeIndex + 1) & mask;
+        buffer[static_cast<size_t>(writeIndex)] = sample;
+    }
+
+    // Longest block that readBlock() can serve at this delay: every sample it reads
+    // must already be in the buffer before the block is written
+    static int getMaximumBlockLength(float delaySamples)
+    {
+        static_assert(Interpolation != DelayInterpolation::ALLPASS, "Allpass reads are sample by sample");
+        const int newestTap = Interpolation == DelayInterpolation::CUBIC ? 1 : 0;
+        return juce::jmax(0, static_cast<int>(delaySamples) - newestTap);
+    }
+
+    // numSamples reads at a fixed delay, as if read() and write() had alternated. The
+    // samples are copied out of the ring in at most two contiguous runs, then
+    // interpolated with constant weights. numSamples must not exceed
+    // getMaximumBlockLength(delaySamples).
+    void readBlock(float delaySamples, float* destination, int numSamples) const
+    {
+        static_assert(Interpolation != DelayInterpolation::ALLPASS, "Allpass reads are sample by sample");
+        const float delay = juce::jlimit(minimumDelay, maximumDelay, delaySamples);
+        const int whole = static_cast<int>(delay);
+        const float t = delay - static_cast<float>(whole);
+        jassert(numSamples <= getMaximumBlockLength(delay));
+
+        // Oldest sample needed for the first output, then one run covering the block
+        constexpr int numTaps = Interpolation == DelayInterpolation::CUBIC ? 4 : 2;
+        const int oldestTap = Interpolation == DelayInterpolation::CUBIC ? whole + 2 : whole + 1;
+
+        float scratch[readChunkSize + numTaps - 1];
+        for (int done = 0; done < numSamples;)
+        {
+            const int count = juce::jmin(numSamples - done, readChunkSize);
+            copyRun((writeIndex + 1 - oldestTap + done) & mask, scratch, count + numTaps - 1);
+
+            const float* s = scratch;
+            float* out = destination + done;
+            if constexpr (Interpolation == DelayInterpolation::LINEAR)
+            {
+                // s[i + 1] is the tap at the whole delay, s[i] the one a sample older
+                for (int i = 0; i < count; ++i)
+                    out[i] = s[i + 1] + t * (s[i] - s[i + 1]);
+            }
+            else
+            {
+                // Hermite weights for the fixed fraction, applied as a four-tap FIR
+                const float w2 = 0.5f * t * t * (t - 1.0f);                    // y2
+                const float w1 = t * (0.5f + t * (2.0f - 1.5f * t));            // y1
+                const float w0 = 1.0f + t * t * (1.5f * t - 2.5f);             // y0
+                const float wm1 = t * (-0.5f + t * (1.0f - 0.5f * t));          // ym1
+                for (int i = 0; i < count; ++i)
+                    out[i] = w2 * s[i] + w1 * s[i + 1] + w0 * s[i + 2] + wm1 * s[i + 3];
+            }
+            done += count;
+        }
+    }
+
+    // numSamples writes, stored as one or two contiguous runs
+    void writeBlock(const float* source, int numSamples)
+    {
+        const int size = mask + 1;
+        const int start = (writeIndex + 1) & mask;
+        const int first = juce::jmin(numSamples, size - start);
+        std::copy(source, source + first, buffer.begin() + start);
+        std::copy(source + first, source + numSamples, buffer.begin());
+        writeIndex = (writeIndex + numSamples) & mask;
+    }
+
+private:
+    // sampleAt(1) is the latest write, sampleAt(2) the one before it, and so on
+    float sampleAt(int delay) const
+    {
+        return buffer[static_cast<size_t>((writeIndex - delay + 1) & mask)];
+    }
+
+    // Copies numSamples consecutive ring samples starting at index start
+    void copyRun(int start, float* destination, int numSamples) const
+    {
+        const int first = juce::jmin(numSamples, mask + 1 - start);
+        std::copy(buffer.begin() + start, buffer.begin() + start + first, destination);
+        std::copy(buffer.begin(), buffer.begin() + (numSamples - first), destination + first);
+    }
+
+    static constexpr int readChunkSize = 256;
+
+    std::vector<float> buffer;
+    int mask = 0;
+    int writeIndex = 0;
+    float maximumDelay = 0.0f;
+};
@@ -0,0 +1,126 @@
+#pragma once
+#include <JuceHeader.h>
+
+// Block noise source for the oscillators. White noise comes from four interleaved
+// xorshift32 generators stepped together, so the inner loop has no dependency between
+// neighbouring samples and vectorises; pink and brown are filtered from that block.
+// Two uncorrelated channels are produced so a unison stack can be given the statistics
+// of independent per-voice noise without generating noise once per voice.
+class NoiseGenerator
+{
+public:
+    enum Colour
+    {
+        WHITE = 0,
+        PINK,
+        BROWN
+    };
+
+    static constexpr int numChannels = 2;
+
+    void seed(uint32_t seedValue)
+    {
+        // Spread the seed over every lane; xorshift must never start from zero
+        for (int lane = 0; lane < numChannels * numLanes; ++lane)
+        {
+            seedValue = seedValue * 1664525u + 1013904223u;
+            state[lane] = seedValue != 0 ? seedValue : 0x9e3779b9u;
+        }
+
+        reset();
+    }
+
+    void reset()
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            for (auto& value : pinkState[channel])
+                value = 0.0f;
+            brownState[channel] = 0.0f;
+        }
+    }
+
+    // Fills one numSamples block per channel with the chosen colour
+    void render(Colour colour, float* channel0, float* channel1, int numSamples)
+    {
+        float* outputs[numChannels] = { channel0, channel1 };
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            renderWhite(outputs[channel], numSamples, state + channel * numLanes);
+
+            if (colour == PINK)
+                applyPink(outputs[channel], numSamples, pinkState[channel]);
+            else if (colour == BROWN)
+                applyBrown(outputs[channel], numSamples, brownState[channel]);
+        }
+    }
+
+private:
+    static constexpr int numLanes = 4;
+
+    // Uniform noise in [-1, 1), numLanes samples per step
+    static void renderWhite(float* output, int numSamples, uint32_t* lanes)
+    {
+        constexpr float scale = 1.0f / 2147483648.0f;
+        int i = 0;
+
+        for (; i + numLanes <= numSamples; i += numLanes)
+        {
+            for (int lane = 0; lane < numLanes; ++lane)
+            {
+                uint32_t x = lanes[lane];
+                x ^= x << 13;
+                x ^= x >> 17;
+                x ^= x << 5;
+                lanes[lane] = x;
+                output[i + lane] = static_cast<float>(static_cast<int32_t>(x)) * scale;
+            }
+        }
+
+        for (int lane = 0; i < numSamples; ++i, ++lane)
+        {
+            uint32_t x = lanes[lane];
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            lanes[lane] = x;
+            output[i] = static_cast<float>(static_cast<int32_t>(x)) * scale;
+        }
+    }
+
+    // Paul Kellett's pink noise filter, run once per sample
+    static void applyPink(float* buffer, int numSamples, float* b)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float white = buffer[i];
+
+            b[0] = 0.99886f * b[0] + white * 0.0555179f;
+            b[1] = 0.99332f * b[1] + white * 0.0750759f;
+            b[2] = 0.96900f * b[2] + white * 0.1538520f;
+            b[3] = 0.86650f * b[3] + white * 0.3104856f;
+            b[4] = 0.55000f * b[4] + white * 0.5329522f;
+            b[5] = -0.7616f * b[5] - white * 0.0168980f;
+
+            const float pink = b[0] + b[1] + b[2] + b[3] + b[4] + b[5] + b[6] + white * 0.5362f;
+            b[6] = white * 0.115926f;
+
+            buffer[i] = pink * 0.11f;
+        }
+    }
+
+    // Leaky integrator (-6 dB/oct), the leak keeps it from wandering off at DC
+    static void applyBrown(float* buffer, int numSamples, float& last)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            last = (last + 0.02f * buffer[i]) * (1.0f / 1.02f);
+            buffer[i] = last * 3.5f;
+        }
+    }
+
+    uint32_t state[numChannels * numLanes] = {};
+    float pinkState[numChannels][7] = {};
+    float brownState[numChannels] = {};
+};
@@ -0,0 +1,242 @@
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+
+// One 2x stage built from a half-band FIR split into its two polyphase branches.
+// Every other tap of a half-band filter is zero except the centre, so one branch is
+// a short FIR and the other is a pure delay - roughly half the work of a plain FIR.
+class HalfBandStage
+{
+public:
+    // numTaps must be of the form 4k + 3; maxInputSamples is the largest upsample input
+    void prepare(int numTaps, double kaiserBeta, int maxInputSamples)
+    {
+        jassert(numTaps % 4 == 3);
+        centre = (numTaps - 1) / 2;
+        numBranchTaps = (numTaps + 1) / 2;
+
+        // Windowed-sinc prototype, only the even (non-zero) taps are kept
+        branchTaps.assign(static_cast<size_t>(numBranchTaps), 0.0f);
+        double sum = 0.0;
+        for (int i = 0; i < numBranchTaps; ++i)
+        {
+            const int n = 2 * i;
+            const double x = (n - centre) * 0.5;
+            const double sinc = std::sin(juce::MathConstants<double>::pi * x) / (juce::MathConstants<double>::pi * x);
+            const double ratio = (n - centre) / static_cast<double>(centre);
+            const double window = besselI0(kaiserBeta * std::sqrt(1.0 - ratio * ratio)) / besselI0(kaiserBeta);
+            branchTaps[static_cast<size_t>(i)] = static_cast<float>(0.5 * sinc * window);
+            sum += 0.5 * sinc * window;
+        }
+
+        // Each branch must pass DC at 0.5 so the stage has unity gain
+        for (auto& tap : branchTaps)
+            tap = static_cast<float>(tap * 0.5 / sum);
+
+        const size_t historySize = static_cast<size_t>(numBranchTaps - 1 + maxInputSamples);
+        upHistory.assign(historySize, 0.0f);
+        evenHistory.assign(historySize, 0.0f);
+        oddHistory.assign(historySize, 0.0f);
+    }
+
+    void reset()
+    {
+        std::fill(upHistory.begin(), upHistory.end(), 0.0f);
+        std::fill(evenHistory.begin(), evenHistory.end(), 0.0f);
+        std::fill(oddHistory.begin(), oddHistory.end(), 0.0f);
+    }
+
+    // Delay through one up and one down pass, in samples at the stage's higher rate
+    static constexpr int getLatencyAtHighRate(int numTaps) { return numTaps - 1; }
+    int getLatencyAtHighRate() const { return getLatencyAtHighRate(2 * centre + 1); }
+
+    // numSamples in, 2 * numSamples out
+    void upsample(const float* input, float* output, int numSamples)
+    {
+        const int historyLength = numBranchTaps - 1;
+        const int delayOffset = (centre - 1) / 2;
+        float* history = upHistory.data();
+        std::copy(input, input + numSamples, history + historyLength);
+
+        for (int m = 0; m < numSamples; ++m)
+        {
+            const float* newest = history + historyLength + m;
+            output[2 * m] = 2.0f * dotReversed(newest);
+            output[2 * m + 1] = newest[-delayOffset];
+        }
+
+        std::copy(history + numSamples, history + numSamples + historyLength, history);
+    }
+
+    // 2 * numSamples in, numSamples out
+    void downsample(const float* input, float* output, int numSamples)
+    {
+        const int historyLength = numBranchTaps - 1;
+        const int delayOffset = (centre + 1) / 2;
+        float* even = evenHistory.data();
+        float* odd = oddHistory.data();
+
+        for (int m = 0; m < numSamples; ++m)
+        {
+            even[historyLength + m] = input[2 * m];
+            odd[historyLength + m] = input[2 * m + 1];
+        }
+
+        for (int m = 0; m < numSamples; ++m)
+        {
+            const int newest = historyLength + m;
+            output[m] = dotReversed(even + newest) + 0.5f * odd[newest - delayOffset];
+        }
+
+        std::copy(even + numSamples, even + numSamples + historyLength, even);
+        std::copy(odd + numSamples, odd + numSamples + historyLength, odd);
+    }
+
+private:
+    // Sum of tap[i] * newest[-i]
+    float dotReversed(const float* newest) const
+    {
+        float sum = 0.0f;
+        for (int i = 0; i < numBranchTaps; ++i)
+            sum += branchTaps[static_cast<size_t>(i)] * newest[-i];
+        return sum;
+    }
+
+    static double besselI0(double x)
+    {
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; k < 32; ++k)
+        {
+            term *= (x * 0.5 / k) * (x * 0.5 / k);
+            sum += term;
+        }
+        return sum;
+    }
+
+    int centre = 0;
+    int numBranchTaps = 0;
+    std::vector<float> branchTaps;
+    std::vector<float> upHistory, evenHistory, oddHistory;
+};
+
+// Mono 2x / 4x / 8x oversampler made of cascaded half-band stages. The first stage
+// does the steepest filtering; later stages only have to reject images far above
+// the original band, so they use shorter filters. Audio is handled in chunks of at
+// most maxChunkSize input samples so every buffer is allocated up front.
+class Oversampler
+{
+public:
+    static constexpr int maxStages = 3;
+    static constexpr int maxChunkSize = 64;
+
+    // Half-band filter design, first (steepest) stage first
+    static constexpr int stageTaps[maxStages] = { 31, 15, 11 };
+    static constexpr double stageBeta[maxStages] = { 8.0, 6.0, 5.0 };
+
+    // Whole-sample latency at the base rate for a number of stages (0, 15, 19 or 20 samples)
+    static constexpr int getLatencyForStages(int numStages)
+    {
+        const int factor = 1 << numStages;
+        return (getTopRateLatency(numStages) + factor - 1) / factor;
+    }
+
+    Oversampler()
+    {
+        for (int stage = 0; stage < maxStages; ++stage)
+        {
+            stages[stage].prepare(stageTaps[stage], stageBeta[stage], maxChunkSize << stage);
+            stageBuffers[stage].assign(static_cast<size_t>(maxChunkSize << (stage + 1)), 0.0f);
+        }
+
+        alignmentDelay.assign(static_cast<size_t>(maxChunkSize << maxStages) + 8, 0.0f);
+    }
+
+    // 0 = off, 1 = 2x, 2 = 4x, 3 = 8x
+    void setNumStages(int newNumStages)
+    {
+        numStages = juce::jlimit(0, maxStages, newNumStages);
+        updateLatency();
+        reset();
+    }
+
+    int getNumStages() const { return numStages; }
+    int getFactor() const { return 1 << numStages; }
+
+    int getLatencySamples() const { return latencySamples; }
+
+    void reset()
+    {
+        for (auto& stage : stages)
+            stage.reset();
+        std::fill(alignmentDelay.begin(), alignmentDelay.end(), 0.0f);
+    }
+
+    // Upsamples up to maxChunkSize samples and returns the oversampled data (numSamples * getFactor() long)
+    float* upsample(const float* input, int numSamples)
+    {
+        jassert(numSamples <= maxChunkSize);
+        const float* source = input;
+
+        for (int stage = 0; stage < numStages; ++stage)
+        {
+            stages[stage].upsample(source, stageBuffers[stage].data(), numSamples << stage);
+            source = stageBuffers[stage].data();
+        }
+
+        return numStages > 0 ? stageBuffers[numStages - 1].data() : nullptr;
+    }
+
+    // Brings the (processed) oversampled data back down to numSamples at the base rate
+    void downsample(float* output, int numSamples)
+    {
+        if (numStages == 0)
+            return;
+
+        float* top = stageBuffers[numStages - 1].data();
+        applyAlignmentDelay(top, numSamples << numStages);
+
+        for (int stage = numStages - 1; stage >= 0; --stage)
+        {
+            float* destination = stage > 0 ? stageBuffers[stage - 1].data() : output;
+            stages[stage].downsample(stageBuffers[stage].data(), destination, numSamples << stage);
+        }
+    }
+
+private:
+    // Stage delays summed at the top rate; each stage's delay is scaled up by the stages after it
+    static constexpr int getTopRateLatency(int numStages)
+    {
+        int topRateLatency = 0;
+        for (int stage = 0; stage < numStages; ++stage)
+            topRateLatency += HalfBandStage::getLatencyAtHighRate(stageTaps[stage]) << (numStages - 1 - stage);
+        return topRateLatency;
+    }
+
+    // The stage delays add up to a fraction of a base-rate sample; a few samples of
+    // delay at the top rate round it up to a whole number
+    void updateLatency()
+    {
+        latencySamples = getLatencyForStages(numStages);
+        alignmentSamples = latencySamples * getFactor() - getTopRateLatency(numStages);
+        jassert(alignmentSamples < 8);
+    }
+
+    void applyAlignmentDelay(float* data, int numSamples)
+    {
+        if (alignmentSamples == 0)
+            return;
+
+        // alignmentDelay holds the last alignmentSamples inputs ahead of the new block
+        float* line = alignmentDelay.data();
+        std::copy(data, data + numSamples, line + alignmentSamples);
+        std::copy(line, line + numSamples, data);
+        std::copy(line + numSamples, line + numSamples + alignmentSamples, line);
+    }
+
+    HalfBandStage stages[maxStages];
+    std::vector<float> stageBuffers[maxStages]; // Output of each upsampling stage
+    std::vector<float> alignmentDelay;
+    int numStages = 0;
+    int latencySamples = 0;
+    int alignmentSamples = 0;
+};
@@ -0,0 +1,103 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+
+// Single-producer / single-consumer queue that carries parameter changes from the
+// message thread to the audio thread. A change is a plain function pointer plus up to
+// four values, so draining never locks or allocates, and the audio thread applies
+// everything queued since the last block at one point before rendering. Changes that
+// do not fit (a burst while the host has stopped calling processBlock) wait in order
+// on the message thread, and a timer moves them in as room frees up.
+template <typename Target>
+class ParameterChangeQueue : private juce::Timer
+{
+public:
+    using Values = std::array<float, 4>;
+    using ApplyFunction = void (*)(Target&, const Values&);
+
+    static constexpr int capacity = 1024;
+    static constexpr int retryIntervalMs = 20;
+
+    // Message thread; never applies the change itself
+    void push(ApplyFunction apply, const Values& values)
+    {
+        moveOverflowToQueue();
+        if (overflow.empty() && write({ apply, values }))
+            return;
+
+        overflow.push_back({ apply, values });
+        startTimer(retryIntervalMs);
+    }
+
+    // Audio thread; applies every queued change in the order it was pushed
+    void drain(Target& target)
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead(fifo.getNumReady(), start1, size1, start2, size2);
+
+        for (int i = 0; i < size1; ++i)
+            apply(target, start1 + i);
+        for (int i = 0; i < size2; ++i)
+            apply(target, start2 + i);
+
+        fifo.finishedRead(size1 + size2);
+    }
+
+    // Message thread, with the audio thread stopped; applies the queue, then the overflow
+    void drainAll(Target& target)
+    {
+        drain(target);
+
+        for (const auto& change : overflow)
+            change.apply(target, change.values);
+
+        overflow.clear();
+        stopTimer();
+    }
+
+private:
+    struct Change
+    {
+        ApplyFunction apply = nullptr;
+        Values values {};
+    };
+
+    bool write(const Change& change)
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite(1, start1, size1, start2, size2);
+        if (size1 + size2 == 0)
+            return false;
+
+        changes[static_cast<size_t>(size1 > 0 ? start1 : start2)] = change;
+        fifo.finishedWrite(1);
+        return true;
+    }
+
+    void moveOverflowToQueue()
+    {
+        size_t numMoved = 0;
+        while (numMoved < overflow.size() && write(overflow[numMoved]))
+            ++numMoved;
+
+        overflow.erase(overflow.begin(), overflow.begin() + static_cast<std::ptrdiff_t>(numMoved));
+    }
+
+    void timerCallback() override
+    {
+        moveOverflowToQueue();
+        if (overflow.empty())
+            stopTimer();
+    }
+
+    void apply(Target& target, int index)
+    {
+        const auto& change = changes[static_cast<size_t>(index)];
+        change.apply(target, change.values);
+    }
+
+    juce::AbstractFifo fifo { capacity };
+    std::array<Change, capacity> changes;
+    std::vector<Change> overflow; // Message thread only
+};
@@ -0,0 +1,579 @@
+#pragma once
+#include <JuceHeader.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include "SimdFloat4.h"
+
+// Radix-2 FFT of a real signal, computed as a complex FFT of half the size. Spectra are
+// kept as separate real and imaginary arrays of size / 2 bins; bin 0 holds DC in the real
+// array and the Nyquist bin in the imaginary one, both being real.
+class RealFft
+{
+public:
+    explicit RealFft(int fftSize)
+        : size(fftSize), half(fftSize / 2)
+    {
+        jassert(juce::isPowerOfTwo(fftSize) && fftSize >= 8);
+
+        // Twiddles for the half-size complex transform, then for the real split
+        complexCos.resize(static_cast<size_t>(half / 2));
+        complexSin.resize(static_cast<size_t>(half / 2));
+        for (int k = 0; k < half / 2; ++k)
+        {
+            const double angle = juce::MathConstants<double>::twoPi * k / half;
+            complexCos[static_cast<size_t>(k)] = static_cast<float>(std::cos(angle));
+            complexSin[static_cast<size_t>(k)] = static_cast<float>(-std::sin(angle));
+        }
+
+        splitCos.resize(static_cast<size_t>(half));
+        splitSin.resize(static_cast<size_t>(half));
+        for (int k = 0; k < half; ++k)
+        {
+            const double angle = juce::MathConstants<double>::twoPi * k / size;
+            splitCos[static_cast<size_t>(k)] = static_cast<float>(std::cos(angle));
+            splitSin[static_cast<size_t>(k)] = static_cast<float>(-std::sin(angle));
+        }
+
+        int bits = 0;
+        while ((1 << bits) < half)
+            ++bits;
+        bitReversed.resize(static_cast<size_t>(half));
+        for (int i = 0; i < half; ++i)
+        {
+            int reversed = 0;
+            for (int b = 0; b < bits; ++b)
+                reversed |= ((i >> b) & 1) << (bits - 1 - b);
+            bitReversed[static_cast<size_t>(i)] = reversed;
+        }
+
+        workRe.resize(static_cast<size_t>(half));
+        workIm.resize(static_cast<size_t>(half));
+    }
+
+    int getSize() const { return size; }
+
+    // size samples in, size / 2 bins out
+    void forward(const float* input, float* re, float* im)
+    {
+        // Even samples become the real parts, odd samples the imaginary parts
+        for (int n = 0; n < half; ++n)
+        {
+            const int target = bitReversed[static_cast<size_t>(n)];
+            workRe[static_cast<size_t>(target)] = input[2 * n];
+            workIm[static_cast<size_t>(target)] = input[2 * n + 1];
+        }
+        transform(false);
+
+        const float* zr = workRe.data();
+        const float* zi = workIm.data();
+        re[0] = zr[0] + zi[0];
+        im[0] = zr[0] - zi[0];
+
+        for (int k = 1; k < half; ++k)
+        {
+            // Even and odd halves of the spectrum from Z[k] and conj(Z[half - k])
+            const float evenRe = 0.5f * (zr[k] + zr[half - k]);
+            const float evenIm = 0.5f * (zi[k] - zi[half - k]);
+            const float oddRe = 0.5f * (zi[k] + zi[half - k]);
+            const float oddIm = -0.5f * (zr[k] - zr[half - k]);
+
+            const float c = splitCos[static_cast<size_t>(k)];
+            const float s = splitSin[static_cast<size_t>(k)];
+            re[k] = evenRe + oddRe * c - oddIm * s;
+            im[k] = evenIm + oddRe * s + oddIm * c;
+        }
+    }
+
+    // size / 2 bins in, size samples out, scaled up by size / 2
+    void inverse(const float* re, const float* im, float* output)
+    {
+        workRe[0] = 0.5f * (re[0] + im[0]);
+        workIm[0] = 0.5f * (re[0] - im[0]);
+
+        for (int k = 1; k < half; ++k)
+        {
+            const float evenRe = 0.5f * (re[k] + re[half - k]);
+            const float evenIm = 0.5f * (im[k] - im[half - k]);
+            const float diffRe = 0.5f * (re[k] - re[half - k]);
+            const float diffIm = 0.5f * (im[k] + im[half - k]);
+
+            // Undo the twiddle: multiply by its conjugate
+            const float c = splitCos[static_cast<size_t>(k)];
+            const float s = splitSin[static_cast<size_t>(k)];
+            const float oddRe = diffRe * c + diffIm * s;
+            const float oddIm = diffIm * c - diffRe * s;
+
+            // Z[k] = even + i * odd
+            workRe[static_cast<size_t>(k)] = evenRe - oddIm;
+            workIm[static_cast<size_t>(k)] = evenIm + oddRe;
+        }
+
+        for (int k = 0; k < half; ++k)
+        {
+            const int target = bitReversed[static_cast<size_t>(k)];
+            if (target > k)
+            {
+                std::swap(workRe[static_cast<size_t>(k)], workRe[static_cast<size_t>(target)]);
+                std::swap(workIm[static_cast<size_t>(k)], workIm[static_cast<size_t>(target)]);
+            }
+        }
+        transform(true);
+
+        for (int n = 0; n < half; ++n)
+        {
+            output[2 * n] = workRe[static_cast<size_t>(n)];
+            output[2 * n + 1] = workIm[static_cast<size_t>(n)];
+        }
+    }
+
+private:
+    // In-place complex butterflies over bit-reversed work arrays
+    void transform(bool inverted)
+    {
+        float* re = workRe.data();
+        float* im = workIm.data();
+        const float sign = inverted ? -1.0f : 1.0f;
+
+        for (int length = 2; length <= half; length <<= 1)
+        {
+            const int halfLength = length / 2;
+            const int step = half / length;
+            for (int start = 0; start < half; start += length)
+            {
+                for (int j = 0; j < halfLength; ++j)
+                {
+                    const float c = complexCos[static_cast<size_t>(j * step)];
+                    const float s = sign * complexSin[static_cast<size_t>(j * step)];
+                    const int a = start + j;
+                    const int b = a + halfLength;
+                    const float tr = re[b] * c - im[b] * s;
+                    const float ti = re[b] * s + im[b] * c;
+                    re[b] = re[a] - tr;
+                    im[b] = im[a] - ti;
+                    re[a] += tr;
+                    im[a] += ti;
+                }
+            }
+        }
+    }
+
+    int size, half;
+    std::vector<float> complexCos, complexSin;
+    std::vector<float> splitCos, splitSin;
+    std::vector<int> bitReversed;
+    std::vector<float> workRe, workIm;
+};
+
+// Stereo convolution with a long impulse response at a low, fixed latency. The response
+// is split non-uniformly: a head of short partitions keeps the latency at one head block,
+// and later segments use progressively longer partitions, which cost far fewer operations
+// per sample. Every later stage starts two of its own blocks into the response, so its
+// work for one block can be spread over the head blocks of the next and no single audio
+// callback carries a whole large FFT plus all its multiplies.
+//
+// Everything is allocated when the convolver is built, so it can be built on a background
+// thread and handed to the audio thread whole.
+class PartitionedConvolver
+{
+public:
+    static constexpr int headBlockSize = 64; // Also the latency, in samples
+    static constexpr int stageRatio = 8;     // Each stage's blocks are this much longer
+    static constexpr int numStages = 3;      // 64, 512 and 4096 sample partitions
+
+    // A mono or stereo response, already at the processing sample rate
+    explicit PartitionedConvolver(const juce::AudioBuffer<float>& impulse)
+    {
+        const int impulseLength = impulse.getNumSamples();
+        length = impulseLength;
+
+        int blockSize = headBlockSize;
+        int segmentStart = 0;
+        for (int s = 0; s < numStages && segmentStart < impulseLength; ++s)
+        {
+            // The next stage begins two of its blocks in; the last runs to the end
+            const bool last = s == numStages - 1;
+            const int segmentEnd = last ? impulseLength : juce::jmin(impulseLength, 2 * blockSize * stageRatio);
+            stages.push_back(std::make_unique<Stage>(impulse, blockSize, segmentStart, segmentEnd));
+            segmentStart = segmentEnd;
+            blockSize *= stageRatio;
+        }
+
+        reset();
+    }
+
+    // Brings a loaded response to the processing rate with a windowed-sinc resampler,
+    // keeps at most two channels and maxSeconds, drops the silent end and scales it to
+    // unit energy in its louder channel, so responses of any level and length sit at a
+    // similar loudness. Slow; meant for the thread that builds the convolver.
+    static juce::AudioBuffer<float> prepareImpulse(const juce::AudioBuffer<float>& source, double sourceRate,
+                                                   double targetRate, double maxSeconds)
+    {
+        const int numChannels = juce::jmin(2, source.getNumChannels());
+        const int sourceLength = source.getNumSamples();
+        if (numChannels == 0 || sourceLength == 0 || sourceRate <= 0.0 || targetRate <= 0.0)
+            return {};
+
+        const double ratio = targetRate / sourceRate;
+        const int maxLength = static_cast<int>(maxSeconds * targetRate);
+        const int resampledLength = juce::jmin(maxLength, static_cast<int>(std::ceil(sourceLength * ratio)));
+        juce::AudioBuffer<float> result(numChannels, resampledLength);
+
+        if (ratio == 1.0)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+                std::copy(source.getReadPointer(ch), source.getReadPointer(ch) + resampledLength, result.getWritePointer(ch));
+        }
+        else
+        {
+            // Blackman-windowed sinc, tabulated per zero crossing; downsampling lowers the
+            // cutoff to the new Nyquist frequency and widens the kernel to match
+            constexpr int zeroCrossings = 16;
+            constexpr int tableResolution = 256;
+            std::vector<float> kernel(static_cast<size_t>(zeroCrossings * tableResolution + 2));
+            for (size_t i = 0; i < kernel.size(); ++i)
+            {
+                const double x = static_cast<double>(i) / tableResolution;
+                const double sinc = x == 0.0 ? 1.0 : std::sin(juce::MathConstants<double>::pi * x) / (juce::MathConstants<double>::pi * x);
+                const double w = juce::jmin(1.0, x / zeroCrossings);
+                const double window = 0.42 + 0.5 * std::cos(juce::MathConstants<double>::pi * w) + 0.08 * std::cos(juce::MathConstants<double>::twoPi * w);
+                kernel[i] = static_cast<float>(sinc * window);
+            }
+
+            const double cutoff = juce::jmin(1.0, ratio);
+            const double halfWidth = zeroCrossings / cutoff;
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                const float* in = source.getReadPointer(ch);
+                float* out = result.getWritePointer(ch);
+                for (int n = 0; n < resampledLength; ++n)
+                {
+                    const double centre = n / ratio;
+                    const int first = juce::jmax(0, static_cast<int>(std::ceil(centre - halfWidth)));
+                    const int last = juce::jmin(sourceLength - 1, static_cast<int>(std::floor(centre + halfWidth)));
+                    double sum = 0.0;
+                    for (int k = first; k <= last; ++k)
+                    {
+                        const double position = std::abs(centre - k) * cutoff * tableResolution;
+                        const int index = static_cast<int>(position);
+                        const double fraction = position - index;
+                        const double value = kernel[static_cast<size_t>(index)] + fraction * (kernel[static_cast<size_t>(index + 1)] - kernel[static_cast<size_t>(index)]);
+                        sum += in[k] * value;
+                    }
+                    out[n] = static_cast<float>(sum * cutoff);
+                }
+            }
+        }
+
+        // Trim the end below -90 dB of the peak and measure the energy
+        float peak = 0.0f;
+        double energy[2] = {};
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const float* data = result.getReadPointer(ch);
+            for (int i = 0; i < resampledLength; ++i)
+            {
+                peak = juce::jmax(peak, std::abs(data[i]));
+                energy[ch] += static_cast<double>(data[i]) * data[i];
+            }
+        }
+        if (peak <= 0.0f)
+            return {};
+
+        const float threshold = peak * 3.0e-5f;
+        int trimmedLength = 1;
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const float* data = result.getReadPointer(ch);
+            for (int i = resampledLength - 1; i >= trimmedLength; --i)
+            {
+                if (std::abs(data[i]) > threshold)
+                {
+                    trimmedLength = i + 1;
+                    break;
+                }
+            }
+        }
+
+        const float gain = static_cast<float>(1.0 / std::sqrt(juce::jmax(energy[0], energy[1])));
+        juce::AudioBuffer<float> trimmed(numChannels, trimmedLength);
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const float* data = result.getReadPointer(ch);
+            float* out = trimmed.getWritePointer(ch);
+            for (int i = 0; i < trimmedLength; ++i)
+                out[i] = data[i] * gain;
+        }
+        return trimmed;
+    }
+
+    // Response length in samples
+    int getLength() const { return length; }
+
+    void reset()
+    {
+        for (auto& stage : stages)
+            stage->reset();
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            std::fill(std::begin(inputBlock[ch]), std::end(inputBlock[ch]), 0.0f);
+            std::fill(std::begin(outputBlock[ch]), std::end(outputBlock[ch]), 0.0f);
+        }
+        blockFill = 0;
+    }
+
+    // Convolves numSamples of stereo input; the output lags by headBlockSize samples.
+    // The outputs may be the inputs.
+    void process(const float* inputL, const float* inputR, float* outputL, float* outputR, int numSamples)
+    {
+        for (int done = 0; done < numSamples;)
+        {
+            const int count = juce::jmin(numSamples - done, headBlockSize - blockFill);
+            std::copy(inputL + done, inputL + done + count, inputBlock[0] + blockFill);
+            std::copy(inputR + done, inputR + done + count, inputBlock[1] + blockFill);
+            std::copy(outputBlock[0] + blockFill, outputBlock[0] + blockFill + count, outputL + done);
+            std::copy(outputBlock[1] + blockFill, outputBlock[1] + blockFill + count, outputR + done);
+
+            blockFill += count;
+            done += count;
+            if (blockFill == headBlockSize)
+            {
+                processHeadBlock();
+                blockFill = 0;
+            }
+        }
+    }
+
+private:
+    // One uniformly partitioned overlap-save convolver over a segment of the response
+    class Stage
+    {
+    public:
+        Stage(const juce::AudioBuffer<float>& impulse, int stageBlockSize, int segmentStart, int segmentEnd)
+            : blockSize(stageBlockSize),
+              numBins(stageBlockSize),
+              headBlocksPerBlock(stageBlockSize / headBlockSize),
+              fft(2 * stageBlockSize)
+        {
+            numPartitions = (segmentEnd - segmentStart + blockSize - 1) / blockSize;
+            const size_t spectrumSize = static_cast<size_t>(numPartitions * numBins);
+            const float scale = 1.0f / static_cast<float>(blockSize); // Undoes the inverse FFT's gain
+
+            std::vector<float> padded(static_cast<size_t>(2 * blockSize));
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                const float* source = impulse.getReadPointer(juce::jmin(ch, impulse.getNumChannels() - 1));
+                auto& channel = channels[ch];
+                channel.impulseRe.assign(spectrumSize, 0.0f);
+                channel.impulseIm.assign(spectrumSize, 0.0f);
+                channel.inputRe.assign(spectrumSize, 0.0f);
+                channel.inputIm.assign(spectrumSize, 0.0f);
+                channel.accumulatorRe.assign(static_cast<size_t>(numBins), 0.0f);
+                channel.accumulatorIm.assign(static_cast<size_t>(numBins), 0.0f);
+                channel.window.assign(static_cast<size_t>(2 * blockSize), 0.0f);
+                channel.completedWindow.assign(static_cast<size_t>(2 * blockSize), 0.0f);
+                channel.timeDomain.assign(static_cast<size_t>(2 * blockSize), 0.0f);
+                channel.currentOutput.assign(static_cast<size_t>(blockSize), 0.0f);
+                channel.nextOutput.assign(static_cast<size_t>(blockSize), 0.0f);
+
+                // Each partition zero-padded to the FFT size
+                for (int p = 0; p < numPartitions; ++p)
+                {
+                    std::fill(padded.begin(), padded.end(), 0.0f);
+                    const int start = segmentStart + p * blockSize;
+                    const int count = juce::jmin(blockSize, segmentEnd - start);
+                    for (int i = 0; i < count; ++i)
+                        padded[static_cast<size_t>(i)] = source[start + i] * scale;
+
+                    const size_t offset = static_cast<size_t>(p * numBins);
+                    fft.forward(padded.data(), channel.impulseRe.data() + offset, channel.impulseIm.data() + offset);
+                }
+            }
+        }
+
+        void reset()
+        {
+            for (auto& channel : channels)
+            {
+                std::fill(channel.inputRe.begin(), channel.inputRe.end(), 0.0f);
+                std::fill(channel.inputIm.begin(), channel.inputIm.end(), 0.0f);
+                std::fill(channel.window.begin(), channel.window.end(), 0.0f);
+                std::fill(channel.completedWindow.begin(), channel.completedWindow.end(), 0.0f);
+                channel.newestPartition = 0;
+                std::fill(channel.currentOutput.begin(), channel.currentOutput.end(), 0.0f);
+                std::fill(channel.nextOutput.begin(), channel.nextOutput.end(), 0.0f);
+            }
+            phase = 0;
+        }
+
+        // The head stage: its block is the head block, so the whole convolution runs at
+        // once and its result is the output for the block just received
+        void processImmediate(const float* const* input, float* const* output)
+        {
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                auto& channel = channels[ch];
+                appendInput(channel, input[ch], 0);
+                std::copy(channel.window.begin(), channel.window.end(), channel.completedWindow.begin());
+                std::copy(channel.window.begin() + blockSize, channel.window.end(), channel.window.begin());
+
+                transformInput(channel);
+                multiplyAccumulate(channel, 0, numPartitions);
+                transformOutput(channel);
+
+                const float* result = channel.nextOutput.data();
+                for (int i = 0; i < headBlockSize; ++i)
+                    output[ch][i] = result[i];
+            }
+        }
+
+        // A later stage: adds its output for this head block, does this head block's
+        // share of the pending work, then takes in the input. The channels run a head
+        // block apart, so the two large transforms never land in the same callback:
+        // channel c transforms its input at phase c, multiplies over the following
+        // phases and transforms the result back at phase headBlocksPerBlock - 2 + c.
+        void processDeferred(const float* const* input, float* const* output)
+        {
+            const int offset = phase * headBlockSize;
+            const int workPhases = headBlocksPerBlock - 1;
+
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                auto& channel = channels[ch];
+                const float* result = channel.currentOutput.data() + offset;
+                for (int i = 0; i < headBlockSize; ++i)
+                    output[ch][i] += result[i];
+
+                const int step = phase - ch;
+                if (step >= 0 && step < workPhases)
+                {
+                    if (step == 0)
+                        transformInput(channel);
+                    multiplyAccumulate(channel, step * numPartitions / workPhases, (step + 1) * numPartitions / workPhases);
+                    if (step == workPhases - 1)
+                        transformOutput(channel);
+                }
+
+                appendInput(channel, input[ch], offset);
+            }
+
+            // Both results are in, and the current ones have been read to the end
+            if (phase == headBlocksPerBlock - 1)
+            {
+                for (auto& channel : channels)
+                    std::swap(channel.currentOutput, channel.nextOutput);
+
+                // The completed input waits in its own buffer for the next block's transforms
+                for (auto& channel : channels)
+                {
+                    std::copy(channel.window.begin(), channel.window.end(), channel.completedWindow.begin());
+                    std::copy(channel.window.begin() + blockSize, channel.window.end(), channel.window.begin());
+                }
+            }
+
+            phase = (phase + 1) % headBlocksPerBlock;
+        }
+
+    private:
+        struct Channel
+        {
+            std::vector<float> impulseRe, impulseIm; // Partition spectra
+            std::vector<float> inputRe, inputIm;     // Frequency-domain delay line, one slot per partition
+            std::vector<float> accumulatorRe, accumulatorIm;
+            std::vector<float> window;               // Previous block then the block being filled
+            std::vector<float> completedWindow;      // The last full window, waiting to be transformed
+            std::vector<float> timeDomain;
+            std::vector<float> currentOutput, nextOutput;
+            int newestPartition = 0;                 // Delay-line slot of the latest input spectrum
+        };
+
+        // Fills the second half of the window; the first half keeps the previous block
+        void appendInput(Channel& channel, const float* input, int offset)
+        {
+            std::copy(input, input + headBlockSize, channel.window.begin() + blockSize + offset);
+        }
+
+        // Transforms the completed window into the channel's newest delay-line slot
+        void transformInput(Channel& channel)
+        {
+            channel.newestPartition = (channel.newestPartition + 1) % numPartitions;
+
+            const size_t slot = static_cast<size_t>(channel.newestPartition * numBins);
+            fft.forward(channel.completedWindow.data(), channel.inputRe.data() + slot, channel.inputIm.data() + slot);
+
+            std::fill(channel.accumulatorRe.begin(), channel.accumulatorRe.end(), 0.0f);
+            std::fill(channel.accumulatorIm.begin(), channel.accumulatorIm.end(), 0.0f);
+        }
+
+        // Adds partitions [first, last) times their input spectra into the accumulator
+        void multiplyAccumulate(Channel& channel, int first, int last)
+        {
+            float* accRe = channel.accumulatorRe.data();
+            float* accIm = channel.accumulatorIm.data();
+
+            for (int p = first; p < last; ++p)
+            {
+                // Partition p meets the input from p blocks ago
+                const int slot = (channel.newestPartition - p + numPartitions) % numPartitions;
+                const float* hRe = channel.impulseRe.data() + p * numBins;
+                const float* hIm = channel.impulseIm.data() + p * numBins;
+                const float* xRe = channel.inputRe.data() + slot * numBins;
+                const float* xIm = channel.inputIm.data() + slot * numBins;
+
+                // Bin 0 packs two real bins, DC and Nyquist
+                const float dc = accRe[0] + xRe[0] * hRe[0];
+                const float nyquist = accIm[0] + xIm[0] * hIm[0];
+
+                for (int k = 0; k < numBins; k += 4)
+                {
+                    const auto ar = SimdFloat4::load(xRe + k);
+                    const auto ai = SimdFloat4::load(xIm + k);
+                    const auto br = SimdFloat4::load(hRe + k);
+                    const auto bi = SimdFloat4::load(hIm + k);
+                    (SimdFloat4::load(accRe + k) + ar * br - ai * bi).store(accRe + k);
+                    (SimdFloat4::load(accIm + k) + ar * bi + ai * br).store(accIm + k);
+                }
+
+                accRe[0] = dc;
+                accIm[0] = nyquist;
+            }
+        }
+
+        // The last blockSize samples of the inverse transform are the valid output
+        void transformOutput(Channel& channel)
+        {
+            fft.inverse(channel.accumulatorRe.data(), channel.accumulatorIm.data(), channel.timeDomain.data());
+            std::copy(channel.timeDomain.begin() + blockSize, channel.timeDomain.end(), channel.nextOutput.begin());
+        }
+
+        int blockSize, numBins, headBlocksPerBlock;
+        int numPartitions = 0;
+        int phase = 0; // Head blocks into the current stage block
+        RealFft fft;
+        Channel channels[2];
+    };
+
+    void processHeadBlock()
+    {
+        const float* input[2] = { inputBlock[0], inputBlock[1] };
+        float* output[2] = { outputBlock[0], outputBlock[1] };
+
+        if (stages.empty())
+        {
+            std::fill(std::begin(outputBlock[0]), std::end(outputBlock[0]), 0.0f);
+            std::fill(std::begin(outputBlock[1]), std::end(outputBlock[1]), 0.0f);
+            return;
+        }
+
+        stages.front()->processImmediate(input, output);
+        for (size_t s = 1; s < stages.size(); ++s)
+            stages[s]->processDeferred(input, output);
+    }
+
+    std::vector<std::unique_ptr<Stage>> stages;
+    int length = 0;
+    alignas(16) float inputBlock[2][headBlockSize] = {};
+    alignas(16) float outputBlock[2][headBlockSize] = {};
+    int blockFill = 0;
+};
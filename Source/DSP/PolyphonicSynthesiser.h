@@ -0,0 +1,151 @@
+#pragma once
+#include <JuceHeader.h>
+
+// juce::Synthesiser over a voice pool that is allocated once. Only the first
+// `polyphony` voices are handed out, so the voice limit can change at run time
+// without adding or deleting voices, and the stealing policy is selectable.
+class PolyphonicSynthesiser : public juce::Synthesiser
+{
+public:
+    static constexpr int maxPolyphony = 64;
+
+    enum StealMode
+    {
+        STEAL_OLDEST = 0,   // Oldest note-on is stolen first
+        STEAL_QUIETEST,     // Lowest envelope level is stolen first
+        STEAL_SAME_NOTE     // Repeated notes retrigger their own voice, otherwise oldest
+    };
+
+    // Voices report their current envelope level so the quietest policy can compare them
+    struct Voice : public juce::SynthesiserVoice
+    {
+        virtual float getEnvelopeLevel() const = 0;
+    };
+
+    // Voices above the new limit are released rather than cut off
+    void setPolyphony(int newPolyphony)
+    {
+        const juce::ScopedLock sl(lock);
+        polyphony = juce::jlimit(1, maxPolyphony, newPolyphony);
+
+        for (int i = polyphony; i < getNumVoices(); ++i)
+        {
+            auto* voice = getVoice(i);
+            if (voice->isVoiceActive())
+                stopVoice(voice, 1.0f, true);
+        }
+    }
+
+    int getPolyphony() const { return polyphony; }
+
+    void setStealMode(int newMode)
+    {
+        const juce::ScopedLock sl(lock);
+        stealMode = static_cast<StealMode>(juce::jlimit(0, 2, newMode));
+    }
+
+    int getStealMode() const { return stealMode; }
+
+    // Includes voices above the limit that are still releasing
+    int getNumActiveVoices() const
+    {
+        int activeVoices = 0;
+        for (int i = 0; i < getNumVoices(); ++i)
+        {
+            if (getVoice(i)->isVoiceActive())
+                ++activeVoices;
+        }
+        return activeVoices;
+    }
+
+protected:
+    juce::SynthesiserVoice* findFreeVoice(juce::SynthesiserSound* soundToPlay, int midiChannel,
+                                          int midiNoteNumber, bool stealIfNoneAvailable) const override
+    {
+        const int limit = getVoiceLimit();
+
+        // Same-note mode reuses the voice (possibly releasing) that already plays this note
+        if (stealMode == STEAL_SAME_NOTE)
+        {
+            if (auto* voice = findVoicePlayingNote(soundToPlay, midiChannel, midiNoteNumber))
+                return voice;
+        }
+
+        for (int i = 0; i < limit; ++i)
+        {
+            auto* voice = getVoice(i);
+            if (!voice->isVoiceActive() && voice->canPlaySound(soundToPlay))
+                return voice;
+        }
+
+        if (stealIfNoneAvailable)
+            return findVoiceToSteal(soundToPlay, midiChannel, midiNoteNumber);
+
+        return nullptr;
+    }
+
+    juce::SynthesiserVoice* findVoiceToSteal(juce::SynthesiserSound* soundToPlay, int midiChannel,
+                                             int midiNoteNumber) const override
+    {
+        if (stealMode == STEAL_SAME_NOTE)
+        {
+            if (auto* voice = findVoicePlayingNote(soundToPlay, midiChannel, midiNoteNumber))
+                return voice;
+        }
+
+        const int limit = getVoiceLimit();
+        juce::SynthesiserVoice* best = nullptr;
+        float bestLevel = 0.0f;
+
+        for (int i = 0; i < limit; ++i)
+        {
+            auto* voice = getVoice(i);
+            if (!voice->canPlaySound(soundToPlay))
+                continue;
+
+            if (stealMode == STEAL_QUIETEST)
+            {
+                const float level = getEnvelopeLevel(voice);
+                if (best == nullptr || level < bestLevel)
+                {
+                    best = voice;
+                    bestLevel = level;
+                }
+            }
+            else if (best == nullptr || voice->wasStartedBefore(*best))
+            {
+                best = voice;
+            }
+        }
+
+        return best;
+    }
+
+private:
+    int getVoiceLimit() const { return juce::jmin(polyphony, getNumVoices()); }
+
+    juce::SynthesiserVoice* findVoicePlayingNote(juce::SynthesiserSound* soundToPlay, int midiChannel, int midiNoteNumber) const
+    {
+        for (int i = 0; i < getVoiceLimit(); ++i)
+        {
+            auto* voice = getVoice(i);
+            if (voice->getCurrentlyPlayingNote() == midiNoteNumber
+                && voice->isPlayingChannel(midiChannel)
+                && voice->canPlaySound(soundToPlay))
+                return voice;
+        }
+
+        return nullptr;
+    }
+
+    static float getEnvelopeLevel(juce::SynthesiserVoice* voice)
+    {
+        if (auto* pooledVoice = dynamic_cast<Voice*>(voice))
+            return pooledVoice->getEnvelopeLevel();
+
+        return voice->isVoiceActive() ? 1.0f : 0.0f;
+    }
+
+    int polyphony = 8;
+    StealMode stealMode = STEAL_OLDEST;
+};
@@ -0,0 +1,175 @@
+#pragma once
+#include <JuceHeader.h>
+
+// Building with SUMMONER_SCALAR_SIMD=1 selects the scalar fallback on any machine, so
+// the tests can check it against the same reference as the vector code
+#if JUCE_USE_SSE_INTRINSICS && ! SUMMONER_SCALAR_SIMD
+ #define SUMMONER_SIMD_SSE 1
+ #include <emmintrin.h>
+#elif JUCE_USE_ARM_NEON && ! SUMMONER_SCALAR_SIMD
+ #define SUMMONER_SIMD_NEON 1
+ #include <arm_neon.h>
+#endif
+
+// Four float lanes mapped onto SSE or NEON registers, with a plain scalar fallback.
+// Only the handful of operations the DSP engines need; loads and stores expect 16-byte alignment.
+struct SimdFloat4
+{
+#if SUMMONER_SIMD_SSE
+    __m128 value;
+
+    static SimdFloat4 load(const float* source) { return { _mm_load_ps(source) }; }
+    static SimdFloat4 expand(float scalar) { return { _mm_set1_ps(scalar) }; }
+    static SimdFloat4 fromValues(float a, float b, float c, float d) { return { _mm_setr_ps(a, b, c, d) }; }
+    void store(float* destination) const { _mm_store_ps(destination, value); }
+
+    SimdFloat4 operator+(SimdFloat4 other) const { return { _mm_add_ps(value, other.value) }; }
+    SimdFloat4 operator-(SimdFloat4 other) const { return { _mm_sub_ps(value, other.value) }; }
+    SimdFloat4 operator*(SimdFloat4 other) const { return { _mm_mul_ps(value, other.value) }; }
+
+    static SimdFloat4 min(SimdFloat4 a, SimdFloat4 b) { return { _mm_min_ps(a.value, b.value) }; }
+    static SimdFloat4 max(SimdFloat4 a, SimdFloat4 b) { return { _mm_max_ps(a.value, b.value) }; }
+
+    // Truncates towards zero, writing the integer lanes and returning them as floats
+    SimdFloat4 truncate(int* indices) const
+    {
+        const __m128i truncated = _mm_cvttps_epi32(value);
+        _mm_store_si128(reinterpret_cast<__m128i*>(indices), truncated);
+        return { _mm_cvtepi32_ps(truncated) };
+    }
+
+    float sum() const
+    {
+        const __m128 shuffled = _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 3, 0, 1));
+        const __m128 pairs = _mm_add_ps(value, shuffled);
+        return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_movehl_ps(shuffled, pairs)));
+    }
+
+    // Lanes move up one place: lane 0 takes newLane0, the old lane 3 drops out
+    SimdFloat4 shiftLanesUp(float newLane0) const
+    {
+        const __m128 shifted = _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(value), 4));
+        return { _mm_move_ss(shifted, _mm_set_ss(newLane0)) };
+    }
+
+    template <int lane>
+    float get() const { return _mm_cvtss_f32(_mm_shuffle_ps(value, value, _MM_SHUFFLE(lane, lane, lane, lane))); }
+#elif SUMMONER_SIMD_NEON
+    float32x4_t value;
+
+    static SimdFloat4 load(const float* source) { return { vld1q_f32(source) }; }
+    static SimdFloat4 expand(float scalar) { return { vdupq_n_f32(scalar) }; }
+    static SimdFloat4 fromValues(float a, float b, float c, float d) { alignas(16) const float values[4] = { a, b, c, d }; return { vld1q_f32(values) }; }
+    void store(float* destination) const { vst1q_f32(destination, value); }
+
+    SimdFloat4 operator+(SimdFloat4 other) const { return { vaddq_f32(value, other.value) }; }
+    SimdFloat4 operator-(SimdFloat4 other) const { return { vsubq_f32(value, other.value) }; }
+    SimdFloat4 operator*(SimdFloat4 other) const { return { vmulq_f32(value, other.value) }; }
+
+    static SimdFloat4 min(SimdFloat4 a, SimdFloat4 b) { return { vminq_f32(a.value, b.value) }; }
+    static SimdFloat4 max(SimdFloat4 a, SimdFloat4 b) { return { vmaxq_f32(a.value, b.value) }; }
+
+    SimdFloat4 truncate(int* indices) const
+    {
+        const int32x4_t truncated = vcvtq_s32_f32(value);
+        vst1q_s32(indices, truncated);
+        return { vcvtq_f32_s32(truncated) };
+    }
+
+    float sum() const
+    {
+        const float32x2_t pairs = vadd_f32(vget_low_f32(value), vget_high_f32(value));
+        return vget_lane_f32(vpadd_f32(pairs, pairs), 0);
+    }
+
+    SimdFloat4 shiftLanesUp(float newLane0) const { return { vextq_f32(vdupq_n_f32(newLane0), value, 3) }; }
+
+    template <int lane>
+    float get() const { return vgetq_lane_f32(value, lane); }
+#else
+    float value[4];
+
+    static SimdFloat4 load(const float* source) { return { { source[0], source[1], source[2], source[3] } }; }
+    static SimdFloat4 expand(float scalar) { return { { scalar, scalar, scalar, scalar } }; }
+    static SimdFloat4 fromValues(float a, float b, float c, float d) { return { { a, b, c, d } }; }
+    void store(float* destination) const { for (int i = 0; i < 4; ++i) destination[i] = value[i]; }
+
+    SimdFloat4 operator+(SimdFloat4 other) const { SimdFloat4 r; for (int i = 0; i < 4; ++i) r.value[i] = value[i] + other.value[i]; return r; }
+    SimdFloat4 operator-(SimdFloat4 other) const { SimdFloat4 r; for (int i = 0; i < 4; ++i) r.value[i] = value[i] - other.value[i]; return r; }
+    SimdFloat4 operator*(SimdFloat4 other) const { SimdFloat4 r; for (int i = 0; i < 4; ++i) r.value[i] = value[i] * other.value[i]; return r; }
+
+    static SimdFloat4 min(SimdFloat4 a, SimdFloat4 b) { SimdFloat4 r; for (int i = 0; i < 4; ++i) r.value[i] = juce::jmin(a.value[i], b.value[i]); return r; }
+    static SimdFloat4 max(SimdFloat4 a, SimdFloat4 b) { SimdFloat4 r; for (int i = 0; i < 4; ++i) r.value[i] = juce::jmax(a.value[i], b.value[i]); return r; }
+
+    SimdFloat4 truncate(int* indices) const
+    {
+        SimdFloat4 r;
+        for (int i = 0; i < 4; ++i)
+        {
+            indices[i] = static_cast<int>(value[i]);
+            r.value[i] = static_cast<float>(indices[i]);
+        }
+        return r;
+    }
+
+    float sum() const { return (value[0] + value[1]) + (value[2] + value[3]); }
+
+    SimdFloat4 shiftLanesUp(float newLane0) const { return { { newLane0, value[0], value[1], value[2] } }; }
+
+    template <int lane>
+    float get() const { return value[lane]; }
+#endif
+
+    SimdFloat4& operator+=(SimdFloat4 other) { return *this = *this + other; }
+    SimdFloat4& operator*=(SimdFloat4 other) { return *this = *this * other; }
+};
+
+// Four unsigned 32-bit lanes, used for fixed-point phase accumulators: adding wraps
+// modulo 2^32 for free, so a phase never needs a compare or fmod to stay in range.
+struct SimdUInt4
+{
+#if SUMMONER_SIMD_SSE
+    __m128i value;
+
+    static SimdUInt4 load(const uint32_t* source) { return { _mm_load_si128(reinterpret_cast<const __m128i*>(source)) }; }
+    static SimdUInt4 expand(uint32_t scalar) { return { _mm_set1_epi32(static_cast<int>(scalar)) }; }
+    void store(uint32_t* destination) const { _mm_store_si128(reinterpret_cast<__m128i*>(destination), value); }
+
+    SimdUInt4 operator+(SimdUInt4 other) const { return { _mm_add_epi32(value, other.value) }; }
+    SimdUInt4 operator&(SimdUInt4 other) const { return { _mm_and_si128(value, other.value) }; }
+
+    template <int bits>
+    SimdUInt4 shiftRight() const { return { _mm_srli_epi32(value, bits) }; }
+
+    // Lanes must be below 2^31 (the conversion is signed)
+    SimdFloat4 toFloat() const { return { _mm_cvtepi32_ps(value) }; }
+#elif SUMMONER_SIMD_NEON
+    uint32x4_t value;
+
+    static SimdUInt4 load(const uint32_t* source) { return { vld1q_u32(source) }; }
+    static SimdUInt4 expand(uint32_t scalar) { return { vdupq_n_u32(scalar) }; }
+    void store(uint32_t* destination) const { vst1q_u32(destination, value); }
+
+    SimdUInt4 operator+(SimdUInt4 other) const { return { vaddq_u32(value, other.value) }; }
+    SimdUInt4 operator&(SimdUInt4 other) const { return { vandq_u32(value, other.value) }; }
+
+    template <int bits>
+    SimdUInt4 shiftRight() const { return { vshrq_n_u32(value, bits) }; }
+
+    SimdFloat4 toFloat() const { return { vcvtq_f32_u32(value) }; }
+#else
+    uint32_t value[4];
+
+    static SimdUInt4 load(const uint32_t* source) { return { { source[0], source[1], source[2], source[3] } }; }
+    static SimdUInt4 expand(uint32_t scalar) { return { { scalar, scalar, scalar, scalar } }; }
+    void store(uint32_t* destination) const { for (int i = 0; i < 4; ++i) destination[i] = value[i]; }
+
+    SimdUInt4 operator+(SimdUInt4 other) const { SimdUInt4 r; for (int i = 0; i < 4; ++i) r.value[i] = value[i] + other.value[i]; return r; }
+    SimdUInt4 operator&(SimdUInt4 other) const { SimdUInt4 r; for (int i = 0; i < 4; ++i) r.value[i] = value[i] & other.value[i]; return r; }
+
+    template <int bits>
+    SimdUInt4 shiftRight() const { SimdUInt4 r; for (int i = 0; i < 4; ++i) r.value[i] = value[i] >> bits; return r; }
+
+    SimdFloat4 toFloat() const { return SimdFloat4::fromValues(static_cast<float>(value[0]), static_cast<float>(value[1]), static_cast<float>(value[2]), static_cast<float>(value[3])); }
+#endif
+};
@@ -0,0 +1,72 @@
+#pragma once
+#include <JuceHeader.h>
+
+// Topology-preserving (zero-delay-feedback) state-variable filter, after Zavalishin and
+// Simper. One state update gives the lowpass, bandpass and highpass outputs, the notch
+// is derived from them, and the structure stays stable at any Q however fast the cutoff
+// moves. The bilinear prewarp uses a rational tan approximation, so the coefficients are
+// cheap enough to recompute on every sample of a sweep.
+class StateVariableFilter
+{
+public:
+    enum Mode
+    {
+        LOWPASS = 0,
+        HIGHPASS,
+        BANDPASS,
+        NOTCH
+    };
+
+    struct Coefficients
+    {
+        float k = 1.41421356f; // 1 / Q
+        float a1 = 1.0f, a2 = 0.0f, a3 = 0.0f;
+    };
+
+    // normalisedFrequency is cutoff / sample rate and is limited to 0.45
+    static Coefficients makeCoefficients(float normalisedFrequency, float q)
+    {
+        const float g = fastTan(juce::MathConstants<float>::pi * juce::jlimit(1.0e-5f, 0.45f, normalisedFrequency));
+
+        Coefficients c;
+        c.k = 1.0f / juce::jmax(0.05f, q);
+        c.a1 = 1.0f / (1.0f + g * (g + c.k));
+        c.a2 = g * c.a1;
+        c.a3 = g * c.a2;
+        return c;
+    }
+
+    // Pade [5/4] approximant of tan, within 0.01% up to 0.4 * pi (0.4 of the sample rate)
+    static float fastTan(float x)
+    {
+        const float x2 = x * x;
+        return x * (945.0f + x2 * (-105.0f + x2)) / (945.0f + x2 * (-420.0f + 15.0f * x2));
+    }
+
+    void reset()
+    {
+        ic1eq = 0.0f;
+        ic2eq = 0.0f;
+    }
+
+    float processSample(float input, const Coefficients& c, Mode mode)
+    {
+        const float v3 = input - ic2eq;
+        const float v1 = c.a1 * ic1eq + c.a2 * v3;
+        const float v2 = ic2eq + c.a2 * ic1eq + c.a3 * v3;
+        ic1eq = 2.0f * v1 - ic1eq;
+        ic2eq = 2.0f * v2 - ic2eq;
+
+        switch (mode)
+        {
+            case HIGHPASS: return input - c.k * v1 - v2;
+            case BANDPASS: return c.k * v1; // Unity gain at the centre frequency
+            case NOTCH:    return input - c.k * v1;
+            case LOWPASS:
+            default:       return v2;
+        }
+    }
+
+private:
+    float ic1eq = 0.0f, ic2eq = 0.0f; // Trapezoidal integrator states
+};
@@ -0,0 +1,63 @@
+#pragma once
+#include <JuceHeader.h>
+
+// Lets an effect be skipped while its input is silent and its own tail has died away.
+// The effect reports its worst-case tail length; the gate counts silent input samples
+// and bypasses the effect once that many have passed.
+class TailGate
+{
+public:
+    static constexpr float silenceThreshold = 1.0e-5f; // -100 dB
+    static constexpr double maxTailSeconds = 30.0;
+
+    static bool isSilent(const juce::AudioBuffer<float>& buffer, int numSamples)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            if (buffer.getMagnitude(ch, 0, numSamples) > silenceThreshold)
+                return false;
+        }
+
+        return true;
+    }
+
+    // Time for a feedback loop of the given length to decay below the silence threshold
+    static double getFeedbackTailSeconds(double loopSeconds, float feedback)
+    {
+        const float gain = std::abs(feedback);
+        if (gain < silenceThreshold)
+            return loopSeconds;
+
+        const double repeats = std::ceil(std::log(static_cast<double>(silenceThreshold)) / std::log(static_cast<double>(juce::jmin(gain, 0.9999f))));
+        return juce::jmin(maxTailSeconds, loopSeconds * (1.0 + repeats));
+    }
+
+    // Ring-out time of a two-pole resonance (envelope falls as exp(-pi * f * t / Q))
+    static double getResonanceTailSeconds(float frequency, float q)
+    {
+        const double decay = -std::log(static_cast<double>(silenceThreshold));
+        return juce::jmin(maxTailSeconds, decay * juce::jmax(0.5, static_cast<double>(q)) / (juce::MathConstants<double>::pi * juce::jmax(1.0f, frequency)));
+    }
+
+    // Returns true when the effect can be skipped for this block
+    bool shouldBypass(bool inputSilent, double tailSeconds, double sampleRate, int numSamples)
+    {
+        if (!inputSilent)
+        {
+            silentSamples = 0;
+            return false;
+        }
+
+        const auto tailSamples = static_cast<juce::int64>(std::ceil(tailSeconds * sampleRate));
+        if (silentSamples >= tailSamples)
+            return true;
+
+        silentSamples += numSamples;
+        return false;
+    }
+
+    void reset() { silentSamples = 0; }
+
+private:
+    juce::int64 silentSamples = 0;
+};
@@ -0,0 +1,262 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+
+// Frequency of every MIDI note, plus headroom on both sides for the oscillators'
+// semitone offsets. Filled whenever the tuning changes so a note-on is a lookup;
+// a plain array, so a new table can be copied across to the audio thread as-is.
+class TuningTable
+{
+public:
+    static constexpr int lowestNote = -64;
+    static constexpr int numNotes = 256;
+
+    TuningTable()
+    {
+        for (int i = 0; i < numNotes; ++i)
+            frequencies[static_cast<size_t>(i)] = 440.0 * std::pow(2.0, (lowestNote + i - 69) / 12.0);
+    }
+
+    // 0 for keys a keyboard mapping leaves unmapped
+    double getFrequency(int note) const
+    {
+        return frequencies[static_cast<size_t>(juce::jlimit(0, numNotes - 1, note - lowestNote))];
+    }
+
+    void setFrequency(int note, double frequency)
+    {
+        jassert(note >= lowestNote && note < lowestNote + numNotes);
+        frequencies[static_cast<size_t>(note - lowestNote)] = frequency;
+    }
+
+    // 2^(cents / 1200), from a one-cent table over +/- two octaves; linear interpolation
+    // between neighbouring cents is accurate to well under a thousandth of a cent
+    static double centsToRatio(double cents)
+    {
+        static const auto table = []
+        {
+            std::array<double, 2 * maxTableCents + 2> ratios {};
+            for (size_t i = 0; i < ratios.size(); ++i)
+                ratios[i] = std::pow(2.0, (static_cast<double>(i) - maxTableCents) / 1200.0);
+            return ratios;
+        }();
+
+        if (std::abs(cents) >= maxTableCents)
+            return std::pow(2.0, cents / 1200.0);
+
+        const double position = cents + maxTableCents;
+        const int index = static_cast<int>(position);
+        const double fraction = position - index;
+        return table[static_cast<size_t>(index)] + fraction * (table[static_cast<size_t>(index + 1)] - table[static_cast<size_t>(index)]);
+    }
+
+private:
+    static constexpr int maxTableCents = 2400;
+
+    std::array<double, numNotes> frequencies {};
+};
+
+// Scala scale (.scl) and keyboard mapping (.kbm) files, turned into a TuningTable.
+// Without either file this is 12-tone equal temperament with A4 (note 69) at 440 Hz.
+// Runs on the message thread only.
+class ScalaTuning
+{
+public:
+    ScalaTuning() { reset(); }
+
+    void reset()
+    {
+        resetScale();
+        resetKeyboardMapping();
+    }
+
+    void resetScale()
+    {
+        scaleCents.clear();
+        for (int i = 1; i <= 12; ++i)
+            scaleCents.push_back(i * 100.0);
+        scaleDescription = "12-tone equal temperament";
+        scaleText.clear();
+    }
+
+    void resetKeyboardMapping()
+    {
+        mapping.clear();
+        middleNote = 60;
+        referenceNote = 69;
+        referenceFrequency = 440.0;
+        octaveDegree = 0;
+        mappingText.clear();
+    }
+
+    // Both loaders return false and leave the tuning unchanged if the text is not valid
+    bool loadScale(const juce::String& text)
+    {
+        const auto lines = getDataLines(text, true);
+        if (lines.size() < 2)
+            return false;
+
+        const int numDegrees = lines[1].trim().getIntValue();
+        if (numDegrees < 1 || lines.size() < numDegrees + 2)
+            return false;
+
+        std::vector<double> cents;
+        for (int i = 0; i < numDegrees; ++i)
+        {
+            double value = 0.0;
+            if (!parsePitch(lines[i + 2], value))
+                return false;
+            cents.push_back(value);
+        }
+
+        // The last degree is the period; a scale that does not rise cannot repeat
+        if (cents.back() <= 0.0)
+            return false;
+
+        scaleCents = std::move(cents);
+        scaleDescription = lines[0].trim();
+        scaleText = text;
+        return true;
+    }
+
+    bool loadKeyboardMapping(const juce::String& text)
+    {
+        const auto lines = getDataLines(text, false);
+        if (lines.size() < 7)
+            return false;
+
+        const int size = lines[0].trim().getIntValue();
+        const int newMiddleNote = lines[3].trim().getIntValue();
+        const int newReferenceNote = lines[4].trim().getIntValue();
+        const double newReferenceFrequency = lines[5].trim().getDoubleValue();
+        const int newOctaveDegree = lines[6].trim().getIntValue();
+
+        if (size < 0 || newReferenceFrequency <= 0.0 || newOctaveDegree < 0)
+            return false;
+
+        // Entries are scale degrees or 'x' for an unmapped key; missing entries are unmapped
+        std::vector<int> newMapping;
+        for (int i = 0; i < size; ++i)
+        {
+            const auto entry = i + 7 < lines.size() ? lines[i + 7].trim() : juce::String("x");
+            newMapping.push_back(entry.startsWithIgnoreCase("x") ? -1 : entry.getIntValue());
+        }
+
+        mapping = std::move(newMapping);
+        middleNote = newMiddleNote;
+        referenceNote = newReferenceNote;
+        referenceFrequency = newReferenceFrequency;
+        octaveDegree = newOctaveDegree;
+        mappingText = text;
+        return true;
+    }
+
+    // The first and last note fields of a .kbm are not applied: every key, including the
+    // headroom the oscillators' semitone offsets reach, follows the mapping
+    void fillTable(TuningTable& table) const
+    {
+        int referenceDegree = 0;
+        if (!getDegreeForNote(referenceNote, referenceDegree))
+            referenceDegree = referenceNote - middleNote;
+        const double referenceCents = getCentsForDegree(referenceDegree);
+
+        for (int note = TuningTable::lowestNote; note < TuningTable::lowestNote + TuningTable::numNotes; ++note)
+        {
+            int degree = 0;
+            const double frequency = getDegreeForNote(note, degree)
+                                   ? referenceFrequency * std::pow(2.0, (getCentsForDegree(degree) - referenceCents) / 1200.0)
+                                   : 0.0;
+            table.setFrequency(note, frequency);
+        }
+    }
+
+    const juce::String& getScaleText() const { return scaleText; }
+    const juce::String& getKeyboardMappingText() const { return mappingText; }
+    const juce::String& getScaleDescription() const { return scaleDescription; }
+
+private:
+    // Non-comment lines; comments start with '!' in the first column
+    static juce::StringArray getDataLines(const juce::String& text, bool keepEmptyLines)
+    {
+        juce::StringArray lines;
+        for (const auto& line : juce::StringArray::fromLines(text))
+        {
+            if (line.startsWithChar('!'))
+                continue;
+            if (!keepEmptyLines && line.trim().isEmpty())
+                continue;
+            lines.add(line);
+        }
+        return lines;
+    }
+
+    // A pitch with a '.' is in cents, anything else is a ratio ("3/2") or an integer ("2")
+    static bool parsePitch(const juce::String& line, double& cents)
+    {
+        const auto token = line.trim().upToFirstOccurrenceOf(" ", false, false)
+                                      .upToFirstOccurrenceOf("\t", false, false);
+        if (token.isEmpty())
+            return false;
+
+        if (token.containsChar('.'))
+        {
+            cents = token.getDoubleValue();
+            return true;
+        }
+
+        const double numerator = token.upToFirstOccurrenceOf("/", false, false).getDoubleValue();
+        const double denominator = token.containsChar('/') ? token.fromFirstOccurrenceOf("/", false, false).getDoubleValue() : 1.0;
+        if (numerator <= 0.0 || denominator <= 0.0)
+            return false;
+
+        cents = 1200.0 * std::log2(numerator / denominator);
+        return true;
+    }
+
+    static int floorDivide(int value, int divisor)
+    {
+        return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+    }
+
+    // Scale degree (counted from the middle note's degree 0) for a key, false if unmapped
+    bool getDegreeForNote(int note, int& degree) const
+    {
+        const int offset = note - middleNote;
+        const int mapSize = static_cast<int>(mapping.size());
+
+        if (mapSize == 0)
+        {
+            degree = offset;
+            return true;
+        }
+
+        const int repeat = floorDivide(offset, mapSize);
+        const int entry = mapping[static_cast<size_t>(offset - repeat * mapSize)];
+        if (entry < 0)
+            return false;
+
+        const int degreesPerRepeat = octaveDegree > 0 ? octaveDegree : static_cast<int>(scaleCents.size());
+        degree = repeat * degreesPerRepeat + entry;
+        return true;
+    }
+
+    double getCentsForDegree(int degree) const
+    {
+        const int numDegrees = static_cast<int>(scaleCents.size());
+        const int period = floorDivide(degree, numDegrees);
+        const int index = degree - period * numDegrees;
+        return period * scaleCents.back() + (index > 0 ? scaleCents[static_cast<size_t>(index - 1)] : 0.0);
+    }
+
+    std::vector<double> scaleCents; // Degrees 1 to N; degree 0 is 0 cents and N is the period
+    juce::String scaleDescription;
+    juce::String scaleText;
+
+    std::vector<int> mapping; // Empty = every key is the next scale degree
+    int middleNote = 60; // Key that plays degree 0
+    int referenceNote = 69;
+    double referenceFrequency = 440.0;
+    int octaveDegree = 0; // Degrees per repeat of the mapping, 0 = the scale size
+    juce::String mappingText;
+};
@@ -0,0 +1,292 @@
+#pragma once
+#include <JuceHeader.h>
+#include "SimdFloat4.h"
+#include "WavetableBank.h"
+
+// Unison stack for one oscillator, stored as struct-of-arrays so four voices are
+// rendered per SIMD instruction. Pan gains are precomputed whenever the voice count,
+// stereo width or level changes instead of running std::cos/std::sin per sample.
+// Phases are 32-bit fixed point (a full cycle is 2^32), so they wrap by integer
+// overflow and a held note keeps exactly the same pitch however long it plays.
+class UnisonOscillator
+{
+public:
+    static constexpr int maxVoices = 16;
+    static constexpr int laneWidth = 4;
+
+    UnisonOscillator()
+    {
+        for (int lane = 0; lane < maxVoices; ++lane)
+            tables[lane] = silentTable;
+    }
+
+    void setVoiceCount(int count)
+    {
+        voiceCount = juce::jlimit(1, maxVoices, count);
+        numLaneGroups = (voiceCount + laneWidth - 1) / laneWidth;
+        updateGains();
+    }
+
+    void setStereoWidth(float width)
+    {
+        stereoWidth = width;
+        updateGains();
+    }
+
+    // Overall level applied to the summed stack (the 1 / sqrt(voices) normalisation is added on top)
+    void setLevel(float newLevel)
+    {
+        level = newLevel;
+        updateGains();
+    }
+
+    // Phase in cycles (0.0 to 1.0), increment in cycles per sample (clamped to Nyquist)
+    void setVoice(int lane, double phase, double increment)
+    {
+        jassert(lane >= 0 && lane < maxVoices);
+        const double limitedIncrement = juce::jlimit(0.0, 0.5, increment);
+        increments[lane] = toFixedPoint(limitedIncrement);
+        phases[lane] = toFixedPoint(phase - std::floor(phase));
+        mipLevels[lane] = WavetableBank::getMipLevelForIncrement(limitedIncrement);
+    }
+
+    // Retunes a lane without resetting its phase, for pitch changes during a note; the
+    // new mip level takes effect at the next selectTables
+    void setIncrement(int lane, double increment)
+    {
+        jassert(lane >= 0 && lane < maxVoices);
+        const double limitedIncrement = juce::jlimit(0.0, 0.5, increment);
+        increments[lane] = toFixedPoint(limitedIncrement);
+        mipLevels[lane] = WavetableBank::getMipLevelForIncrement(limitedIncrement);
+    }
+
+    // Points every lane at the band-limited table for its pitch; call once per block
+    void selectTables(const WavetableBank& bank, int waveform)
+    {
+        for (int lane = 0; lane < maxVoices; ++lane)
+            tables[lane] = bank.getTable(waveform, mipLevels[lane]);
+    }
+
+    int getVoiceCount() const { return voiceCount; }
+    float getLeftGain(int lane) const { return leftGains[lane]; }
+    float getRightGain(int lane) const { return rightGains[lane]; }
+
+    // Renders one stereo sample from every active voice, four lanes at a time
+    void processSample(float& left, float& right)
+    {
+        auto sumLeft = SimdFloat4::expand(0.0f);
+        auto sumRight = SimdFloat4::expand(0.0f);
+        const auto fractionMask = SimdUInt4::expand(fractionMaskBits);
+        const auto fractionScale = SimdFloat4::expand(1.0f / static_cast<float>(1u << fractionBits));
+
+        for (int group = 0; group < numLaneGroups; ++group)
+        {
+            const int base = group * laneWidth;
+            const auto phase = SimdUInt4::load(phases + base);
+
+            // Top bits index the table, the rest interpolate between neighbouring points
+            alignas(16) uint32_t index[laneWidth];
+            phase.shiftRight<fractionBits>().store(index);
+            const auto fraction = (phase & fractionMask).toFloat() * fractionScale;
+
+            // Table lookups are the only per-lane step (no gather in SSE/NEON)
+            const float* t0 = tables[base] + index[0];
+            const float* t1 = tables[base + 1] + index[1];
+            const float* t2 = tables[base + 2] + index[2];
+            const float* t3 = tables[base + 3] + index[3];
+            const auto a = SimdFloat4::fromValues(t0[0], t1[0], t2[0], t3[0]);
+            const auto b = SimdFloat4::fromValues(t0[1], t1[1], t2[1], t3[1]);
+            const auto sample = a + fraction * (b - a);
+
+            sumLeft += sample * SimdFloat4::load(leftGains + base);
+            sumRight += sample * SimdFloat4::load(rightGains + base);
+
+            (phase + SimdUInt4::load(increments + base)).store(phases + base);
+        }
+
+        left = sumLeft.sum();
+        right = sumRight.sum();
+    }
+
+    // Renders a block of the summed stack, overwriting left and right
+    void renderBlock(float* left, float* right, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            processSample(left[i], right[i]);
+    }
+
+    // Variable-width pulse, +1 for the first width of each cycle. The tables can only
+    // hold a fixed 50% square, so the pulse is generated directly and both edges get a
+    // PolyBLEP correction, which removes most of the aliasing a naive pulse would have.
+    // The DC the width introduces is removed so the level stays centred.
+    void renderPulseBlock(float* left, float* right, int numSamples, float width)
+    {
+        std::fill(left, left + numSamples, 0.0f);
+        std::fill(right, right + numSamples, 0.0f);
+
+        const float limitedWidth = juce::jlimit(minPulseWidth, 1.0f - minPulseWidth, width);
+        const uint32_t fallingEdge = toFixedPoint(limitedWidth);
+        const float dcOffset = 2.0f * limitedWidth - 1.0f;
+
+        for (int lane = 0; lane < voiceCount; ++lane)
+        {
+            uint32_t phase = phases[lane];
+            const uint32_t increment = increments[lane];
+            const float dt = static_cast<float>(increment) * phaseScale;
+            const float leftGain = leftGains[lane];
+            const float rightGain = rightGains[lane];
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                // Phase relative to the falling edge, wrapped by the integer subtraction
+                const float t = static_cast<float>(phase) * phaseScale;
+                const float tFall = static_cast<float>(phase - fallingEdge) * phaseScale;
+                const float naive = phase < fallingEdge ? 1.0f : -1.0f;
+                const float sample = naive + polyBlep(t, dt) - polyBlep(tFall, dt) - dcOffset;
+
+                left[i] += sample * leftGain;
+                right[i] += sample * rightGain;
+                phase += increment;
+            }
+
+            phases[lane] = phase;
+        }
+
+        // Padding lanes produce nothing but keep their phases moving like processSample does
+        for (int lane = voiceCount; lane < numLaneGroups * laneWidth; ++lane)
+            phases[lane] += increments[lane] * static_cast<uint32_t>(numSamples);
+    }
+
+    // Mixes two uncorrelated noise blocks into the stack's stereo output. Independent
+    // noise in every voice only matters through its summed left/right power and the
+    // left/right correlation, and two sources reproduce both exactly, so the cost no
+    // longer grows with the voice count. Phases still advance for the pitched shapes.
+    void renderNoiseBlock(const float* noise0, const float* noise1, float* left, float* right, int numSamples)
+    {
+        juce::FloatVectorOperations::multiply(left, noise0, noiseLeftGain, numSamples);
+        juce::FloatVectorOperations::multiply(right, noise0, noiseRightGain, numSamples);
+        juce::FloatVectorOperations::addWithMultiply(right, noise1, noiseRightSideGain, numSamples);
+
+        advance(numSamples);
+    }
+
+    // Reference implementation of processSample, one voice at a time (used by the tests)
+    void processSampleScalar(float& left, float& right)
+    {
+        left = 0.0f;
+        right = 0.0f;
+
+        for (int lane = 0; lane < numLaneGroups * laneWidth; ++lane)
+        {
+            const uint32_t index = phases[lane] >> fractionBits;
+            const float fraction = static_cast<float>(phases[lane] & fractionMaskBits) / static_cast<float>(1u << fractionBits);
+            const float* table = tables[lane];
+            const float sample = table[index] + fraction * (table[index + 1] - table[index]);
+
+            left += sample * leftGains[lane];
+            right += sample * rightGains[lane];
+
+            phases[lane] += increments[lane];
+        }
+    }
+
+    // Advances the phases without producing output (used while the noise shapes play)
+    void advance(int numSamples)
+    {
+        for (int lane = 0; lane < numLaneGroups * laneWidth; ++lane)
+            phases[lane] += increments[lane] * static_cast<uint32_t>(numSamples);
+    }
+
+private:
+    // The top 11 bits of a phase index the 2048-point tables
+    static constexpr int fractionBits = 32 - 11;
+    static constexpr uint32_t fractionMaskBits = (1u << fractionBits) - 1;
+    static_assert(WavetableBank::tableSize == (1 << (32 - fractionBits)), "fractionBits must match the table size");
+
+    static constexpr float phaseScale = 1.0f / 4294967296.0f; // Fixed point to cycles
+    static constexpr float minPulseWidth = 0.01f;
+
+    // Residual of a band-limited step at t = 0, spread over one sample either side.
+    // t is the phase since the step and dt the increment, both in cycles.
+    static float polyBlep(float t, float dt)
+    {
+        if (t < dt)
+        {
+            const float x = t / dt;
+            return x + x - x * x - 1.0f;
+        }
+
+        if (t > 1.0f - dt)
+        {
+            const float x = (t - 1.0f) / dt;
+            return x * x + x + x + 1.0f;
+        }
+
+        return 0.0f;
+    }
+
+    // Cycles (0.0 to 1.0) to 32-bit fixed point
+    static uint32_t toFixedPoint(double cycles)
+    {
+        return static_cast<uint32_t>(static_cast<uint64_t>(std::llround(cycles * 4294967296.0)) & 0xffffffffu);
+    }
+
+    void updateGains()
+    {
+        const float normalisation = level / std::sqrt(static_cast<float>(voiceCount));
+
+        for (int lane = 0; lane < maxVoices; ++lane)
+        {
+            if (lane >= voiceCount)
+            {
+                // Padding lanes keep running but contribute nothing
+                leftGains[lane] = 0.0f;
+                rightGains[lane] = 0.0f;
+                continue;
+            }
+
+            // Spread voices across the stereo field based on stereo width
+            float voicePan = 0.0f;
+            if (voiceCount > 1)
+            {
+                voicePan = (lane - (voiceCount - 1) / 2.0f) / ((voiceCount - 1) / 2.0f) * stereoWidth;
+                voicePan = juce::jlimit(-1.0f, 1.0f, voicePan);
+            }
+
+            // Equal power panning
+            leftGains[lane] = std::cos((voicePan + 1.0f) * juce::MathConstants<float>::pi * 0.25f) * normalisation;
+            rightGains[lane] = std::sin((voicePan + 1.0f) * juce::MathConstants<float>::pi * 0.25f) * normalisation;
+        }
+
+        // Left takes source 0 at the summed left power; right takes the part of source 0
+        // that matches the voices' left/right correlation plus enough of source 1 to
+        // reach the summed right power
+        float leftPower = 0.0f, rightPower = 0.0f, crossPower = 0.0f;
+        for (int lane = 0; lane < voiceCount; ++lane)
+        {
+            leftPower += leftGains[lane] * leftGains[lane];
+            rightPower += rightGains[lane] * rightGains[lane];
+            crossPower += leftGains[lane] * rightGains[lane];
+        }
+
+        noiseLeftGain = std::sqrt(leftPower);
+        noiseRightGain = noiseLeftGain > 0.0f ? crossPower / noiseLeftGain : 0.0f;
+        noiseRightSideGain = std::sqrt(juce::jmax(0.0f, rightPower - noiseRightGain * noiseRightGain));
+    }
+
+    alignas(16) uint32_t phases[maxVoices] = {}; // Phase, a full cycle is 2^32
+    alignas(16) uint32_t increments[maxVoices] = {}; // Phase step per sample
+    alignas(16) float leftGains[maxVoices] = {};
+    alignas(16) float rightGains[maxVoices] = {};
+    float noiseLeftGain = 0.0f, noiseRightGain = 0.0f, noiseRightSideGain = 0.0f;
+    int mipLevels[maxVoices] = {};
+    const float* tables[maxVoices];
+
+    // All-zero table so every lane is readable before the first selectTables()
+    static constexpr float silentTable[WavetableBank::tableStride] = {};
+
+    int voiceCount = 1;
+    int numLaneGroups = 1;
+    float stereoWidth = 0.5f;
+    float level = 1.0f;
+};
@@ -0,0 +1,113 @@
+#pragma once
+#include <JuceHeader.h>
+#include "SimdFloat4.h"
+#include "StateVariableFilter.h"
+
+// A voice's oscillator filters as the four lanes of one SIMD register:
+// [osc1 left, osc1 right, osc2 left, osc2 right]. Each lane is the same TPT state-variable
+// filter as StateVariableFilter, with its coefficients and state stored per lane, so a
+// single vector update replaces four scalar filter calls. The lane's mode is folded into
+// three output weights (input, bandpass, lowpass), which lets lanes differ in mode too.
+class VoiceFilterBank
+{
+public:
+    static constexpr int numLanes = 4;
+    static constexpr int maxStages = 2;
+
+    VoiceFilterBank()
+    {
+        for (int oscillator = 0; oscillator < 2; ++oscillator)
+            setOscillator(oscillator, {}, StateVariableFilter::LOWPASS, 1);
+        reset();
+    }
+
+    // Sets both lanes of one oscillator (0 or 1); numStages is 1 (12dB) or 2 (24dB)
+    void setOscillator(int oscillator, const StateVariableFilter::Coefficients& c, StateVariableFilter::Mode mode, int numStages)
+    {
+        float inputWeight = 0.0f, bandWeight = 0.0f, lowWeight = 0.0f;
+        switch (mode)
+        {
+            case StateVariableFilter::HIGHPASS: inputWeight = 1.0f; bandWeight = -c.k; lowWeight = -1.0f; break;
+            case StateVariableFilter::BANDPASS: bandWeight = c.k; break;
+            case StateVariableFilter::NOTCH:    inputWeight = 1.0f; bandWeight = -c.k; break;
+            case StateVariableFilter::LOWPASS:
+            default:                            lowWeight = 1.0f; break;
+        }
+
+        for (int lane = 2 * oscillator; lane < 2 * oscillator + 2; ++lane)
+        {
+            a1[lane] = c.a1;
+            a2[lane] = c.a2;
+            a3[lane] = c.a3;
+
+            for (int stage = 0; stage < maxStages; ++stage)
+            {
+                // A stage the lane does not use passes its input straight through
+                const bool used = stage < numStages;
+                inputWeights[stage][lane] = used ? inputWeight : 1.0f;
+                bandWeights[stage][lane] = used ? bandWeight : 0.0f;
+                lowWeights[stage][lane] = used ? lowWeight : 0.0f;
+            }
+        }
+
+        stagesInUse[oscillator] = juce::jlimit(1, maxStages, numStages);
+    }
+
+    void reset()
+    {
+        for (int stage = 0; stage < maxStages; ++stage)
+        {
+            for (int lane = 0; lane < numLanes; ++lane)
+            {
+                ic1[stage][lane] = 0.0f;
+                ic2[stage][lane] = 0.0f;
+            }
+        }
+    }
+
+    // Filters numFrames interleaved frames in place (frame i is data[4 * i] to data[4 * i + 3])
+    void processInterleaved(float* data, int numFrames)
+    {
+        const int numStages = juce::jmax(stagesInUse[0], stagesInUse[1]);
+        const auto coefficient1 = SimdFloat4::load(a1);
+        const auto coefficient2 = SimdFloat4::load(a2);
+        const auto coefficient3 = SimdFloat4::load(a3);
+
+        for (int stage = 0; stage < numStages; ++stage)
+        {
+            const auto inputWeight = SimdFloat4::load(inputWeights[stage]);
+            const auto bandWeight = SimdFloat4::load(bandWeights[stage]);
+            const auto lowWeight = SimdFloat4::load(lowWeights[stage]);
+            auto state1 = SimdFloat4::load(ic1[stage]);
+            auto state2 = SimdFloat4::load(ic2[stage]);
+
+            for (int i = 0; i < numFrames; ++i)
+            {
+                float* frame = data + numLanes * i;
+                const auto input = SimdFloat4::load(frame);
+
+                const auto v3 = input - state2;
+                const auto v1 = coefficient1 * state1 + coefficient2 * v3;
+                const auto v2 = state2 + coefficient2 * state1 + coefficient3 * v3;
+                state1 = v1 + v1 - state1;
+                state2 = v2 + v2 - state2;
+
+                (inputWeight * input + bandWeight * v1 + lowWeight * v2).store(frame);
+            }
+
+            state1.store(ic1[stage]);
+            state2.store(ic2[stage]);
+        }
+    }
+
+private:
+    alignas(16) float a1[numLanes] = {};
+    alignas(16) float a2[numLanes] = {};
+    alignas(16) float a3[numLanes] = {};
+    alignas(16) float inputWeights[maxStages][numLanes] = {};
+    alignas(16) float bandWeights[maxStages][numLanes] = {};
+    alignas(16) float lowWeights[maxStages][numLanes] = {};
+    alignas(16) float ic1[maxStages][numLanes] = {};
+    alignas(16) float ic2[maxStages][numLanes] = {};
+    int stagesInUse[2] = { 1, 1 };
+};
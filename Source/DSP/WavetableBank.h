@@ -0,0 +1,134 @@
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+
+// Band-limited, mip-mapped wavetables for the basic oscillator shapes.
+// Every octave gets its own table holding only the harmonics that stay below Nyquist,
+// so the voices can read them with a phase accumulator instead of calling std::sin/fmod.
+class WavetableBank
+{
+public:
+    enum Waveform
+    {
+        SINE = 0,
+        SAW,
+        SQUARE,
+        TRIANGLE,
+        NUM_WAVEFORMS
+    };
+
+    static constexpr int tableSize = 2048; // Samples per cycle (power of two)
+    static constexpr int numMipLevels = 11; // Level n holds (tableSize / 2) >> n harmonics
+    static constexpr int tableStride = tableSize + 1; // One guard point for interpolation
+
+    WavetableBank() = default;
+
+    // Builds every table once - the tables are sample rate independent, so later
+    // calls (e.g. from a second prepareToPlay) return immediately
+    void build()
+    {
+        if (built)
+            return;
+
+        tables.assign(static_cast<size_t>(NUM_WAVEFORMS * numMipLevels * tableStride), 0.0f);
+
+        // One cycle of a sine, indexed as (harmonic * sample) & mask so the additive
+        // synthesis below never calls std::sin
+        std::vector<float> sineCycle(tableSize);
+        for (int i = 0; i < tableSize; ++i)
+            sineCycle[static_cast<size_t>(i)] = static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * i / tableSize));
+
+        for (int level = 0; level < numMipLevels; ++level)
+        {
+            const int maxHarmonic = getHarmonicLimit(level);
+
+            for (int waveform = 0; waveform < NUM_WAVEFORMS; ++waveform)
+            {
+                float* table = getTableForWriting(waveform, level);
+
+                for (int harmonic = 1; harmonic <= maxHarmonic; ++harmonic)
+                {
+                    float amplitude = 0.0f;
+                    int phaseOffset = 0; // Quarter-cycle offset turns sin into cos
+
+                    switch (waveform)
+                    {
+                        case SINE:
+                            amplitude = (harmonic == 1) ? 1.0f : 0.0f;
+                            break;
+                        case SAW:
+                            // Rising ramp from -1 to 1: -(2/pi) * sum(sin(h x) / h)
+                            amplitude = -2.0f / (juce::MathConstants<float>::pi * harmonic);
+                            break;
+                        case SQUARE:
+                            // +1 for the first half cycle: (4/pi) * sum over odd h of sin(h x) / h
+                            amplitude = (harmonic % 2 == 1) ? 4.0f / (juce::MathConstants<float>::pi * harmonic) : 0.0f;
+                            break;
+                        case TRIANGLE:
+                            // -1 at phase 0, +1 at phase 0.5: -(8/pi^2) * sum over odd h of cos(h x) / h^2
+                            amplitude = (harmonic % 2 == 1) ? -8.0f / (juce::MathConstants<float>::pi * juce::MathConstants<float>::pi * harmonic * harmonic) : 0.0f;
+                            phaseOffset = tableSize / 4;
+                            break;
+                        default:
+                            break;
+                    }
+
+                    if (amplitude == 0.0f)
+                        continue;
+
+                    for (int i = 0; i < tableSize; ++i)
+                        table[i] += amplitude * sineCycle[static_cast<size_t>((harmonic * i + phaseOffset) & (tableSize - 1))];
+                }
+
+                table[tableSize] = table[0]; // Guard point
+            }
+        }
+
+        built = true;
+    }
+
+    bool isBuilt() const { return built; }
+
+    // Chooses the table whose highest harmonic stays below Nyquist for the given
+    // phase increment (cycles per sample). Done once per note, not per sample.
+    static int getMipLevelForIncrement(double increment)
+    {
+        if (increment <= 0.0)
+            return 0;
+
+        // Need ((tableSize / 2) >> level) * increment <= 0.5
+        const int level = static_cast<int>(std::ceil(std::log2(increment * tableSize)));
+        return juce::jlimit(0, numMipLevels - 1, level);
+    }
+
+    const float* getTable(int waveform, int level) const
+    {
+        jassert(built);
+        waveform = juce::jlimit(0, NUM_WAVEFORMS - 1, waveform);
+        level = juce::jlimit(0, numMipLevels - 1, level);
+        return tables.data() + static_cast<size_t>((waveform * numMipLevels + level) * tableStride);
+    }
+
+    // Linearly interpolated read, phase in cycles [0, 1)
+    static float read(const float* table, double phase)
+    {
+        const double position = phase * tableSize;
+        const int index = static_cast<int>(position);
+        const float fraction = static_cast<float>(position - index);
+        return table[index] + fraction * (table[index + 1] - table[index]);
+    }
+
+private:
+    static int getHarmonicLimit(int level)
+    {
+        return juce::jmax(1, (tableSize / 2) >> level);
+    }
+
+    float* getTableForWriting(int waveform, int level)
+    {
+        return tables.data() + static_cast<size_t>((waveform * numMipLevels + level) * tableStride);
+    }
+
+    std::vector<float> tables; // NUM_WAVEFORMS * numMipLevels tables of tableStride samples
+    bool built = false;
+};
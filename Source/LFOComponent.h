@@ -209,10 +209,14 @@ public:
     
     void mouseUp(const juce::MouseEvent& event) override
     {
+        const bool wasDragging = isDragging;
         isDragging = false;
         dragStartIndex = -1;
         selectedControlPoint = -1;
         repaint();
+        
+        if (wasDragging)
+            notifyWaveformChanged();
     }
     
     void mouseDoubleClick(const juce::MouseEvent& event) override
@@ -250,6 +254,7 @@ public:
                         removeControlPointAndAssociatedCurves(clickedPointIndex);
                         updateWaveformFromControlPoints();
                         repaint();
+                        notifyWaveformChanged();
                         return;
                     }
                 }
@@ -260,6 +265,7 @@ public:
                 controlPoints.erase(controlPoints.begin() + clickedPointIndex);
                 updateWaveformFromControlPoints();
                 repaint();
+                notifyWaveformChanged();
                 return;
             }
         }
@@ -292,6 +298,7 @@ public:
             
             updateWaveformFromControlPoints();
             repaint();
+            notifyWaveformChanged();
         }
     }
     
@@ -327,6 +334,9 @@ public:
     
     // Get/set waveform data
     const std::vector<float>& getWaveformData() const { return waveformPoints; }
+    
+    // Called once an edit is finished (not on every drag step) and after a preset shape
+    std::function<void()> onWaveformChanged;
     void setWaveformData(const std::vector<float>& data) {}
     
     // Discrete edit mode control
@@ -349,6 +359,7 @@ public:
             waveformPoints[i] = 0.5f + 0.4f * std::sin(phase);
         }
         repaint();
+        notifyWaveformChanged();
     }
     
     void resetToSawWave()
@@ -359,6 +370,7 @@ public:
             waveformPoints[i] = 0.1f + 0.8f * phase;
         }
         repaint();
+        notifyWaveformChanged();
     }
     
     void resetToSquareWave()
@@ -369,6 +381,7 @@ public:
             waveformPoints[i] = (phase < 0.5f) ? 0.8f : 0.2f;
         }
         repaint();
+        notifyWaveformChanged();
     }
     
     void resetToTriangleWave()
@@ -382,9 +395,16 @@ public:
                 waveformPoints[i] = 0.9f - 0.8f * ((phase - 0.5f) * 2.0f);
         }
         repaint();
+        notifyWaveformChanged();
     }
     
 private:
+    void notifyWaveformChanged()
+    {
+        if (onWaveformChanged)
+            onWaveformChanged();
+    }
+    
     // Waveform drawing area
     juce::Rectangle<int> waveformArea;
     
@@ -1127,6 +1147,11 @@ public:
         
         // Set up LFO waveform drawing area
         addAndMakeVisible(lfoWaveform);
+        lfoWaveform.onWaveformChanged = [this]()
+        {
+            if (onShapeChanged)
+                onShapeChanged(lfoWaveform.getWaveformData());
+        };
         
         // Set up rate knob
         lfoRateKnob.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
@@ -1426,6 +1451,7 @@ public:
         if (slider == &lfoRateKnob)
         {
             updateRateDisplay();
+            notifyRateChanged();
         }
     }
     
@@ -1443,7 +1469,7 @@ public:
             
             lfoBpmButton.setToggleState(false, juce::dontSendNotification);
             updateRateDisplay();
-            // TODO: Switch to Hz mode when implementation is added
+            notifyModeChanged();
         }
         else if (button == &lfoBpmButton)
         {
@@ -1456,13 +1482,12 @@ public:
             
             lfoHzButton.setToggleState(false, juce::dontSendNotification);
             updateRateDisplay();
-            // TODO: Switch to BPM mode when implementation is added
+            notifyModeChanged();
         }
         else if (button == &lfoTriggerButton)
         {
-            // Toggle trigger mode
-            bool isTriggered = lfoTriggerButton.getToggleState();
-            // TODO: Enable/disable trigger mode when implementation is added
+            // Toggle trigger mode (restarts the LFO on every note while in Hz mode)
+            notifyModeChanged();
         }
         else if (button == &lfoDrawButton)
         {
@@ -1513,44 +1538,83 @@ public:
     
     void updateRateDisplay()
     {
-        double rateValue = lfoRateKnob.getValue();
-        
         if (lfoHzButton.getToggleState())
         {
-            // Hz mode: slightly compressed logarithmic mapping from 0.001 to 100 Hz
-            // Map knob range 0.1-20.0 to logarithmic scale 0.001-100 Hz with reduced granularity
-            double normalizedValue = (rateValue - 0.1) / (20.0 - 0.1); // 0.0 to 1.0
-            
-            // Apply power curve to compress the lower end even more
-            double compressedValue = std::pow(normalizedValue, 0.25); // 0.25 creates more even distribution
-            
-            double logMin = std::log(0.001); // ln(0.001) ≈ -6.91
-            double logMax = std::log(100.0);  // ln(100) ≈ 4.61
-            double logValue = logMin + compressedValue * (logMax - logMin);
-            double displayHz = std::exp(logValue);
-            
-            juce::String displayText = juce::String(displayHz, 3) + " Hz";
+            juce::String displayText = juce::String(getRateHz(), 3) + " Hz";
             lfoRateValueLabel.setText(displayText, juce::dontSendNotification);
         }
         else if (lfoBpmButton.getToggleState())
         {
-            // BPM mode: Convert knob value to musical note values
-            // Map 0.1-20.0 to different note divisions
-            const char* noteValues[] = {
-                "32 bars", "16 bars", "8 bars", "4 bars", "2 bars", "1 bar",
-                "1/2", "1/3", "1/4", "1/6", "1/8", "1/12", "1/16", "1/24", 
-                "1/32", "1/48", "1/64", "1/96", "1/128", "1/192", "1/256"
-            };
-            
-            int numValues = sizeof(noteValues) / sizeof(noteValues[0]);
-            int index = static_cast<int>((rateValue - 0.1) / (20.0 - 0.1) * (numValues - 1));
-            index = juce::jlimit(0, numValues - 1, index);
-            
-            lfoRateValueLabel.setText(noteValues[index], juce::dontSendNotification);
+            lfoRateValueLabel.setText(noteValues[getSyncDivision()], juce::dontSendNotification);
         }
     }
     
+    // Hz mode: slightly compressed logarithmic mapping from 0.001 to 100 Hz
+    double getRateHz() const
+    {
+        // Map knob range 0.1-20.0 to logarithmic scale 0.001-100 Hz with reduced granularity
+        double normalizedValue = (lfoRateKnob.getValue() - 0.1) / (20.0 - 0.1); // 0.0 to 1.0
+        
+        // Apply power curve to compress the lower end even more
+        double compressedValue = std::pow(normalizedValue, 0.25); // 0.25 creates more even distribution
+        
+        double logMin = std::log(0.001); // ln(0.001) ≈ -6.91
+        double logMax = std::log(100.0);  // ln(100) ≈ 4.61
+        double logValue = logMin + compressedValue * (logMax - logMin);
+        return std::exp(logValue);
+    }
+    
+    // BPM mode: index into noteValues, mapping the knob's 0.1-20.0 across the divisions
+    int getSyncDivision() const
+    {
+        int index = static_cast<int>((lfoRateKnob.getValue() - 0.1) / (20.0 - 0.1) * (numNoteValues - 1));
+        return juce::jlimit(0, numNoteValues - 1, index);
+    }
+    
+    // 0 = free running, 1 = retriggered by notes, 2 = synced to the host tempo
+    int getMode() const
+    {
+        if (lfoBpmButton.getToggleState())
+            return 2;
+        return lfoTriggerButton.getToggleState() ? 1 : 0;
+    }
+    
+    // Processor hooks, set by the owner
+    std::function<void(const std::vector<float>&)> onShapeChanged;
+    std::function<void(float)> onRateChanged;
+    std::function<void(int)> onModeChanged;
+    std::function<void(int)> onSyncDivisionChanged;
+    
+
 private:
+    static constexpr int numNoteValues = 21;
+    static constexpr const char* noteValues[numNoteValues] = {
+        "32 bars", "16 bars", "8 bars", "4 bars", "2 bars", "1 bar",
+        "1/2", "1/3", "1/4", "1/6", "1/8", "1/12", "1/16", "1/24",
+        "1/32", "1/48", "1/64", "1/96", "1/128", "1/192", "1/256"
+    };
+    
+    // The knob sets the rate in Hz mode and the note division in BPM mode
+    void notifyRateChanged()
+    {
+        if (lfoBpmButton.getToggleState())
+        {
+            if (onSyncDivisionChanged)
+                onSyncDivisionChanged(getSyncDivision());
+        }
+        else if (onRateChanged)
+        {
+            onRateChanged(static_cast<float>(getRateHz()));
+        }
+    }
+    
+    void notifyModeChanged()
+    {
+        if (onModeChanged)
+            onModeChanged(getMode());
+        notifyRateChanged();
+    }
+    
     // LFO waveform drawing component
     LFOComponent lfoWaveform;
     
@@ -15,6 +15,20 @@ SummonerXSerum2AudioProcessor::SummonerXSerum2AudioProcessor()
 #endif
     settingsComponent(*this)
 {
+    // Allocate the whole voice pool up front; polyphony only limits how many are used
+    for (int i = 0; i < PolyphonicSynthesiser::maxPolyphony; ++i)
+    {
+        auto* voice = new SineWaveVoice();
+        voice->setWavetableBank(&wavetables);
+        voice->setTuningTable(&tuning);
+        synthesiser.addVoice(voice);
+        sineVoices.push_back(voice);
+    }
+    
+    synthesiser.addSound(new SineWaveSound());
+    synthesiser.setPolyphony(polyphony);
+    synthesiser.setStealMode(voiceStealMode);
+    
     // Initialize parameter mapping system
     initializeParameterMap();
     
@@ -61,7 +75,15 @@ bool SummonerXSerum2AudioProcessor::isMidiEffect() const
 
 double SummonerXSerum2AudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    // The effects run in series, so their tails add up
+    return chorus.getTailLengthSeconds()
+         + flanger.getTailLengthSeconds()
+         + phaser.getTailLengthSeconds()
+         + compressor.getTailLengthSeconds()
+         + distortion.getTailLengthSeconds()
+         + delay.getTailLengthSeconds()
+         + reverb.getTailLengthSeconds()
+         + eq.getTailLengthSeconds();
 }
 
 int SummonerXSerum2AudioProcessor::getNumPrograms()
@@ -89,18 +111,16 @@ void SummonerXSerum2AudioProcessor::changeProgramName(int index, const juce::Str
 
 void SummonerXSerum2AudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
-    // Initialize the internal synthesizer
-    synthesiser.clearVoices();
-    synthesiser.clearSounds();
+    // Audio is stopped here: apply anything still queued, then set every engine directly
+    audioThreadActive = false;
+    parameterChanges.drainAll(*this);
+    applyPendingTuning();
+    applyPendingLfoShape();
     
-    // Add voices for polyphony (fixed at 8 for good polyphony)
-    for (int i = 0; i < 8; ++i)
-        synthesiser.addVoice(new SineWaveVoice());
+    // Build the band-limited oscillator tables (only done once, shared by all voices)
+    wavetables.build();
     
-    // Add the sound
-    synthesiser.addSound(new SineWaveSound());
-    
-    // Set sample rate
+    // Set sample rate (the voice pool itself is kept across re-prepares)
     synthesiser.setCurrentPlaybackSampleRate(sampleRate);
     
     // Initialize both filter instances
@@ -129,12 +149,16 @@ void SummonerXSerum2AudioProcessor::prepareToPlay(double sampleRate, int samples
     osc1Filter.setResonance(resonanceToQ(filterResonance));
     osc1Filter.setFilterType(initialFilterType);
     osc1Filter.setFilterSlope(initialFilterSlope);
+    osc1Filter.setCombNegative(filterCombNegative);
+    osc1Filter.setFormantVowel(filterFormantVowel);
     
     osc2Filter.setSampleRate(sampleRate);
     osc2Filter.setCutoffFrequency(filterCutoff);
     osc2Filter.setResonance(resonanceToQ(filterResonance));
     osc2Filter.setFilterType(initialFilterType);
     osc2Filter.setFilterSlope(initialFilterSlope);
+    osc2Filter.setCombNegative(filterCombNegative);
+    osc2Filter.setFormantVowel(filterFormantVowel);
     
     // Initialize temporary buffers for oscillator separation
     osc1Buffer.setSize(2, samplesPerBlock);
@@ -150,6 +174,7 @@ void SummonerXSerum2AudioProcessor::prepareToPlay(double sampleRate, int samples
     chorus.setFeedback(chorusFeedback);
     chorus.setLPFCutoff(chorusLPF);
     chorus.setMix(chorusMix);
+    chorus.setVoices(chorusVoices);
     
     // Initialize flanger effect
     flanger.setSampleRate(sampleRate);
@@ -196,6 +221,8 @@ void SummonerXSerum2AudioProcessor::prepareToPlay(double sampleRate, int samples
     distortion.setFilterType(filterType);
     distortion.setFilterFrequency(distortionFilterFreq);
     distortion.setFilterQ(distortionFilterQ);
+    distortion.setOversampling(distortionOversampling);
+    setLatencySamples(DistortionEffect::getLatencyForMode(distortionEnabled, distortionOversampling));
     
     // Initialize delay effect
     delay.setSampleRate(sampleRate);
@@ -224,36 +251,39 @@ void SummonerXSerum2AudioProcessor::prepareToPlay(double sampleRate, int samples
     reverb.setPreDelay(reverbPreDelay);
     reverb.setDamping(reverbDamping / 100.0f); // Convert from percentage to 0-1
     reverb.setWidth(reverbWidth / 100.0f); // Convert from percentage to 0-1
+    if (sampleRate != reverbImpulseSampleRate)
+        queueReverbImpulseBuild();
     
-    // Initialize EQ effect
-    eq.setSampleRate(sampleRate);
+    // Initialize EQ effect; the sample rate goes last so the bands start settled
     eq.setEnabled(eqEnabled);
-    eq.setBand1Enabled(eq1Enabled);
-    eq.setBand2Enabled(eq2Enabled);
-    eq.setBand1Frequency(eq1Frequency);
-    eq.setBand1Q(eq1Q);
-    eq.setBand1Gain(eq1Gain);
-    BiquadFilter::FilterType eq1FilterType = BiquadFilter::PEAK;
-    if (eq1Type == 0) eq1FilterType = BiquadFilter::PEAK;
-    else if (eq1Type == 1) eq1FilterType = BiquadFilter::LOW_SHELF;
-    else if (eq1Type == 2) eq1FilterType = BiquadFilter::HIGH_PASS;
-    eq.setBand1Type(eq1FilterType);
-    
-    eq.setBand2Frequency(eq2Frequency);
-    eq.setBand2Q(eq2Q);
-    eq.setBand2Gain(eq2Gain);
-    BiquadFilter::FilterType eq2FilterType = BiquadFilter::PEAK;
-    if (eq2Type == 0) eq2FilterType = BiquadFilter::PEAK;
-    else if (eq2Type == 1) eq2FilterType = BiquadFilter::HIGH_SHELF;
-    else if (eq2Type == 2) eq2FilterType = BiquadFilter::LOW_PASS;
-    eq.setBand2Type(eq2FilterType);
-    
-    // Initialize filter routing for all voices
-    updateFilterRouting();
+    eq.setBandCount(eqBandCount);
+    for (int band = 0; band < maxEqBands; ++band)
+    {
+        const auto index = static_cast<size_t>(band);
+        eq.setBandEnabled(band, eqBandEnabled[index]);
+        eq.setBandType(band, static_cast<BiquadCoefficients::FilterType>(eqBandFilterType[index]));
+        eq.setBandFrequency(band, eqBandFrequency[index]);
+        eq.setBandQ(band, eqBandQ[index]);
+        eq.setBandGain(band, eqBandGain[index]);
+    }
+    eq.setSampleRate(sampleRate);
+    
+    // Push the current parameters to every voice in the pool
+    updateAllVoiceParameters();
+    
+    lfo.setSampleRate(sampleRate);
+    updateLfoParameters();
+    
+    // From now on setters hand their changes to processBlock
+    audioThreadActive = true;
 }
 
 void SummonerXSerum2AudioProcessor::releaseResources()
 {
+    audioThreadActive = false;
+    parameterChanges.drainAll(*this);
+    applyPendingTuning();
+    applyPendingLfoShape();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -281,236 +311,273 @@ void SummonerXSerum2AudioProcessor::processBlock(juce::AudioBuffer<float>& buffe
 {
     juce::ScopedNoDenormals noDenormals;
     
+    // Apply every parameter change made since the last block before anything renders
+    parameterChanges.drain(*this);
+    applyPendingTuning();
+    applyPendingLfoShape();
+    
+    const int numSamples = buffer.getNumSamples();
+    
     // Clear the buffer first
     for (auto i = 0; i < buffer.getNumChannels(); ++i)
-        buffer.clear(i, 0, buffer.getNumSamples());
+        buffer.clear(i, 0, numSamples);
     
-    // Render the synthesizer (filtering happens inside voices)
-    synthesiser.renderNextBlock(buffer, midiMessages, 0, buffer.getNumSamples());
+    // A tempo-synced LFO takes its rate from the host tempo and, while the host plays,
+    // its phase from the host's beat position; a synced delay takes its times from the tempo
+    const bool lfoSynced = lfo.getMode() == LfoEngine::TEMPO_SYNC;
+    if (lfoSynced || delay.getBpmSync())
+    {
+        if (auto* playHead = getPlayHead())
+        {
+            if (const auto position = playHead->getPosition())
+            {
+                if (const auto bpm = position->getBpm())
+                    hostBpm = *bpm;
+                
+                const auto ppq = position->getPpqPosition();
+                if (lfoSynced && ppq && position->getIsPlaying())
+                    lfo.syncToPosition(*ppq);
+            }
+        }
+        delay.setHostTempo(hostBpm);
+    }
     
-    // Count active voices for polyphonic scaling
-    int activeVoices = 0;
-    for (int i = 0; i < synthesiser.getNumVoices(); ++i)
+    // With routes active the block is rendered in control segments, the LFO moving its
+    // targets between them; otherwise it is a single segment
+    const int segmentLength = numActiveLfoRoutes > 0 ? lfo.getControlInterval() : numSamples;
+    for (int start = 0; start < numSamples; start += segmentLength)
     {
-        if (synthesiser.getVoice(i)->isVoiceActive())
-            activeVoices++;
+        const int length = juce::jmin(segmentLength, numSamples - start);
+        applyLfoModulation(midiMessages, start, length);
+        renderSegment(buffer, midiMessages, start, length);
     }
+}
+
+void SummonerXSerum2AudioProcessor::renderSegment(juce::AudioBuffer<float>& wholeBuffer, juce::MidiBuffer& midiMessages,
+                                                  int startSample, int numSamples)
+{
+    // The effects see the segment as a buffer of its own
+    juce::AudioBuffer<float> buffer(wholeBuffer.getArrayOfWritePointers(), wholeBuffer.getNumChannels(), startSample, numSamples);
     
-    // Apply polyphonic scaling to prevent overload with multiple voices
-    if (activeVoices > 1)
+    // Only render the synthesizer when there is MIDI to handle or a voice still sounding
+    bool bufferSilent = true;
+    if (!midiMessages.isEmpty() || synthesiser.getNumActiveVoices() > 0)
     {
-        float polyScale = 1.0f / std::sqrt((float)activeVoices);
-        buffer.applyGain(polyScale);
+        // Render the synthesizer (filtering happens inside voices)
+        synthesiser.renderNextBlock(wholeBuffer, midiMessages, startSample, numSamples);
+        
+        // Apply polyphonic scaling to prevent overload with multiple voices
+        const int activeVoices = synthesiser.getNumActiveVoices();
+        if (activeVoices > 1)
+        {
+            float polyScale = 1.0f / std::sqrt((float)activeVoices);
+            buffer.applyGain(polyScale);
+        }
+        
+        bufferSilent = TailGate::isSilent(buffer, numSamples);
     }
     
+    // Runs an effect unless its input is silent and its own tail has already decayed
+    const double currentSampleRate = getSampleRate();
+    auto processEffect = [&](auto& effect, TailGate& gate)
+    {
+        if (!effect.getEnabled() || gate.shouldBypass(bufferSilent, effect.getTailLengthSeconds(), currentSampleRate, numSamples))
+            return;
+        
+        effect.processBlock(buffer);
+        bufferSilent = TailGate::isSilent(buffer, numSamples);
+    };
+    
     // Apply chorus effect
-    chorus.processBlock(buffer);
+    processEffect(chorus, chorusGate);
     
     // Apply flanger effect
-    flanger.processBlock(buffer);
+    processEffect(flanger, flangerGate);
     
     // Apply phaser effect
-    phaser.processBlock(buffer);
+    processEffect(phaser, phaserGate);
     
     // Apply compressor effect
-    compressor.processBlock(buffer);
+    processEffect(compressor, compressorGate);
     
     // Apply distortion effect
-    distortion.processBlock(buffer);
+    processEffect(distortion, distortionGate);
     
     // Apply delay effect
-    delay.processBlock(buffer);
+    processEffect(delay, delayGate);
     
     // Apply reverb effect
-    reverb.processBlock(buffer);
+    processEffect(reverb, reverbGate);
     
     // Apply EQ effect
-    eq.processBlock(buffer);
+    processEffect(eq, eqGate);
     
     // Apply volume control
-    buffer.applyGain(masterVolume);
+    buffer.applyGain(outputGain);
 }
 
+// The update functions below run on the message thread. They read the processor's own
+// copy of each parameter and queue the voice update for the audio thread.
 void SummonerXSerum2AudioProcessor::updateEnvelopeParameters()
 {
-    for (int i = 0; i < synthesiser.getNumVoices(); ++i)
+    pushParameterChange([](auto& p, const auto& v)
     {
-        if (auto* voice = dynamic_cast<SineWaveVoice*>(synthesiser.getVoice(i)))
-        {
-            voice->setEnvelopeParameters(osc1Attack, osc1Decay, osc1Sustain, osc1Release);
-        }
-    }
+        p.forEachVoice([&v](SineWaveVoice& voice) { voice.setEnvelopeParameters(v[0], v[1], v[2], v[3]); });
+    }, osc1Attack, osc1Decay, osc1Sustain, osc1Release);
 }
 
 void SummonerXSerum2AudioProcessor::updateOsc1Type()
 {
-    for (int i = 0; i < synthesiser.getNumVoices(); ++i)
+    pushParameterChange([](auto& p, const auto& v)
     {
-        if (auto* voice = dynamic_cast<SineWaveVoice*>(synthesiser.getVoice(i)))
-        {
-            voice->setOsc1Type(osc1Type);
-        }
-    }
+        p.forEachVoice([&v](SineWaveVoice& voice) { voice.setOsc1Type(static_cast<int>(v[0])); });
+    }, static_cast<float>(osc1Type));
 }
 
 void SummonerXSerum2AudioProcessor::updateOsc1PulseWidth()
 {
-    for (int i = 0; i < synthesiser.getNumVoices(); ++i)
+    pushParameterChange([](auto& p, const auto& v)
     {
-        if (auto* voice = dynamic_cast<SineWaveVoice*>(synthesiser.getVoice(i)))
-        {
-            voice->setOsc1PulseWidth(osc1PulseWidth);
-        }
-    }
+        p.forEachVoice([&v](SineWaveVoice& voice) { voice.setOsc1PulseWidth(v[0]); });
+    }, osc1PulseWidth);
 }
 
 void SummonerXSerum2AudioProcessor::updateOsc1Octave()
 {
-    for (int i = 0; i < synthesiser.getNumVoices(); ++i)
+    pushParameterChange([](auto& p, const auto& v)
     {
-        if (auto* voice = dynamic_cast<SineWaveVoice*>(synthesiser.getVoice(i)))
-        {
-            voice->setOsc1Octave(osc1Octave);
-        }
-    }
+        p.forEachVoice([&v](SineWaveVoice& voice) { voice.setOsc1Octave(static_cast<int>(v[0])); });
+    }, static_cast<float>(osc1Octave));
 }
 
 void SummonerXSerum2AudioProcessor::updateOsc1Semitone()
 {
-    for (int i = 0; i < synthesiser.getNumVoices(); ++i)
+    pushParameterChange([](auto& p, const auto& v)
     {
-        if (auto* voice = dynamic_cast<SineWaveVoice*>(synthesiser.getVoice(i)))
-        {
-            voice->setOsc1Semitone(osc1Semitone);
-        }
-    }
+        p.forEachVoice([&v](SineWaveVoice& voice) { voice.setOsc1Semitone(static_cast<int>(v[0])); });
+    }, static_cast<float>(osc1Semitone));
 }
 
 void SummonerXSerum2AudioProcessor::updateOsc1FineTune()
 {
-    for (int i = 0; i < synthesiser.getNumVoices(); ++i)
+    pushParameterChange([](auto& p, const auto& v)
     {
-        if (auto* voice = dynamic_cast<SineWaveVoice*>(synthesiser.getVoice(i)))
-        {
-            voice->setOsc1FineTune(osc1FineTune);
-        }
-    }
+        p.forEachVoice([&v](SineWaveVoice& voice) { voice.setOsc1FineTune(static_cast<int>(v[0])); });
+    }, static_cast<float>(osc1FineTune));
 }
 
 void SummonerXSerum2AudioProcessor::updateOsc1RandomPhase()
 {
-    for (int i = 0; i < synthesiser.getNumVoices(); ++i)
+    pushParameterChange([](auto& p, const auto& v)
     {
-        if (auto* voice = dynamic_cast<SineWaveVoice*>(synthesiser.getVoice(i)))
-        {
-            voice->setOsc1RandomPhase(osc1RandomPhase);
-        }
-    }
+        p.forEachVoice([&v](SineWaveVoice& voice) { voice.setOsc1RandomPhase(v[0] != 0.0f); });
+    }, osc1RandomPhase ? 1.0f : 0.0f);
 }
 
 void SummonerXSerum2AudioProcessor::updateOsc1VoiceCount()
 {
     // Update oscillator 1 unison voice count for all existing voices
-    for (int i = 0; i < synthesiser.getNumVoices(); ++i)
+    pushParameterChange([](auto& p, const auto& v)
     {
-        if (auto* voice = dynamic_cast<SineWaveVoice*>(synthesiser.getVoice(i)))
-        {
-            voice->setOsc1VoiceCount(osc1VoiceCount);
-        }
-    }
+        p.forEachVoice([&v](SineWaveVoice& voice) { voice.setOsc1VoiceCount(static_cast<int>(v[0])); });
+    }, static_cast<float>(osc1VoiceCount));
 }
 
 void SummonerXSerum2AudioProcessor::updateOsc1Volume()
 {
-    for (int i = 0; i < synthesiser.getNumVoices(); ++i)
+    pushParameterChange([](auto& p, const auto& v)
     {
-        if (auto* voice = dynamic_cast<SineWaveVoice*>(synthesiser.getVoice(i)))
-        {
-            voice->setOsc1Volume(osc1Volume);
-        }
-    }
+        p.forEachVoice([&v](SineWaveVoice& voice) { voice.setOsc1Volume(v[0]); });
+    }, osc1Volume);
 }
 
 void SummonerXSerum2AudioProcessor::updateDetune()
 {
     // Update detune amount for all existing voices
-    for (int i = 0; i < synthesiser.getNumVoices(); ++i)
+    pushParameterChange([](auto& p, const auto& v)
     {
-        if (auto* voice = dynamic_cast<SineWaveVoice*>(synthesiser.getVoice(i)))
-        {
-            voice->setDetune(osc1Detune);
-        }
-    }
+        p.forEachVoice([&v](SineWaveVoice& voice) { voice.setDetune(v[0]); });
+    }, osc1Detune);
 }
 
 void SummonerXSerum2AudioProcessor::updateStereoWidth()
 {
     // Update stereo width for all existing voices
-    for (int i = 0; i < synthesiser.getNumVoices(); ++i)
+    pushParameterChange([](auto& p, const auto& v)
     {
-        if (auto* voice = dynamic_cast<SineWaveVoice*>(synthesiser.getVoice(i)))
-        {
-            voice->setStereoWidth(osc1StereoWidth);
-        }
-    }
+        p.forEachVoice([&v](SineWaveVoice& voice) { voice.setStereoWidth(v[0]); });
+    }, osc1StereoWidth);
 }
 
 void SummonerXSerum2AudioProcessor::updatePan()
 {
     // Update pan for all existing voices
-    for (int i = 0; i < synthesiser.getNumVoices(); ++i)
+    pushParameterChange([](auto& p, const auto& v)
     {
-        if (auto* voice = dynamic_cast<SineWaveVoice*>(synthesiser.getVoice(i)))
-        {
-            voice->setPan(osc1Pan);
-        }
-    }
+        p.forEachVoice([&v](SineWaveVoice& voice) { voice.setPan(v[0]); });
+    }, osc1Pan);
 }
 
 void SummonerXSerum2AudioProcessor::updatePhase()
 {
     // Update phase for all existing voices
-    for (int i = 0; i < synthesiser.getNumVoices(); ++i)
+    pushParameterChange([](auto& p, const auto& v)
     {
-        if (auto* voice = dynamic_cast<SineWaveVoice*>(synthesiser.getVoice(i)))
-        {
-            voice->setPhase(osc1Phase);
-        }
-    }
+        p.forEachVoice([&v](SineWaveVoice& voice) { voice.setPhase(v[0]); });
+    }, osc1Phase);
 }
 
 void SummonerXSerum2AudioProcessor::updateOsc2Parameters()
 {
-    // Update oscillator 2 parameters for all existing voices
-    for (int i = 0; i < synthesiser.getNumVoices(); ++i)
+    // Update oscillator 2 parameters for all existing voices, four values per change
+    pushParameterChange([](auto& p, const auto& v)
     {
-        if (auto* voice = dynamic_cast<SineWaveVoice*>(synthesiser.getVoice(i)))
+        p.forEachVoice([&v](SineWaveVoice& voice)
         {
-            voice->setOsc2Volume(osc2Volume);
-            voice->setOsc2Enabled(osc2Enabled);
-            voice->setOsc2Type(osc2Type);
-            voice->setOsc2VoiceCount(osc2VoiceCount);
-            voice->setOsc2Detune(osc2Detune);
-            voice->setOsc2Stereo(osc2Stereo);
-            voice->setOsc2Pan(osc2Pan);
-            voice->setOsc2Octave(osc2Octave);
-            voice->setOsc2Semitone(osc2Semitone);
-            voice->setOsc2FineTune(osc2FineTune);
-            voice->setOsc2RandomPhase(osc2RandomPhase);
-            voice->setOsc2Phase(osc2Phase);
-        }
-    }
+            voice.setOsc2Volume(v[0]);
+            voice.setOsc2Enabled(v[1] != 0.0f);
+            voice.setOsc2Type(static_cast<int>(v[2]));
+            voice.setOsc2VoiceCount(static_cast<int>(v[3]));
+        });
+    }, osc2Volume, osc2Enabled ? 1.0f : 0.0f, static_cast<float>(osc2Type), static_cast<float>(osc2VoiceCount));
+    
+    pushParameterChange([](auto& p, const auto& v)
+    {
+        p.forEachVoice([&v](SineWaveVoice& voice)
+        {
+            voice.setOsc2Detune(v[0]);
+            voice.setOsc2Stereo(v[1]);
+            voice.setOsc2Pan(v[2]);
+            voice.setOsc2Octave(static_cast<int>(v[3]));
+        });
+    }, osc2Detune, osc2Stereo, osc2Pan, static_cast<float>(osc2Octave));
+    
+    pushParameterChange([](auto& p, const auto& v)
+    {
+        p.forEachVoice([&v](SineWaveVoice& voice)
+        {
+            voice.setOsc2Semitone(static_cast<int>(v[0]));
+            voice.setOsc2FineTune(static_cast<int>(v[1]));
+            voice.setOsc2RandomPhase(v[2] != 0.0f);
+            voice.setOsc2Phase(v[3]);
+        });
+    }, static_cast<float>(osc2Semitone), static_cast<float>(osc2FineTune), osc2RandomPhase ? 1.0f : 0.0f, osc2Phase);
+}
+
+void SummonerXSerum2AudioProcessor::updateOsc2PulseWidth()
+{
+    pushParameterChange([](auto& p, const auto& v)
+    {
+        p.forEachVoice([&v](SineWaveVoice& voice) { voice.setOsc2PulseWidth(v[0]); });
+    }, osc2PulseWidth);
 }
 
 void SummonerXSerum2AudioProcessor::updateOsc2EnvelopeParameters()
 {
-    for (int i = 0; i < synthesiser.getNumVoices(); ++i)
+    pushParameterChange([](auto& p, const auto& v)
     {
-        if (auto* voice = dynamic_cast<SineWaveVoice*>(synthesiser.getVoice(i)))
-        {
-            voice->setOsc2EnvelopeParameters(osc2Attack, osc2Decay, osc2Sustain, osc2Release);
-        }
-    }
+        p.forEachVoice([&v](SineWaveVoice& voice) { voice.setOsc2EnvelopeParameters(v[0], v[1], v[2], v[3]); });
+    }, osc2Attack, osc2Decay, osc2Sustain, osc2Release);
 }
 
 void SummonerXSerum2AudioProcessor::updateFilterParameters()
@@ -537,36 +604,393 @@ void SummonerXSerum2AudioProcessor::updateFilterParameters()
     if (filter24dBEnabled)
         filterSlope = SimpleStableFilter::SLOPE_24DB;
     
-    osc1Filter.setCutoffFrequency(filterCutoff);
-    osc1Filter.setResonance(resonanceToQ(filterResonance));
-    osc1Filter.setFilterType(filterType);
-    osc1Filter.setFilterSlope(filterSlope);
-    osc2Filter.setCutoffFrequency(filterCutoff);
-    osc2Filter.setResonance(resonanceToQ(filterResonance));
-    osc2Filter.setFilterType(filterType);
-    osc2Filter.setFilterSlope(filterSlope);
+    // Comb polarity and vowel first: the change below copies the filter settings to the voices
+    pushParameterChange([](auto& p, const auto& v)
+    {
+        for (auto* filter : { &p.osc1Filter, &p.osc2Filter })
+        {
+            filter->setCombNegative(v[0] != 0.0f);
+            filter->setFormantVowel(v[1]);
+        }
+    }, filterCombNegative ? 1.0f : 0.0f, filterFormantVowel);
+    
+    pushParameterChange([](auto& p, const auto& v)
+    {
+        for (auto* filter : { &p.osc1Filter, &p.osc2Filter })
+        {
+            filter->setCutoffFrequency(v[0]);
+            filter->setResonance(v[1]);
+            filter->setFilterType(static_cast<SimpleStableFilter::FilterType>(static_cast<int>(v[2])));
+            filter->setFilterSlope(static_cast<SimpleStableFilter::FilterSlope>(static_cast<int>(v[3])));
+        }
+        
+        // Update per-voice filters for all voices
+        p.forEachVoice([](SineWaveVoice& voice) { voice.updatePerVoiceFilters(); });
+    }, filterCutoff, resonanceToQ(filterResonance), static_cast<float>(filterType), static_cast<float>(filterSlope));
+    
     updateFilterRouting();
+}
+
+void SummonerXSerum2AudioProcessor::updateFilterRouting()
+{
+    pushParameterChange([](auto& p, const auto& v)
+    {
+        p.forEachVoice([&p, &v](SineWaveVoice& voice)
+        {
+            voice.setFilterRouting(v[0] != 0.0f, v[1] != 0.0f, &p.osc1Filter, &p.osc2Filter);
+            voice.updatePerVoiceFilters();
+        });
+    }, osc1FilterEnabled ? 1.0f : 0.0f, osc2FilterEnabled ? 1.0f : 0.0f);
+}
+
+bool SummonerXSerum2AudioProcessor::loadTuningScale(const juce::File& sclFile)
+{
+    if (!sclFile.existsAsFile() || !scalaTuning.loadScale(sclFile.loadFileAsString()))
+        return false;
     
-    // Update per-voice filters for all active voices
-    for (int i = 0; i < synthesiser.getNumVoices(); ++i)
+    publishTuning();
+    return true;
+}
+
+bool SummonerXSerum2AudioProcessor::loadTuningKeyboardMapping(const juce::File& kbmFile)
+{
+    if (!kbmFile.existsAsFile() || !scalaTuning.loadKeyboardMapping(kbmFile.loadFileAsString()))
+        return false;
+    
+    publishTuning();
+    return true;
+}
+
+void SummonerXSerum2AudioProcessor::resetTuning()
+{
+    scalaTuning.reset();
+    publishTuning();
+}
+
+// Message thread: renders the current Scala tuning and queues it for the audio thread
+void SummonerXSerum2AudioProcessor::publishTuning()
+{
+    TuningTable table;
+    scalaTuning.fillTable(table);
+    
+    if (!audioThreadActive.load())
     {
-        if (auto* voice = dynamic_cast<SineWaveVoice*>(synthesiser.getVoice(i)))
+        tuning = table;
+        return;
+    }
+    
+    int start1, size1, start2, size2;
+    tuningFifo.prepareToWrite(1, start1, size1, start2, size2);
+    if (size1 + size2 == 0)
+    {
+        jassertfalse; // The audio thread has not picked up the last few tunings
+        return;
+    }
+    
+    pendingTunings[static_cast<size_t>(size1 > 0 ? start1 : start2)] = table;
+    tuningFifo.finishedWrite(1);
+}
+
+// Audio thread: only the newest queued table matters, notes already playing keep their pitch
+void SummonerXSerum2AudioProcessor::applyPendingTuning()
+{
+    const int numReady = tuningFifo.getNumReady();
+    if (numReady == 0)
+        return;
+    
+    int start1, size1, start2, size2;
+    tuningFifo.prepareToRead(numReady, start1, size1, start2, size2);
+    tuning = pendingTunings[static_cast<size_t>(size2 > 0 ? start2 + size2 - 1 : start1 + size1 - 1)];
+    tuningFifo.finishedRead(size1 + size2);
+}
+
+bool SummonerXSerum2AudioProcessor::loadReverbImpulse(const juce::File& file)
+{
+    if (!file.existsAsFile())
+        return false;
+    
+    reverbImpulseFile = file;
+    queueReverbImpulseBuild();
+    return true;
+}
+
+void SummonerXSerum2AudioProcessor::clearReverbImpulse()
+{
+    if (reverbImpulseFile == juce::File())
+        return;
+    
+    reverbImpulseFile = juce::File();
+    queueReverbImpulseBuild();
+}
+
+// Reads, resamples and partitions the impulse response on impulseLoader, then hands the
+// convolver to the reverb. A file that cannot be decoded falls back to the built-in one.
+void SummonerXSerum2AudioProcessor::queueReverbImpulseBuild()
+{
+    const double rate = getSampleRate() > 0.0 ? getSampleRate() : 44100.0;
+    reverbImpulseSampleRate = rate;
+    
+    impulseLoader.addJob([this, file = reverbImpulseFile, rate]
+    {
+        juce::AudioBuffer<float> impulse;
+        double impulseRate = rate;
+        
+        if (file != juce::File())
         {
-            voice->updatePerVoiceFilters();
+            juce::AudioFormatManager formats;
+            formats.registerBasicFormats();
+            if (std::unique_ptr<juce::AudioFormatReader> reader { formats.createReaderFor(file) })
+            {
+                const auto maxSamples = static_cast<juce::int64>(ReverbEffect::maxImpulseSeconds * reader->sampleRate) + 1;
+                const int length = static_cast<int>(juce::jmin(reader->lengthInSamples, maxSamples));
+                impulse.setSize(static_cast<int>(juce::jmin(2u, reader->numChannels)), length);
+                reader->read(&impulse, 0, length, 0, true, impulse.getNumChannels() > 1);
+                impulseRate = reader->sampleRate;
+            }
         }
+        
+        auto prepared = PartitionedConvolver::prepareImpulse(impulse, impulseRate, rate, ReverbEffect::maxImpulseSeconds);
+        if (prepared.getNumSamples() == 0)
+            prepared = PartitionedConvolver::prepareImpulse(ReverbEffect::makeDefaultImpulse(rate), rate, rate, ReverbEffect::maxImpulseSeconds);
+        
+        reverb.setConvolver(std::make_unique<PartitionedConvolver>(prepared));
+    });
+}
+
+// Quarter notes per cycle for each sync division: 32 bars down to 1 bar, then 1/2 to 1/256
+double SummonerXSerum2AudioProcessor::getLfoSyncBeats(int division)
+{
+    static constexpr double barCounts[] = { 32.0, 16.0, 8.0, 4.0, 2.0, 1.0 };
+    static constexpr double noteDivisions[] = { 2.0, 3.0, 4.0, 6.0, 8.0, 12.0, 16.0, 24.0, 32.0, 48.0, 64.0, 96.0, 128.0, 192.0, 256.0 };
+    
+    division = juce::jlimit(0, numLfoSyncDivisions - 1, division);
+    if (division < 6)
+        return 4.0 * barCounts[division];
+    return 4.0 / noteDivisions[division - 6];
+}
+
+void SummonerXSerum2AudioProcessor::updateLfoParameters()
+{
+    pushParameterChange([](auto& p, const auto& v)
+    {
+        p.lfo.setRateHz(v[0]);
+        p.lfo.setMode(static_cast<LfoEngine::Mode>(static_cast<int>(v[1])));
+        p.lfo.setSyncBeats(v[2]);
+        p.lfo.setControlInterval(static_cast<int>(v[3]));
+    }, lfoRate, static_cast<float>(lfoMode), static_cast<float>(getLfoSyncBeats(lfoSyncDivision)), static_cast<float>(lfoControlInterval));
+}
+
+void SummonerXSerum2AudioProcessor::setLfoShape(const std::vector<float>& points)
+{
+    lfoShapePoints = points;
+    publishLfoShape(points.size() >= 2 ? LfoEngine::compileTable(points) : LfoEngine::makeSineTable());
+}
+
+// Message thread: hands a compiled shape to the audio thread the same way as a tuning
+void SummonerXSerum2AudioProcessor::publishLfoShape(const LfoEngine::Table& table)
+{
+    if (!audioThreadActive.load())
+    {
+        lfo.setTable(table);
+        return;
+    }
+    
+    int start1, size1, start2, size2;
+    lfoShapeFifo.prepareToWrite(1, start1, size1, start2, size2);
+    if (size1 + size2 == 0)
+    {
+        jassertfalse; // The audio thread has not picked up the last few shapes
+        return;
     }
+    
+    pendingLfoShapes[static_cast<size_t>(size1 > 0 ? start1 : start2)] = table;
+    lfoShapeFifo.finishedWrite(1);
 }
 
-void SummonerXSerum2AudioProcessor::updateFilterRouting()
+// Audio thread: only the newest queued shape matters
+void SummonerXSerum2AudioProcessor::applyPendingLfoShape()
+{
+    const int numReady = lfoShapeFifo.getNumReady();
+    if (numReady == 0)
+        return;
+    
+    int start1, size1, start2, size2;
+    lfoShapeFifo.prepareToRead(numReady, start1, size1, start2, size2);
+    lfo.setTable(pendingLfoShapes[static_cast<size_t>(size2 > 0 ? start2 + size2 - 1 : start1 + size1 - 1)]);
+    lfoShapeFifo.finishedRead(size1 + size2);
+}
+
+bool SummonerXSerum2AudioProcessor::setLfoRoute(int slot, const std::string& parameterName, float depth)
 {
-    for (int i = 0; i < synthesiser.getNumVoices(); ++i)
+    if (slot < 0 || slot >= maxLfoRoutes)
+        return false;
+    
+    auto it = parameterMap.find(parameterName);
+    if (it == parameterMap.end() || it->second.type != ParameterInfo::FLOAT)
+        return false;
+    
+    const auto target = std::find(lfoTargets.begin(), lfoTargets.end(), &it->second);
+    if (target == lfoTargets.end())
+        return false;
+    
+    // One route per parameter, or two routes would fight over it
+    for (int i = 0; i < maxLfoRoutes; ++i)
+        if (i != slot && lfoRouteSettings[static_cast<size_t>(i)].parameter == parameterName)
+            return false;
+    
+    auto& setting = lfoRouteSettings[static_cast<size_t>(slot)];
+    if (setting.parameter != parameterName)
     {
-        if (auto* voice = dynamic_cast<SineWaveVoice*>(synthesiser.getVoice(i)))
+        clearLfoRoute(slot);
+        setting.parameter = parameterName;
+    }
+    setting.base = it->second.getter();
+    setting.depth = juce::jlimit(-1.0f, 1.0f, depth);
+    
+    pushParameterChange([](auto& p, const auto& v)
+    {
+        auto& route = p.lfoRoutes[static_cast<size_t>(v[0])];
+        route.target = p.lfoTargets[static_cast<size_t>(v[1])];
+        route.base = v[2];
+        route.depth = v[3];
+        p.numActiveLfoRoutes = static_cast<int>(std::count_if(p.lfoRoutes.begin(), p.lfoRoutes.end(),
+                                                              [](const auto& r) { return r.target != nullptr; }));
+    }, static_cast<float>(slot), static_cast<float>(target - lfoTargets.begin()), setting.base, setting.depth);
+    return true;
+}
+
+void SummonerXSerum2AudioProcessor::clearLfoRoute(int slot)
+{
+    if (slot < 0 || slot >= maxLfoRoutes)
+        return;
+    
+    auto& setting = lfoRouteSettings[static_cast<size_t>(slot)];
+    if (setting.parameter.empty())
+        return;
+    
+    // The engine goes back to the parameter's own value, which the LFO never changed
+    setting = {};
+    pushParameterChange([](auto& p, const auto& v)
+    {
+        auto& route = p.lfoRoutes[static_cast<size_t>(v[0])];
+        if (route.target != nullptr)
+            route.target->modulate(route.base);
+        
+        route.target = nullptr;
+        p.numActiveLfoRoutes = static_cast<int>(std::count_if(p.lfoRoutes.begin(), p.lfoRoutes.end(),
+                                                              [](const auto& r) { return r.target != nullptr; }));
+    }, static_cast<float>(slot));
+}
+
+// Message thread: a setter that changed a routed parameter moves the centre of its swing
+void SummonerXSerum2AudioProcessor::updateLfoRouteBases()
+{
+    for (size_t slot = 0; slot < lfoRouteSettings.size(); ++slot)
+    {
+        auto& setting = lfoRouteSettings[slot];
+        if (setting.parameter.empty())
+            continue;
+        
+        const float base = parameterMap[setting.parameter].getter();
+        if (base == setting.base)
+            continue;
+        
+        setting.base = base;
+        queueParameterChange([](auto& p, const auto& v) { p.lfoRoutes[static_cast<size_t>(v[0])].base = v[1]; },
+                             { static_cast<float>(slot), base, 0.0f, 0.0f });
+    }
+}
+
+std::string SummonerXSerum2AudioProcessor::getLfoRouteParameter(int slot) const
+{
+    if (slot < 0 || slot >= maxLfoRoutes)
+        return {};
+    return lfoRouteSettings[static_cast<size_t>(slot)].parameter;
+}
+
+float SummonerXSerum2AudioProcessor::getLfoRouteDepth(int slot) const
+{
+    if (slot < 0 || slot >= maxLfoRoutes)
+        return 0.0f;
+    return lfoRouteSettings[static_cast<size_t>(slot)].depth;
+}
+
+// Audio thread: one LFO evaluation per control segment, applied to every route. Only the
+// engines move; the processor keeps each parameter's own value.
+void SummonerXSerum2AudioProcessor::applyLfoModulation(const juce::MidiBuffer& midiMessages, int startSample, int numSamples)
+{
+    if (lfo.getMode() == LfoEngine::RETRIGGER)
+    {
+        for (const auto metadata : midiMessages)
         {
-            voice->setFilterRouting(osc1FilterEnabled, osc2FilterEnabled, &osc1Filter, &osc2Filter);
-            voice->updatePerVoiceFilters();
+            if (metadata.samplePosition >= startSample && metadata.samplePosition < startSample + numSamples
+                && metadata.getMessage().isNoteOn())
+            {
+                lfo.retrigger();
+                break;
+            }
         }
     }
+    
+    const float value = lfo.advance(numSamples, hostBpm);
+    lfoDisplayValue.store(value);
+    
+    if (numActiveLfoRoutes == 0)
+        return;
+    
+    for (const auto& route : lfoRoutes)
+    {
+        if (route.target == nullptr)
+            continue;
+        
+        const auto& target = *route.target;
+        const float range = target.maxValue - target.minValue;
+        target.modulate(juce::jlimit(target.minValue, target.maxValue, route.base + route.depth * value * range));
+    }
+}
+
+// Called from the message thread. Every setter ends here, so this is also where LFO
+// routes pick up a new value of their parameter: straight away for a single change,
+// once at the end for a ParameterBatch.
+void SummonerXSerum2AudioProcessor::pushParameterChange(ParameterChangeQueue<SummonerXSerum2AudioProcessor>::ApplyFunction apply,
+                                                        float value1, float value2, float value3, float value4)
+{
+    queueParameterChange(apply, { value1, value2, value3, value4 });
+    if (parameterBatchDepth == 0)
+        updateLfoRouteBases();
+}
+
+// While the processor is not playing there is no audio thread to race with, so the
+// change is applied straight away. While it plays, the change always goes through the
+// queue, which holds on to it if it is full.
+void SummonerXSerum2AudioProcessor::queueParameterChange(ParameterChangeQueue<SummonerXSerum2AudioProcessor>::ApplyFunction apply,
+                                                         const ParameterValues& values)
+{
+    if (audioThreadActive.load())
+        parameterChanges.push(apply, values);
+    else
+        apply(*this, values);
+}
+
+void SummonerXSerum2AudioProcessor::updateAllVoiceParameters()
+{
+    updateEnvelopeParameters();
+    updateOsc1Type();
+    updateOsc1PulseWidth();
+    updateOsc1Octave();
+    updateOsc1Semitone();
+    updateOsc1FineTune();
+    updateOsc1RandomPhase();
+    updateOsc1VoiceCount();
+    updateDetune();
+    updateStereoWidth();
+    updatePan();
+    updatePhase();
+    updateOsc1Volume();
+    updateOsc2Parameters();
+    updateOsc2PulseWidth();
+    updateOsc2EnvelopeParameters();
+    updateFilterParameters();
 }
 
 bool SummonerXSerum2AudioProcessor::hasEditor() const
@@ -579,8 +1003,27 @@ juce::AudioProcessorEditor* SummonerXSerum2AudioProcessor::createEditor()
     return new SummonerXSerum2AudioProcessorEditor(*this);
 }
 
+// Host state is the preset ValueTree in JUCE's binary ValueTree encoding, behind an
+// 8-byte header (magic + format version). It is much smaller and quicker to read and
+// write than the XML used for .sxs2 files, which matters with many instances.
 void SummonerXSerum2AudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
+    juce::ValueTree state = createPresetData();
+    state.removeProperty("creationTime", nullptr); // Keep identical settings byte-identical
+    
+    // Microtuning belongs to the project rather than to presets
+    if (scalaTuning.getScaleText().isNotEmpty() || scalaTuning.getKeyboardMappingText().isNotEmpty())
+    {
+        juce::ValueTree tuningState("TUNING");
+        tuningState.setProperty("scale", scalaTuning.getScaleText(), nullptr);
+        tuningState.setProperty("keyboardMapping", scalaTuning.getKeyboardMappingText(), nullptr);
+        state.addChild(tuningState, -1, nullptr);
+    }
+    
+    juce::MemoryOutputStream stream(destData, false);
+    stream.writeInt(stateMagic);
+    stream.writeInt(stateVersion);
+    state.writeToStream(stream);
 }
 
 void SummonerXSerum2AudioProcessor::setResponses(const std::vector<std::map<std::string, std::string>>& newResponses)
@@ -625,52 +1068,131 @@ void SummonerXSerum2AudioProcessor::previousResponse()
 
 void SummonerXSerum2AudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
+    if (data == nullptr || sizeInBytes <= 0)
+        return;
+    
+    juce::ValueTree state;
+    juce::MemoryInputStream stream(data, static_cast<size_t>(sizeInBytes), false);
+    
+    if (sizeInBytes >= 8 && stream.readInt() == stateMagic)
+    {
+        // Every version so far stores the PRESET tree; newer versions only add properties,
+        // which applyPresetData ignores when it does not know them
+        const int version = stream.readInt();
+        if (version >= 1)
+            state = juce::ValueTree::readFromStream(stream);
+    }
+    else if (auto xml = getXmlFromBinary(data, sizeInBytes))
+    {
+        // States stored with copyXmlToBinary
+        state = juce::ValueTree::fromXml(*xml);
+    }
+    else if (auto xml = juce::parseXML(juce::String::fromUTF8(static_cast<const char*>(data), sizeInBytes)))
+    {
+        // Raw .sxs2 preset XML
+        state = juce::ValueTree::fromXml(*xml);
+    }
+    
+    auto params = state.getChildWithName("PARAMETERS");
+    if (!state.hasType("PRESET") || !params.isValid())
+        return;
+    
+    // Presets leave the master volume alone, but a restored project should bring it back.
+    // Routes are released first, so a route on the master volume starts from this value.
+    for (int slot = 0; slot < maxLfoRoutes; ++slot)
+        clearLfoRoute(slot);
+    if (params.hasProperty("masterVolume"))
+        setMasterVolume(params.getProperty("masterVolume"));
+    
+    if (!applyPresetData(state))
+        return;
+    
+    // Projects saved without a TUNING child used the default tuning
+    auto tuningState = state.getChildWithName("TUNING");
+    scalaTuning.reset();
+    if (tuningState.isValid())
+    {
+        scalaTuning.loadScale(tuningState.getProperty("scale").toString());
+        scalaTuning.loadKeyboardMapping(tuningState.getProperty("keyboardMapping").toString());
+    }
+    publishTuning();
+    
+    currentPresetName = state.getProperty("name", currentPresetName);
+    refreshPresetList();
+    updatePresetDisplay();
 }
 
 void SummonerXSerum2AudioProcessor::initializeParameterMap()
 {
+    // Continuous parameters also give the LFO their own value and an engine-only change
     // Main Oscillator 1 Parameters (9)
-    parameterMap["masterVolume"] = {ParameterInfo::FLOAT, 0.0f, 5.0f, [this](float v) { setMasterVolume(v); }};
-    parameterMap["osc1Detune"] = {ParameterInfo::FLOAT, 0.0f, 100.0f, [this](float v) { setOsc1Detune(v); }};
-    parameterMap["osc1StereoWidth"] = {ParameterInfo::FLOAT, 0.0f, 1.0f, [this](float v) { setOsc1StereoWidth(v); }};
-    parameterMap["osc1Pan"] = {ParameterInfo::FLOAT, -1.0f, 1.0f, [this](float v) { setOsc1Pan(v); }};
+    parameterMap["masterVolume"] = {ParameterInfo::FLOAT, 0.0f, 5.0f, [this](float v) { setMasterVolume(v); },
+        [this] { return getMasterVolume(); }, [this](float v) { outputGain = v; }};
+    parameterMap["osc1Detune"] = {ParameterInfo::FLOAT, 0.0f, 100.0f, [this](float v) { setOsc1Detune(v); },
+        [this] { return getOsc1Detune(); }, [this](float v) { forEachVoice([v](SineWaveVoice& voice) { voice.setDetune(v); }); }};
+    parameterMap["osc1StereoWidth"] = {ParameterInfo::FLOAT, 0.0f, 1.0f, [this](float v) { setOsc1StereoWidth(v); },
+        [this] { return getOsc1StereoWidth(); }, [this](float v) { forEachVoice([v](SineWaveVoice& voice) { voice.setStereoWidth(v); }); }};
+    parameterMap["osc1Pan"] = {ParameterInfo::FLOAT, -1.0f, 1.0f, [this](float v) { setOsc1Pan(v); },
+        [this] { return getOsc1Pan(); }, [this](float v) { forEachVoice([v](SineWaveVoice& voice) { voice.setPan(v); }); }};
     parameterMap["osc1Phase"] = {ParameterInfo::FLOAT, 0.0f, 360.0f, [this](float v) { setOsc1Phase(v); }};
-    parameterMap["osc1Attack"] = {ParameterInfo::FLOAT, 0.0f, 10.0f, [this](float v) { setOsc1Attack(v); }};
-    parameterMap["osc1Decay"] = {ParameterInfo::FLOAT, 0.0f, 10.0f, [this](float v) { setOsc1Decay(v); }};
-    parameterMap["osc1Sustain"] = {ParameterInfo::FLOAT, 0.0f, 1.0f, [this](float v) { setOsc1Sustain(v); }};
-    parameterMap["osc1Release"] = {ParameterInfo::FLOAT, 0.0f, 10.0f, [this](float v) { setOsc1Release(v); }};
+    parameterMap["osc1Attack"] = {ParameterInfo::FLOAT, 0.0f, 10.0f, [this](float v) { setOsc1Attack(v); },
+        [this] { return getOsc1Attack(); }, [this](float v) { forEachVoice([v](SineWaveVoice& voice) { voice.setEnvelopeStage(&ExponentialEnvelope::Parameters::attack, v); }); }};
+    parameterMap["osc1Decay"] = {ParameterInfo::FLOAT, 0.0f, 10.0f, [this](float v) { setOsc1Decay(v); },
+        [this] { return getOsc1Decay(); }, [this](float v) { forEachVoice([v](SineWaveVoice& voice) { voice.setEnvelopeStage(&ExponentialEnvelope::Parameters::decay, v); }); }};
+    parameterMap["osc1Sustain"] = {ParameterInfo::FLOAT, 0.0f, 1.0f, [this](float v) { setOsc1Sustain(v); },
+        [this] { return getOsc1Sustain(); }, [this](float v) { forEachVoice([v](SineWaveVoice& voice) { voice.setEnvelopeStage(&ExponentialEnvelope::Parameters::sustain, v); }); }};
+    parameterMap["osc1Release"] = {ParameterInfo::FLOAT, 0.0f, 10.0f, [this](float v) { setOsc1Release(v); },
+        [this] { return getOsc1Release(); }, [this](float v) { forEachVoice([v](SineWaveVoice& voice) { voice.setEnvelopeStage(&ExponentialEnvelope::Parameters::release, v); }); }};
+
+    // Voice Allocation Parameters (2)
+    parameterMap["polyphony"] = {ParameterInfo::INT, 1.0f, 64.0f, [this](float v) { setPolyphony((int)v); }};
+    parameterMap["voiceStealMode"] = {ParameterInfo::INT, 0.0f, 2.0f, [this](float v) { setVoiceStealMode((int)v); }};
 
     // Oscillator 1 Parameters (8)
     parameterMap["osc1Type"] = {ParameterInfo::INT, 0.0f, 10.0f, [this](float v) { setOsc1Type((int)v); }};
-    parameterMap["osc1PulseWidth"] = {ParameterInfo::FLOAT, 0.0f, 1.0f, [this](float v) { setOsc1PulseWidth(v); }};
+    parameterMap["osc1PulseWidth"] = {ParameterInfo::FLOAT, 0.0f, 1.0f, [this](float v) { setOsc1PulseWidth(v); },
+        [this] { return getOsc1PulseWidth(); }, [this](float v) { forEachVoice([v](SineWaveVoice& voice) { voice.setOsc1PulseWidth(v); }); }};
     parameterMap["osc1Octave"] = {ParameterInfo::INT, -4.0f, 4.0f, [this](float v) { setOsc1Octave((int)v); }};
     parameterMap["osc1Semitone"] = {ParameterInfo::INT, -12.0f, 12.0f, [this](float v) { setOsc1Semitone((int)v); }};
     parameterMap["osc1FineTune"] = {ParameterInfo::INT, -100.0f, 100.0f, [this](float v) { setOsc1FineTune((int)v); }};
     parameterMap["osc1RandomPhase"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setOsc1RandomPhase(v > 0.5f); }};
     parameterMap["osc1VoiceCount"] = {ParameterInfo::INT, 1.0f, 16.0f, [this](float v) { setOsc1VoiceCount((int)v); }};
-    parameterMap["osc1Volume"] = {ParameterInfo::FLOAT, 0.0f, 1.0f, [this](float v) { setOsc1Volume(v); }};
+    parameterMap["osc1Volume"] = {ParameterInfo::FLOAT, 0.0f, 1.0f, [this](float v) { setOsc1Volume(v); },
+        [this] { return getOsc1Volume(); }, [this](float v) { forEachVoice([v](SineWaveVoice& voice) { voice.setOsc1Volume(v); }); }};
 
-    // Oscillator 2 Parameters (16)
+    // Oscillator 2 Parameters (17)
     parameterMap["osc2Enabled"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setOsc2Enabled(v > 0.5f); }};
     parameterMap["osc2Type"] = {ParameterInfo::INT, 0.0f, 10.0f, [this](float v) { setOsc2Type((int)v); }};
-    parameterMap["osc2Volume"] = {ParameterInfo::FLOAT, 0.0f, 1.0f, [this](float v) { setOsc2Volume(v); }};
-    parameterMap["osc2Detune"] = {ParameterInfo::FLOAT, 0.0f, 100.0f, [this](float v) { setOsc2Detune(v); }};
-    parameterMap["osc2Stereo"] = {ParameterInfo::FLOAT, 0.0f, 1.0f, [this](float v) { setOsc2Stereo(v); }};
-    parameterMap["osc2Pan"] = {ParameterInfo::FLOAT, -1.0f, 1.0f, [this](float v) { setOsc2Pan(v); }};
+    parameterMap["osc2Volume"] = {ParameterInfo::FLOAT, 0.0f, 1.0f, [this](float v) { setOsc2Volume(v); },
+        [this] { return getOsc2Volume(); }, [this](float v) { forEachVoice([v](SineWaveVoice& voice) { voice.setOsc2Volume(v); }); }};
+    parameterMap["osc2Detune"] = {ParameterInfo::FLOAT, 0.0f, 100.0f, [this](float v) { setOsc2Detune(v); },
+        [this] { return getOsc2Detune(); }, [this](float v) { forEachVoice([v](SineWaveVoice& voice) { voice.setOsc2Detune(v); }); }};
+    parameterMap["osc2Stereo"] = {ParameterInfo::FLOAT, 0.0f, 1.0f, [this](float v) { setOsc2Stereo(v); },
+        [this] { return getOsc2Stereo(); }, [this](float v) { forEachVoice([v](SineWaveVoice& voice) { voice.setOsc2Stereo(v); }); }};
+    parameterMap["osc2Pan"] = {ParameterInfo::FLOAT, -1.0f, 1.0f, [this](float v) { setOsc2Pan(v); },
+        [this] { return getOsc2Pan(); }, [this](float v) { forEachVoice([v](SineWaveVoice& voice) { voice.setOsc2Pan(v); }); }};
     parameterMap["osc2Octave"] = {ParameterInfo::INT, -4.0f, 4.0f, [this](float v) { setOsc2Octave((int)v); }};
     parameterMap["osc2Semitone"] = {ParameterInfo::INT, -12.0f, 12.0f, [this](float v) { setOsc2Semitone((int)v); }};
     parameterMap["osc2FineTune"] = {ParameterInfo::INT, -100.0f, 100.0f, [this](float v) { setOsc2FineTune((int)v); }};
     parameterMap["osc2RandomPhase"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setOsc2RandomPhase(v > 0.5f); }};
     parameterMap["osc2Phase"] = {ParameterInfo::FLOAT, 0.0f, 360.0f, [this](float v) { setOsc2Phase(v); }};
-    parameterMap["osc2Attack"] = {ParameterInfo::FLOAT, 0.0f, 10.0f, [this](float v) { setOsc2Attack(v); }};
-    parameterMap["osc2Decay"] = {ParameterInfo::FLOAT, 0.0f, 10.0f, [this](float v) { setOsc2Decay(v); }};
-    parameterMap["osc2Sustain"] = {ParameterInfo::FLOAT, 0.0f, 1.0f, [this](float v) { setOsc2Sustain(v); }};
-    parameterMap["osc2Release"] = {ParameterInfo::FLOAT, 0.0f, 10.0f, [this](float v) { setOsc2Release(v); }};
+    parameterMap["osc2PulseWidth"] = {ParameterInfo::FLOAT, 0.0f, 1.0f, [this](float v) { setOsc2PulseWidth(v); },
+        [this] { return getOsc2PulseWidth(); }, [this](float v) { forEachVoice([v](SineWaveVoice& voice) { voice.setOsc2PulseWidth(v); }); }};
+    parameterMap["osc2Attack"] = {ParameterInfo::FLOAT, 0.0f, 10.0f, [this](float v) { setOsc2Attack(v); },
+        [this] { return getOsc2Attack(); }, [this](float v) { forEachVoice([v](SineWaveVoice& voice) { voice.setOsc2EnvelopeStage(&ExponentialEnvelope::Parameters::attack, v); }); }};
+    parameterMap["osc2Decay"] = {ParameterInfo::FLOAT, 0.0f, 10.0f, [this](float v) { setOsc2Decay(v); },
+        [this] { return getOsc2Decay(); }, [this](float v) { forEachVoice([v](SineWaveVoice& voice) { voice.setOsc2EnvelopeStage(&ExponentialEnvelope::Parameters::decay, v); }); }};
+    parameterMap["osc2Sustain"] = {ParameterInfo::FLOAT, 0.0f, 1.0f, [this](float v) { setOsc2Sustain(v); },
+        [this] { return getOsc2Sustain(); }, [this](float v) { forEachVoice([v](SineWaveVoice& voice) { voice.setOsc2EnvelopeStage(&ExponentialEnvelope::Parameters::sustain, v); }); }};
+    parameterMap["osc2Release"] = {ParameterInfo::FLOAT, 0.0f, 10.0f, [this](float v) { setOsc2Release(v); },
+        [this] { return getOsc2Release(); }, [this](float v) { forEachVoice([v](SineWaveVoice& voice) { voice.setOsc2EnvelopeStage(&ExponentialEnvelope::Parameters::release, v); }); }};
     parameterMap["osc2VoiceCount"] = {ParameterInfo::INT, 1.0f, 16.0f, [this](float v) { setOsc2VoiceCount((int)v); }};
 
-    // Filter Parameters (12)
-    parameterMap["filterCutoff"] = {ParameterInfo::FLOAT, 20.0f, 20000.0f, [this](float v) { setFilterCutoff(v); }};
-    parameterMap["filterResonance"] = {ParameterInfo::FLOAT, 0.0f, 1.0f, [this](float v) { setFilterResonance(v); }};
+    // Filter Parameters (14)
+    parameterMap["filterCutoff"] = {ParameterInfo::FLOAT, 20.0f, 20000.0f, [this](float v) { setFilterCutoff(v); },
+        [this] { return getFilterCutoff(); }, [this](float v) { modulateFilters([v](SimpleStableFilter& filter) { filter.setCutoffFrequency(v); }); }};
+    parameterMap["filterResonance"] = {ParameterInfo::FLOAT, 0.0f, 1.0f, [this](float v) { setFilterResonance(v); },
+        [this] { return getFilterResonance(); }, [this](float v) { modulateFilters([q = resonanceToQ(v)](SimpleStableFilter& filter) { filter.setResonance(q); }); }};
     parameterMap["osc1FilterEnabled"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setOsc1FilterEnabled(v > 0.5f); }};
     parameterMap["osc2FilterEnabled"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setOsc2FilterEnabled(v > 0.5f); }};
     parameterMap["filterLPEnabled"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setFilterLPEnabled(v > 0.5f); }};
@@ -678,97 +1200,179 @@ void SummonerXSerum2AudioProcessor::initializeParameterMap()
     parameterMap["filterBPEnabled"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setFilterBPEnabled(v > 0.5f); }};
     parameterMap["filterNotchEnabled"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setFilterNotchEnabled(v > 0.5f); }};
     parameterMap["filterCombEnabled"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setFilterCombEnabled(v > 0.5f); }};
+    parameterMap["filterCombNegative"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setFilterCombNegative(v > 0.5f); }};
     parameterMap["filterFormantEnabled"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setFilterFormantEnabled(v > 0.5f); }};
+    parameterMap["filterFormantVowel"] = {ParameterInfo::FLOAT, 0.0f, 4.0f, [this](float v) { setFilterFormantVowel(v); },
+        [this] { return getFilterFormantVowel(); }, [this](float v) { modulateFilters([v](SimpleStableFilter& filter) { filter.setFormantVowel(v); }); }};
     parameterMap["filter12dBEnabled"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setFilter12dBEnabled(v > 0.5f); }};
     parameterMap["filter24dBEnabled"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setFilter24dBEnabled(v > 0.5f); }};
 
-    // Chorus Effect Parameters (8)
+    // Chorus Effect Parameters (9)
     parameterMap["chorusEnabled"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setChorusEnabled(v > 0.5f); }};
-    parameterMap["chorusRate"] = {ParameterInfo::FLOAT, 0.1f, 10.0f, [this](float v) { setChorusRate(v); }};
-    parameterMap["chorusDelay1"] = {ParameterInfo::FLOAT, 1.0f, 50.0f, [this](float v) { setChorusDelay1(v); }};
-    parameterMap["chorusDelay2"] = {ParameterInfo::FLOAT, 1.0f, 50.0f, [this](float v) { setChorusDelay2(v); }};
-    parameterMap["chorusDepth"] = {ParameterInfo::FLOAT, 0.0f, 20.0f, [this](float v) { setChorusDepth(v); }};
-    parameterMap["chorusFeedback"] = {ParameterInfo::FLOAT, 0.0f, 0.95f, [this](float v) { setChorusFeedback(v); }};
-    parameterMap["chorusLPF"] = {ParameterInfo::FLOAT, 200.0f, 20000.0f, [this](float v) { setChorusLPF(v); }};
-    parameterMap["chorusMix"] = {ParameterInfo::FLOAT, 0.0f, 1.0f, [this](float v) { setChorusMix(v); }};
+    parameterMap["chorusRate"] = {ParameterInfo::FLOAT, 0.1f, 10.0f, [this](float v) { setChorusRate(v); },
+        [this] { return getChorusRate(); }, [this](float v) { chorus.setRate(v); }};
+    parameterMap["chorusDelay1"] = {ParameterInfo::FLOAT, 1.0f, 50.0f, [this](float v) { setChorusDelay1(v); },
+        [this] { return getChorusDelay1(); }, [this](float v) { chorus.setDelay1(v); }};
+    parameterMap["chorusDelay2"] = {ParameterInfo::FLOAT, 1.0f, 50.0f, [this](float v) { setChorusDelay2(v); },
+        [this] { return getChorusDelay2(); }, [this](float v) { chorus.setDelay2(v); }};
+    parameterMap["chorusDepth"] = {ParameterInfo::FLOAT, 0.0f, 20.0f, [this](float v) { setChorusDepth(v); },
+        [this] { return getChorusDepth(); }, [this](float v) { chorus.setDepth(v); }};
+    parameterMap["chorusFeedback"] = {ParameterInfo::FLOAT, 0.0f, 0.95f, [this](float v) { setChorusFeedback(v); },
+        [this] { return getChorusFeedback(); }, [this](float v) { chorus.setFeedback(v); }};
+    parameterMap["chorusLPF"] = {ParameterInfo::FLOAT, 200.0f, 20000.0f, [this](float v) { setChorusLPF(v); },
+        [this] { return getChorusLPF(); }, [this](float v) { chorus.setLPFCutoff(v); }};
+    parameterMap["chorusMix"] = {ParameterInfo::FLOAT, 0.0f, 1.0f, [this](float v) { setChorusMix(v); },
+        [this] { return getChorusMix(); }, [this](float v) { chorus.setMix(v); }};
+    parameterMap["chorusVoices"] = {ParameterInfo::INT, 3.0f, 6.0f, [this](float v) { setChorusVoices((int)v); }};
 
     // Flanger Effect Parameters (6)
     parameterMap["flangerEnabled"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setFlangerEnabled(v > 0.5f); }};
-    parameterMap["flangerRate"] = {ParameterInfo::FLOAT, 0.1f, 10.0f, [this](float v) { setFlangerRate(v); }};
-    parameterMap["flangerDepth"] = {ParameterInfo::FLOAT, 0.1f, 10.0f, [this](float v) { setFlangerDepth(v); }};
-    parameterMap["flangerFeedback"] = {ParameterInfo::FLOAT, 0.0f, 100.0f, [this](float v) { setFlangerFeedback(v); }};
-    parameterMap["flangerMix"] = {ParameterInfo::FLOAT, 0.0f, 100.0f, [this](float v) { setFlangerMix(v); }};
-    parameterMap["flangerPhase"] = {ParameterInfo::FLOAT, 0.0f, 360.0f, [this](float v) { setFlangerPhase(v); }};
+    parameterMap["flangerRate"] = {ParameterInfo::FLOAT, 0.1f, 10.0f, [this](float v) { setFlangerRate(v); },
+        [this] { return getFlangerRate(); }, [this](float v) { flanger.setRate(v); }};
+    parameterMap["flangerDepth"] = {ParameterInfo::FLOAT, 0.1f, 10.0f, [this](float v) { setFlangerDepth(v); },
+        [this] { return getFlangerDepth(); }, [this](float v) { flanger.setDepth(v); }};
+    parameterMap["flangerFeedback"] = {ParameterInfo::FLOAT, 0.0f, 100.0f, [this](float v) { setFlangerFeedback(v); },
+        [this] { return getFlangerFeedback(); }, [this](float v) { flanger.setFeedback(v); }};
+    parameterMap["flangerMix"] = {ParameterInfo::FLOAT, 0.0f, 100.0f, [this](float v) { setFlangerMix(v); },
+        [this] { return getFlangerMix(); }, [this](float v) { flanger.setMix(v); }};
+    parameterMap["flangerPhase"] = {ParameterInfo::FLOAT, 0.0f, 360.0f, [this](float v) { setFlangerPhase(v); },
+        [this] { return getFlangerPhase(); }, [this](float v) { flanger.setPhase(v); }};
 
     // Phaser Effect Parameters (9)
     parameterMap["phaserEnabled"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setPhaserEnabled(v > 0.5f); }};
-    parameterMap["phaserRate"] = {ParameterInfo::FLOAT, 0.1f, 10.0f, [this](float v) { setPhaserRate(v); }};
-    parameterMap["phaserDepth1"] = {ParameterInfo::FLOAT, 0.0f, 100.0f, [this](float v) { setPhaserDepth1(v); }};
-    parameterMap["phaserDepth2"] = {ParameterInfo::FLOAT, 0.0f, 100.0f, [this](float v) { setPhaserDepth2(v); }};
-    parameterMap["phaserFeedback"] = {ParameterInfo::FLOAT, 0.0f, 100.0f, [this](float v) { setPhaserFeedback(v); }};
-    parameterMap["phaserMix"] = {ParameterInfo::FLOAT, 0.0f, 100.0f, [this](float v) { setPhaserMix(v); }};
-    parameterMap["phaserPhase"] = {ParameterInfo::FLOAT, 0.0f, 360.0f, [this](float v) { setPhaserPhase(v); }};
-    parameterMap["phaserFrequency"] = {ParameterInfo::FLOAT, 20.0f, 2000.0f, [this](float v) { setPhaserFrequency(v); }};
+    parameterMap["phaserRate"] = {ParameterInfo::FLOAT, 0.1f, 10.0f, [this](float v) { setPhaserRate(v); },
+        [this] { return getPhaserRate(); }, [this](float v) { phaser.setRate(v); }};
+    parameterMap["phaserDepth1"] = {ParameterInfo::FLOAT, 0.0f, 100.0f, [this](float v) { setPhaserDepth1(v); },
+        [this] { return getPhaserDepth1(); }, [this](float v) { phaser.setDepth1(v); }};
+    parameterMap["phaserDepth2"] = {ParameterInfo::FLOAT, 0.0f, 100.0f, [this](float v) { setPhaserDepth2(v); },
+        [this] { return getPhaserDepth2(); }, [this](float v) { phaser.setDepth2(v); }};
+    parameterMap["phaserFeedback"] = {ParameterInfo::FLOAT, 0.0f, 100.0f, [this](float v) { setPhaserFeedback(v); },
+        [this] { return getPhaserFeedback(); }, [this](float v) { phaser.setFeedback(v); }};
+    parameterMap["phaserMix"] = {ParameterInfo::FLOAT, 0.0f, 100.0f, [this](float v) { setPhaserMix(v); },
+        [this] { return getPhaserMix(); }, [this](float v) { phaser.setMix(v); }};
+    parameterMap["phaserPhase"] = {ParameterInfo::FLOAT, 0.0f, 360.0f, [this](float v) { setPhaserPhase(v); },
+        [this] { return getPhaserPhase(); }, [this](float v) { phaser.setPhase(v); }};
+    parameterMap["phaserFrequency"] = {ParameterInfo::FLOAT, 20.0f, 2000.0f, [this](float v) { setPhaserFrequency(v); },
+        [this] { return getPhaserFrequency(); }, [this](float v) { phaser.setFrequency(v); }};
     parameterMap["phaserPoles"] = {ParameterInfo::INT, 1.0f, 16.0f, [this](float v) { setPhaserPoles((int)v); }};
 
     // Compressor Effect Parameters (8)
     parameterMap["compressorEnabled"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setCompressorEnabled(v > 0.5f); }};
-    parameterMap["compressorThreshold"] = {ParameterInfo::FLOAT, -60.0f, 0.0f, [this](float v) { setCompressorThreshold(v); }};
-    parameterMap["compressorRatio"] = {ParameterInfo::FLOAT, 1.0f, 20.0f, [this](float v) { setCompressorRatio(v); }};
-    parameterMap["compressorAttack"] = {ParameterInfo::FLOAT, 0.1f, 100.0f, [this](float v) { setCompressorAttack(v); }};
-    parameterMap["compressorRelease"] = {ParameterInfo::FLOAT, 10.0f, 1000.0f, [this](float v) { setCompressorRelease(v); }};
-    parameterMap["compressorGain"] = {ParameterInfo::FLOAT, 0.0f, 30.0f, [this](float v) { setCompressorGain(v); }};
-    parameterMap["compressorMix"] = {ParameterInfo::FLOAT, 0.0f, 1.0f, [this](float v) { setCompressorMix(v); }};
+    parameterMap["compressorThreshold"] = {ParameterInfo::FLOAT, -60.0f, 0.0f, [this](float v) { setCompressorThreshold(v); },
+        [this] { return getCompressorThreshold(); }, [this](float v) { compressor.setThreshold(v); }};
+    parameterMap["compressorRatio"] = {ParameterInfo::FLOAT, 1.0f, 20.0f, [this](float v) { setCompressorRatio(v); },
+        [this] { return getCompressorRatio(); }, [this](float v) { compressor.setRatio(v); }};
+    parameterMap["compressorAttack"] = {ParameterInfo::FLOAT, 0.1f, 100.0f, [this](float v) { setCompressorAttack(v); },
+        [this] { return getCompressorAttack(); }, [this](float v) { compressor.setAttack(v); }};
+    parameterMap["compressorRelease"] = {ParameterInfo::FLOAT, 10.0f, 1000.0f, [this](float v) { setCompressorRelease(v); },
+        [this] { return getCompressorRelease(); }, [this](float v) { compressor.setRelease(v); }};
+    parameterMap["compressorGain"] = {ParameterInfo::FLOAT, 0.0f, 30.0f, [this](float v) { setCompressorGain(v); },
+        [this] { return getCompressorGain(); }, [this](float v) { compressor.setMakeupGain(v); }};
+    parameterMap["compressorMix"] = {ParameterInfo::FLOAT, 0.0f, 1.0f, [this](float v) { setCompressorMix(v); },
+        [this] { return getCompressorMix(); }, [this](float v) { compressor.setMix(v); }};
     parameterMap["compressorMultiband"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setCompressorMultiband(v > 0.5f); }};
 
-    // Distortion Effect Parameters (8)
+    // Distortion Effect Parameters (9)
     parameterMap["distortionEnabled"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setDistortionEnabled(v > 0.5f); }};
     parameterMap["distortionType"] = {ParameterInfo::INT, 1.0f, 16.0f, [this](float v) { setDistortionType((int)v); }};
-    parameterMap["distortionDrive"] = {ParameterInfo::FLOAT, 0.0f, 100.0f, [this](float v) { setDistortionDrive(v); }};
-    parameterMap["distortionMix"] = {ParameterInfo::FLOAT, 0.0f, 1.0f, [this](float v) { setDistortionMix(v); }};
+    parameterMap["distortionDrive"] = {ParameterInfo::FLOAT, 0.0f, 100.0f, [this](float v) { setDistortionDrive(v); },
+        [this] { return getDistortionDrive(); }, [this](float v) { distortion.setDrive(v); }};
+    parameterMap["distortionMix"] = {ParameterInfo::FLOAT, 0.0f, 1.0f, [this](float v) { setDistortionMix(v); },
+        [this] { return getDistortionMix(); }, [this](float v) { distortion.setMix(v); }};
     parameterMap["distortionFilterPosition"] = {ParameterInfo::INT, 0.0f, 2.0f, [this](float v) { setDistortionFilterPosition((int)v); }};
     parameterMap["distortionFilterType"] = {ParameterInfo::INT, 1.0f, 3.0f, [this](float v) { setDistortionFilterType((int)v); }};
-    parameterMap["distortionFilterFreq"] = {ParameterInfo::FLOAT, 20.0f, 20000.0f, [this](float v) { setDistortionFilterFreq(v); }};
-    parameterMap["distortionFilterQ"] = {ParameterInfo::FLOAT, 0.1f, 30.0f, [this](float v) { setDistortionFilterQ(v); }};
+    parameterMap["distortionFilterFreq"] = {ParameterInfo::FLOAT, 20.0f, 20000.0f, [this](float v) { setDistortionFilterFreq(v); },
+        [this] { return getDistortionFilterFreq(); }, [this](float v) { distortion.setFilterFrequency(v); }};
+    parameterMap["distortionFilterQ"] = {ParameterInfo::FLOAT, 0.1f, 30.0f, [this](float v) { setDistortionFilterQ(v); },
+        [this] { return getDistortionFilterQ(); }, [this](float v) { distortion.setFilterQ(v); }};
+    parameterMap["distortionOversampling"] = {ParameterInfo::INT, 0.0f, 3.0f, [this](float v) { setDistortionOversampling((int)v); }};
 
     // Delay Effect Parameters (13)
     parameterMap["delayEnabled"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setDelayEnabled(v > 0.5f); }};
-    parameterMap["delayFeedback"] = {ParameterInfo::FLOAT, 0.0f, 0.95f, [this](float v) { setDelayFeedback(v); }};
-    parameterMap["delayMix"] = {ParameterInfo::FLOAT, 0.0f, 1.0f, [this](float v) { setDelayMix(v); }};
+    parameterMap["delayFeedback"] = {ParameterInfo::FLOAT, 0.0f, 0.95f, [this](float v) { setDelayFeedback(v); },
+        [this] { return getDelayFeedback(); }, [this](float v) { delay.setFeedback(v); }};
+    parameterMap["delayMix"] = {ParameterInfo::FLOAT, 0.0f, 1.0f, [this](float v) { setDelayMix(v); },
+        [this] { return getDelayMix(); }, [this](float v) { delay.setMix(v); }};
     parameterMap["delayPingPong"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setDelayPingPong(v > 0.5f); }};
-    parameterMap["delayLeftTime"] = {ParameterInfo::FLOAT, 1.0f, 2000.0f, [this](float v) { setDelayLeftTime(v); }};
-    parameterMap["delayRightTime"] = {ParameterInfo::FLOAT, 1.0f, 2000.0f, [this](float v) { setDelayRightTime(v); }};
+    parameterMap["delayLeftTime"] = {ParameterInfo::FLOAT, 1.0f, 2000.0f, [this](float v) { setDelayLeftTime(v); },
+        [this] { return getDelayLeftTime(); }, [this](float v) { delay.setLeftTime(v); }};
+    parameterMap["delayRightTime"] = {ParameterInfo::FLOAT, 1.0f, 2000.0f, [this](float v) { setDelayRightTime(v); },
+        [this] { return getDelayRightTime(); }, [this](float v) { delay.setRightTime(v); }};
     parameterMap["delaySync"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setDelaySync(v > 0.5f); }};
     parameterMap["delayTriplet"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setDelayTriplet(v > 0.5f); }};
     parameterMap["delayDotted"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setDelayDotted(v > 0.5f); }};
     parameterMap["delayRTriplet"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setDelayRTriplet(v > 0.5f); }};
     parameterMap["delayRDotted"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setDelayRDotted(v > 0.5f); }};
-    parameterMap["delayFilterFreq"] = {ParameterInfo::FLOAT, 20.0f, 20000.0f, [this](float v) { setDelayFilterFreq(v); }};
-    parameterMap["delayFilterQ"] = {ParameterInfo::FLOAT, 0.1f, 30.0f, [this](float v) { setDelayFilterQ(v); }};
+    parameterMap["delayFilterFreq"] = {ParameterInfo::FLOAT, 20.0f, 20000.0f, [this](float v) { setDelayFilterFreq(v); },
+        [this] { return getDelayFilterFreq(); }, [this](float v) { delay.setFilterFreq(v); }};
+    parameterMap["delayFilterQ"] = {ParameterInfo::FLOAT, 0.1f, 30.0f, [this](float v) { setDelayFilterQ(v); },
+        [this] { return getDelayFilterQ(); }, [this](float v) { delay.setFilterQ(v); }};
 
     // Reverb Effect Parameters (9)
     parameterMap["reverbEnabled"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setReverbEnabled(v > 0.5f); }};
-    parameterMap["reverbMix"] = {ParameterInfo::FLOAT, 0.0f, 100.0f, [this](float v) { setReverbMix(v); }};
-    parameterMap["reverbType"] = {ParameterInfo::INT, 1.0f, 5.0f, [this](float v) { setReverbType((int)v); }};
-    parameterMap["reverbLowCut"] = {ParameterInfo::FLOAT, 20.0f, 1000.0f, [this](float v) { setReverbLowCut(v); }};
-    parameterMap["reverbHighCut"] = {ParameterInfo::FLOAT, 1000.0f, 20000.0f, [this](float v) { setReverbHighCut(v); }};
-    parameterMap["reverbSize"] = {ParameterInfo::FLOAT, 0.0f, 100.0f, [this](float v) { setReverbSize(v); }};
-    parameterMap["reverbPreDelay"] = {ParameterInfo::FLOAT, 0.0f, 200.0f, [this](float v) { setReverbPreDelay(v); }};
-    parameterMap["reverbDamping"] = {ParameterInfo::FLOAT, 0.0f, 100.0f, [this](float v) { setReverbDamping(v); }};
-    parameterMap["reverbWidth"] = {ParameterInfo::FLOAT, 0.0f, 100.0f, [this](float v) { setReverbWidth(v); }};
+    parameterMap["reverbMix"] = {ParameterInfo::FLOAT, 0.0f, 100.0f, [this](float v) { setReverbMix(v); },
+        [this] { return getReverbMix(); }, [this](float v) { reverb.setMix(v / 100.0f); }};
+    parameterMap["reverbType"] = {ParameterInfo::INT, 1.0f, 6.0f, [this](float v) { setReverbType((int)v); }};
+    parameterMap["reverbLowCut"] = {ParameterInfo::FLOAT, 20.0f, 1000.0f, [this](float v) { setReverbLowCut(v); },
+        [this] { return getReverbLowCut(); }, [this](float v) { reverb.setLowCut(v); }};
+    parameterMap["reverbHighCut"] = {ParameterInfo::FLOAT, 1000.0f, 20000.0f, [this](float v) { setReverbHighCut(v); },
+        [this] { return getReverbHighCut(); }, [this](float v) { reverb.setHighCut(v); }};
+    parameterMap["reverbSize"] = {ParameterInfo::FLOAT, 0.0f, 100.0f, [this](float v) { setReverbSize(v); },
+        [this] { return getReverbSize(); }, [this](float v) { reverb.setSize(v / 100.0f); }};
+    parameterMap["reverbPreDelay"] = {ParameterInfo::FLOAT, 0.0f, 200.0f, [this](float v) { setReverbPreDelay(v); },
+        [this] { return getReverbPreDelay(); }, [this](float v) { reverb.setPreDelay(v); }};
+    parameterMap["reverbDamping"] = {ParameterInfo::FLOAT, 0.0f, 100.0f, [this](float v) { setReverbDamping(v); },
+        [this] { return getReverbDamping(); }, [this](float v) { reverb.setDamping(v / 100.0f); }};
+    parameterMap["reverbWidth"] = {ParameterInfo::FLOAT, 0.0f, 100.0f, [this](float v) { setReverbWidth(v); },
+        [this] { return getReverbWidth(); }, [this](float v) { reverb.setWidth(v / 100.0f); }};
 
     // EQ Effect Parameters (11)
     parameterMap["eqEnabled"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setEQEnabled(v > 0.5f); }};
     parameterMap["eq1Enabled"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setEQ1Enabled(v > 0.5f); }};
-    parameterMap["eq1Frequency"] = {ParameterInfo::FLOAT, 20.0f, 20000.0f, [this](float v) { setEQ1Frequency(v); }};
-    parameterMap["eq1Q"] = {ParameterInfo::FLOAT, 0.1f, 30.0f, [this](float v) { setEQ1Q(v); }};
-    parameterMap["eq1Gain"] = {ParameterInfo::FLOAT, -15.0f, 15.0f, [this](float v) { setEQ1Gain(v); }};
+    parameterMap["eq1Frequency"] = {ParameterInfo::FLOAT, 20.0f, 20000.0f, [this](float v) { setEQ1Frequency(v); },
+        [this] { return getEQ1Frequency(); }, [this](float v) { eq.setBandFrequency(0, v); }};
+    parameterMap["eq1Q"] = {ParameterInfo::FLOAT, 0.1f, 30.0f, [this](float v) { setEQ1Q(v); },
+        [this] { return getEQ1Q(); }, [this](float v) { eq.setBandQ(0, v); }};
+    parameterMap["eq1Gain"] = {ParameterInfo::FLOAT, -15.0f, 15.0f, [this](float v) { setEQ1Gain(v); },
+        [this] { return getEQ1Gain(); }, [this](float v) { eq.setBandGain(0, v); }};
     parameterMap["eq1Type"] = {ParameterInfo::INT, 0.0f, 2.0f, [this](float v) { setEQ1Type((int)v); }};
     parameterMap["eq2Enabled"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this](float v) { setEQ2Enabled(v > 0.5f); }};
-    parameterMap["eq2Frequency"] = {ParameterInfo::FLOAT, 20.0f, 20000.0f, [this](float v) { setEQ2Frequency(v); }};
-    parameterMap["eq2Q"] = {ParameterInfo::FLOAT, 0.1f, 30.0f, [this](float v) { setEQ2Q(v); }};
-    parameterMap["eq2Gain"] = {ParameterInfo::FLOAT, -15.0f, 15.0f, [this](float v) { setEQ2Gain(v); }};
+    parameterMap["eq2Frequency"] = {ParameterInfo::FLOAT, 20.0f, 20000.0f, [this](float v) { setEQ2Frequency(v); },
+        [this] { return getEQ2Frequency(); }, [this](float v) { eq.setBandFrequency(1, v); }};
+    parameterMap["eq2Q"] = {ParameterInfo::FLOAT, 0.1f, 30.0f, [this](float v) { setEQ2Q(v); },
+        [this] { return getEQ2Q(); }, [this](float v) { eq.setBandQ(1, v); }};
+    parameterMap["eq2Gain"] = {ParameterInfo::FLOAT, -15.0f, 15.0f, [this](float v) { setEQ2Gain(v); },
+        [this] { return getEQ2Gain(); }, [this](float v) { eq.setBandGain(1, v); }};
     parameterMap["eq2Type"] = {ParameterInfo::INT, 0.0f, 2.0f, [this](float v) { setEQ2Type((int)v); }};
+    parameterMap["eqBandCount"] = {ParameterInfo::INT, 1.0f, static_cast<float>(maxEqBands), [this](float v) { setEQBandCount((int)v); }};
+    for (int band = 0; band < maxEqBands; ++band)
+    {
+        // Bands 1 and 2 keep their names from the two-band EQ; every band has a full filter type
+        const std::string prefix = "eq" + std::to_string(band + 1);
+        if (band >= 2)
+        {
+            parameterMap[prefix + "Enabled"] = {ParameterInfo::BOOL, 0.0f, 1.0f, [this, band](float v) { setEQBandEnabled(band, v > 0.5f); }};
+            parameterMap[prefix + "Frequency"] = {ParameterInfo::FLOAT, 20.0f, 20000.0f, [this, band](float v) { setEQBandFrequency(band, v); },
+                [this, band] { return getEQBandFrequency(band); }, [this, band](float v) { eq.setBandFrequency(band, v); }};
+            parameterMap[prefix + "Q"] = {ParameterInfo::FLOAT, 0.1f, 30.0f, [this, band](float v) { setEQBandQ(band, v); },
+                [this, band] { return getEQBandQ(band); }, [this, band](float v) { eq.setBandQ(band, v); }};
+            parameterMap[prefix + "Gain"] = {ParameterInfo::FLOAT, -15.0f, 15.0f, [this, band](float v) { setEQBandGain(band, v); },
+                [this, band] { return getEQBandGain(band); }, [this, band](float v) { eq.setBandGain(band, v); }};
+        }
+        parameterMap[prefix + "Filter"] = {ParameterInfo::INT, 0.0f, static_cast<float>(BiquadCoefficients::BAND_PASS), [this, band](float v) { setEQBandFilterType(band, (int)v); }};
+    }
+
+    // LFO Parameters (3)
+    parameterMap["lfoRate"] = {ParameterInfo::FLOAT, 0.001f, 100.0f, [this](float v) { setLfoRate(v); },
+        [this] { return getLfoRate(); }, [this](float v) { lfo.setRateHz(v); }};
+    parameterMap["lfoMode"] = {ParameterInfo::INT, 0.0f, 2.0f, [this](float v) { setLfoMode((int)v); }};
+    parameterMap["lfoSyncDivision"] = {ParameterInfo::INT, 0.0f, 20.0f, [this](float v) { setLfoSyncDivision((int)v); }};
+    
+    // Every continuous parameter that acts on sounding notes can be an LFO target
+    lfoTargets.clear();
+    for (const auto& param : parameterMap)
+        if (param.second.modulate)
+            lfoTargets.push_back(&param.second);
 }
 
 bool SummonerXSerum2AudioProcessor::setParameterByName(const std::string& name, const std::string& value)
@@ -837,6 +1441,7 @@ bool SummonerXSerum2AudioProcessor::validateParameterValue(const std::string& na
 
 std::pair<int, int> SummonerXSerum2AudioProcessor::applyResponseParameters(const std::map<std::string, std::string>& response)
 {
+    const ParameterBatch batch(*this);
     int successfulUpdates = 0;
     int failedUpdates = 0;
     
@@ -940,6 +1545,9 @@ juce::ValueTree SummonerXSerum2AudioProcessor::createPresetData()
         else if (paramName == "osc1Sustain") params.setProperty("osc1Sustain", osc1Sustain, nullptr);
         else if (paramName == "osc1Release") params.setProperty("osc1Release", osc1Release, nullptr);
         
+        else if (paramName == "polyphony") params.setProperty("polyphony", polyphony, nullptr);
+        else if (paramName == "voiceStealMode") params.setProperty("voiceStealMode", voiceStealMode, nullptr);
+        
         else if (paramName == "osc1Type") params.setProperty("osc1Type", osc1Type, nullptr);
         else if (paramName == "osc1PulseWidth") params.setProperty("osc1PulseWidth", osc1PulseWidth, nullptr);
         else if (paramName == "osc1Octave") params.setProperty("osc1Octave", osc1Octave, nullptr);
@@ -960,6 +1568,7 @@ juce::ValueTree SummonerXSerum2AudioProcessor::createPresetData()
         else if (paramName == "osc2FineTune") params.setProperty("osc2FineTune", osc2FineTune, nullptr);
         else if (paramName == "osc2RandomPhase") params.setProperty("osc2RandomPhase", osc2RandomPhase, nullptr);
         else if (paramName == "osc2Phase") params.setProperty("osc2Phase", osc2Phase, nullptr);
+        else if (paramName == "osc2PulseWidth") params.setProperty("osc2PulseWidth", osc2PulseWidth, nullptr);
         else if (paramName == "osc2Attack") params.setProperty("osc2Attack", osc2Attack, nullptr);
         else if (paramName == "osc2Decay") params.setProperty("osc2Decay", osc2Decay, nullptr);
         else if (paramName == "osc2Sustain") params.setProperty("osc2Sustain", osc2Sustain, nullptr);
@@ -975,7 +1584,9 @@ juce::ValueTree SummonerXSerum2AudioProcessor::createPresetData()
         else if (paramName == "filterBPEnabled") params.setProperty("filterBPEnabled", filterBPEnabled, nullptr);
         else if (paramName == "filterNotchEnabled") params.setProperty("filterNotchEnabled", filterNotchEnabled, nullptr);
         else if (paramName == "filterCombEnabled") params.setProperty("filterCombEnabled", filterCombEnabled, nullptr);
+        else if (paramName == "filterCombNegative") params.setProperty("filterCombNegative", filterCombNegative, nullptr);
         else if (paramName == "filterFormantEnabled") params.setProperty("filterFormantEnabled", filterFormantEnabled, nullptr);
+        else if (paramName == "filterFormantVowel") params.setProperty("filterFormantVowel", filterFormantVowel, nullptr);
         else if (paramName == "filter12dBEnabled") params.setProperty("filter12dBEnabled", filter12dBEnabled, nullptr);
         else if (paramName == "filter24dBEnabled") params.setProperty("filter24dBEnabled", filter24dBEnabled, nullptr);
         
@@ -987,6 +1598,7 @@ juce::ValueTree SummonerXSerum2AudioProcessor::createPresetData()
         else if (paramName == "chorusFeedback") params.setProperty("chorusFeedback", chorusFeedback, nullptr);
         else if (paramName == "chorusLPF") params.setProperty("chorusLPF", chorusLPF, nullptr);
         else if (paramName == "chorusMix") params.setProperty("chorusMix", chorusMix, nullptr);
+        else if (paramName == "chorusVoices") params.setProperty("chorusVoices", chorusVoices, nullptr);
         
         else if (paramName == "flangerEnabled") params.setProperty("flangerEnabled", flangerEnabled, nullptr);
         else if (paramName == "flangerRate") params.setProperty("flangerRate", flangerRate, nullptr);
@@ -1022,6 +1634,7 @@ juce::ValueTree SummonerXSerum2AudioProcessor::createPresetData()
         else if (paramName == "distortionFilterType") params.setProperty("distortionFilterType", distortionFilterType, nullptr);
         else if (paramName == "distortionFilterFreq") params.setProperty("distortionFilterFreq", distortionFilterFreq, nullptr);
         else if (paramName == "distortionFilterQ") params.setProperty("distortionFilterQ", distortionFilterQ, nullptr);
+        else if (paramName == "distortionOversampling") params.setProperty("distortionOversampling", distortionOversampling, nullptr);
         
         else if (paramName == "delayEnabled") params.setProperty("delayEnabled", delayEnabled, nullptr);
         else if (paramName == "delayFeedback") params.setProperty("delayFeedback", delayFeedback, nullptr);
@@ -1048,16 +1661,21 @@ juce::ValueTree SummonerXSerum2AudioProcessor::createPresetData()
         else if (paramName == "reverbWidth") params.setProperty("reverbWidth", reverbWidth, nullptr);
         
         else if (paramName == "eqEnabled") params.setProperty("eqEnabled", eqEnabled, nullptr);
-        else if (paramName == "eq1Enabled") params.setProperty("eq1Enabled", eq1Enabled, nullptr);
-        else if (paramName == "eq1Frequency") params.setProperty("eq1Frequency", eq1Frequency, nullptr);
-        else if (paramName == "eq1Q") params.setProperty("eq1Q", eq1Q, nullptr);
-        else if (paramName == "eq1Gain") params.setProperty("eq1Gain", eq1Gain, nullptr);
+        else if (paramName == "eq1Enabled") params.setProperty("eq1Enabled", getEQ1Enabled(), nullptr);
+        else if (paramName == "eq1Frequency") params.setProperty("eq1Frequency", getEQ1Frequency(), nullptr);
+        else if (paramName == "eq1Q") params.setProperty("eq1Q", getEQ1Q(), nullptr);
+        else if (paramName == "eq1Gain") params.setProperty("eq1Gain", getEQ1Gain(), nullptr);
         else if (paramName == "eq1Type") params.setProperty("eq1Type", eq1Type, nullptr);
-        else if (paramName == "eq2Enabled") params.setProperty("eq2Enabled", eq2Enabled, nullptr);
-        else if (paramName == "eq2Frequency") params.setProperty("eq2Frequency", eq2Frequency, nullptr);
-        else if (paramName == "eq2Q") params.setProperty("eq2Q", eq2Q, nullptr);
-        else if (paramName == "eq2Gain") params.setProperty("eq2Gain", eq2Gain, nullptr);
+        else if (paramName == "eq2Enabled") params.setProperty("eq2Enabled", getEQ2Enabled(), nullptr);
+        else if (paramName == "eq2Frequency") params.setProperty("eq2Frequency", getEQ2Frequency(), nullptr);
+        else if (paramName == "eq2Q") params.setProperty("eq2Q", getEQ2Q(), nullptr);
+        else if (paramName == "eq2Gain") params.setProperty("eq2Gain", getEQ2Gain(), nullptr);
         else if (paramName == "eq2Type") params.setProperty("eq2Type", eq2Type, nullptr);
+        else if (paramName == "eqBandCount") params.setProperty("eqBandCount", eqBandCount, nullptr);
+        else if (juce::String(paramName).startsWith("eq")) {} // The remaining band parameters are written below
+        else if (paramName == "lfoRate") params.setProperty("lfoRate", lfoRate, nullptr);
+        else if (paramName == "lfoMode") params.setProperty("lfoMode", lfoMode, nullptr);
+        else if (paramName == "lfoSyncDivision") params.setProperty("lfoSyncDivision", lfoSyncDivision, nullptr);
         else
         {
             // Debug output for any missed parameters
@@ -1076,6 +1694,10 @@ juce::ValueTree SummonerXSerum2AudioProcessor::createPresetData()
     params.setProperty("osc1Sustain", osc1Sustain, nullptr);
     params.setProperty("osc1Release", osc1Release, nullptr);
     
+    // Voice allocation parameters
+    params.setProperty("polyphony", polyphony, nullptr);
+    params.setProperty("voiceStealMode", voiceStealMode, nullptr);
+    
     // Oscillator 1 parameters
     params.setProperty("osc1Type", osc1Type, nullptr);
     params.setProperty("osc1PulseWidth", osc1PulseWidth, nullptr);
@@ -1098,6 +1720,7 @@ juce::ValueTree SummonerXSerum2AudioProcessor::createPresetData()
     params.setProperty("osc2FineTune", osc2FineTune, nullptr);
     params.setProperty("osc2RandomPhase", osc2RandomPhase, nullptr);
     params.setProperty("osc2Phase", osc2Phase, nullptr);
+    params.setProperty("osc2PulseWidth", osc2PulseWidth, nullptr);
     params.setProperty("osc2Attack", osc2Attack, nullptr);
     params.setProperty("osc2Decay", osc2Decay, nullptr);
     params.setProperty("osc2Sustain", osc2Sustain, nullptr);
@@ -1114,7 +1737,9 @@ juce::ValueTree SummonerXSerum2AudioProcessor::createPresetData()
     params.setProperty("filterBPEnabled", filterBPEnabled, nullptr);
     params.setProperty("filterNotchEnabled", filterNotchEnabled, nullptr);
     params.setProperty("filterCombEnabled", filterCombEnabled, nullptr);
+    params.setProperty("filterCombNegative", filterCombNegative, nullptr);
     params.setProperty("filterFormantEnabled", filterFormantEnabled, nullptr);
+    params.setProperty("filterFormantVowel", filterFormantVowel, nullptr);
     params.setProperty("filter12dBEnabled", filter12dBEnabled, nullptr);
     params.setProperty("filter24dBEnabled", filter24dBEnabled, nullptr);
     
@@ -1127,6 +1752,7 @@ juce::ValueTree SummonerXSerum2AudioProcessor::createPresetData()
     params.setProperty("chorusFeedback", chorusFeedback, nullptr);
     params.setProperty("chorusLPF", chorusLPF, nullptr);
     params.setProperty("chorusMix", chorusMix, nullptr);
+    params.setProperty("chorusVoices", chorusVoices, nullptr);
     
     // Effects parameters - Flanger
     params.setProperty("flangerEnabled", flangerEnabled, nullptr);
@@ -1166,6 +1792,7 @@ juce::ValueTree SummonerXSerum2AudioProcessor::createPresetData()
     params.setProperty("distortionFilterType", distortionFilterType, nullptr);
     params.setProperty("distortionFilterFreq", distortionFilterFreq, nullptr);
     params.setProperty("distortionFilterQ", distortionFilterQ, nullptr);
+    params.setProperty("distortionOversampling", distortionOversampling, nullptr);
     
     // Effects parameters - Delay
     params.setProperty("delayEnabled", delayEnabled, nullptr);
@@ -1195,18 +1822,64 @@ juce::ValueTree SummonerXSerum2AudioProcessor::createPresetData()
     
     // Effects parameters - EQ
     params.setProperty("eqEnabled", eqEnabled, nullptr);
-    params.setProperty("eq1Enabled", eq1Enabled, nullptr);
-    params.setProperty("eq1Frequency", eq1Frequency, nullptr);
-    params.setProperty("eq1Q", eq1Q, nullptr);
-    params.setProperty("eq1Gain", eq1Gain, nullptr);
+    params.setProperty("eq1Enabled", getEQ1Enabled(), nullptr);
+    params.setProperty("eq1Frequency", getEQ1Frequency(), nullptr);
+    params.setProperty("eq1Q", getEQ1Q(), nullptr);
+    params.setProperty("eq1Gain", getEQ1Gain(), nullptr);
     params.setProperty("eq1Type", eq1Type, nullptr);
-    params.setProperty("eq2Enabled", eq2Enabled, nullptr);
-    params.setProperty("eq2Frequency", eq2Frequency, nullptr);
-    params.setProperty("eq2Q", eq2Q, nullptr);
-    params.setProperty("eq2Gain", eq2Gain, nullptr);
+    params.setProperty("eq2Enabled", getEQ2Enabled(), nullptr);
+    params.setProperty("eq2Frequency", getEQ2Frequency(), nullptr);
+    params.setProperty("eq2Q", getEQ2Q(), nullptr);
+    params.setProperty("eq2Gain", getEQ2Gain(), nullptr);
     params.setProperty("eq2Type", eq2Type, nullptr);
+    params.setProperty("eqBandCount", eqBandCount, nullptr);
+    for (int band = 0; band < maxEqBands; ++band)
+    {
+        const auto index = static_cast<size_t>(band);
+        const juce::String prefix = "eq" + juce::String(band + 1);
+        if (band >= 2)
+        {
+            params.setProperty(prefix + "Enabled", eqBandEnabled[index], nullptr);
+            params.setProperty(prefix + "Frequency", eqBandFrequency[index], nullptr);
+            params.setProperty(prefix + "Q", eqBandQ[index], nullptr);
+            params.setProperty(prefix + "Gain", eqBandGain[index], nullptr);
+        }
+        params.setProperty(prefix + "Filter", eqBandFilterType[index], nullptr);
+    }
+    
+    // LFO parameters
+    params.setProperty("lfoRate", lfoRate, nullptr);
+    params.setProperty("lfoMode", lfoMode, nullptr);
+    params.setProperty("lfoSyncDivision", lfoSyncDivision, nullptr);
+    
+    // Routes are saved by name and depth; routed parameters keep their own value above
+    juce::ValueTree lfoState("LFO");
+    juce::String shape;
+    for (float point : lfoShapePoints)
+        shape += juce::String(point) + " ";
+    lfoState.setProperty("shape", shape.trim(), nullptr);
+    
+    for (const auto& setting : lfoRouteSettings)
+    {
+        if (setting.parameter.empty())
+            continue;
+        
+        juce::ValueTree route("ROUTE");
+        route.setProperty("parameter", juce::String(setting.parameter), nullptr);
+        route.setProperty("depth", setting.depth, nullptr);
+        lfoState.appendChild(route, nullptr);
+    }
     
     preset.appendChild(params, nullptr);
+    preset.appendChild(lfoState, nullptr);
+    
+    // The impulse response is referenced by path, not embedded
+    if (reverbImpulseFile != juce::File())
+    {
+        juce::ValueTree impulseState("IMPULSE");
+        impulseState.setProperty("file", reverbImpulseFile.getFullPathName(), nullptr);
+        preset.appendChild(impulseState, nullptr);
+    }
     return preset;
 }
 
@@ -1219,6 +1892,12 @@ bool SummonerXSerum2AudioProcessor::applyPresetData(const juce::ValueTree& prese
     if (!params.isValid())
         return false;
     
+    const ParameterBatch batch(*this);
+    
+    // Routes from the previous sound would hold on to their parameters
+    for (int slot = 0; slot < maxLfoRoutes; ++slot)
+        clearLfoRoute(slot);
+    
     // Apply all parameters - using the property accessors to ensure proper updating
     // Support both new and old parameter names for backward compatibility
     // NOTE: masterVolume is intentionally preserved during preset loading
@@ -1250,6 +1929,10 @@ bool SummonerXSerum2AudioProcessor::applyPresetData(const juce::ValueTree& prese
     if (params.hasProperty("osc1Release")) setOsc1Release(params.getProperty("osc1Release"));
     else if (params.hasProperty("synthRelease")) setOsc1Release(params.getProperty("synthRelease"));
     
+    // Voice allocation parameters
+    if (params.hasProperty("polyphony")) setPolyphony(params.getProperty("polyphony"));
+    if (params.hasProperty("voiceStealMode")) setVoiceStealMode(params.getProperty("voiceStealMode"));
+    
     // Oscillator 1 parameters
     if (params.hasProperty("osc1Type")) setOsc1Type(params.getProperty("osc1Type"));
     if (params.hasProperty("osc1PulseWidth")) setOsc1PulseWidth(params.getProperty("osc1PulseWidth"));
@@ -1272,6 +1955,7 @@ bool SummonerXSerum2AudioProcessor::applyPresetData(const juce::ValueTree& prese
     if (params.hasProperty("osc2FineTune")) setOsc2FineTune(params.getProperty("osc2FineTune"));
     if (params.hasProperty("osc2RandomPhase")) setOsc2RandomPhase(params.getProperty("osc2RandomPhase"));
     if (params.hasProperty("osc2Phase")) setOsc2Phase(params.getProperty("osc2Phase"));
+    if (params.hasProperty("osc2PulseWidth")) setOsc2PulseWidth(params.getProperty("osc2PulseWidth"));
     if (params.hasProperty("osc2Attack")) setOsc2Attack(params.getProperty("osc2Attack"));
     if (params.hasProperty("osc2Decay")) setOsc2Decay(params.getProperty("osc2Decay"));
     if (params.hasProperty("osc2Sustain")) setOsc2Sustain(params.getProperty("osc2Sustain"));
@@ -1288,7 +1972,9 @@ bool SummonerXSerum2AudioProcessor::applyPresetData(const juce::ValueTree& prese
     if (params.hasProperty("filterBPEnabled")) setFilterBPEnabled(params.getProperty("filterBPEnabled"));
     if (params.hasProperty("filterNotchEnabled")) setFilterNotchEnabled(params.getProperty("filterNotchEnabled"));
     if (params.hasProperty("filterCombEnabled")) setFilterCombEnabled(params.getProperty("filterCombEnabled"));
+    if (params.hasProperty("filterCombNegative")) setFilterCombNegative(params.getProperty("filterCombNegative"));
     if (params.hasProperty("filterFormantEnabled")) setFilterFormantEnabled(params.getProperty("filterFormantEnabled"));
+    if (params.hasProperty("filterFormantVowel")) setFilterFormantVowel(params.getProperty("filterFormantVowel"));
     if (params.hasProperty("filter12dBEnabled")) setFilter12dBEnabled(params.getProperty("filter12dBEnabled"));
     if (params.hasProperty("filter24dBEnabled")) setFilter24dBEnabled(params.getProperty("filter24dBEnabled"));
     
@@ -1301,6 +1987,7 @@ bool SummonerXSerum2AudioProcessor::applyPresetData(const juce::ValueTree& prese
     if (params.hasProperty("chorusFeedback")) setChorusFeedback(params.getProperty("chorusFeedback"));
     if (params.hasProperty("chorusLPF")) setChorusLPF(params.getProperty("chorusLPF"));
     if (params.hasProperty("chorusMix")) setChorusMix(params.getProperty("chorusMix"));
+    if (params.hasProperty("chorusVoices")) setChorusVoices(params.getProperty("chorusVoices"));
     
     // Effects parameters - Flanger
     if (params.hasProperty("flangerEnabled")) setFlangerEnabled(params.getProperty("flangerEnabled"));
@@ -1340,6 +2027,7 @@ bool SummonerXSerum2AudioProcessor::applyPresetData(const juce::ValueTree& prese
     if (params.hasProperty("distortionFilterType")) setDistortionFilterType(params.getProperty("distortionFilterType"));
     if (params.hasProperty("distortionFilterFreq")) setDistortionFilterFreq(params.getProperty("distortionFilterFreq"));
     if (params.hasProperty("distortionFilterQ")) setDistortionFilterQ(params.getProperty("distortionFilterQ"));
+    if (params.hasProperty("distortionOversampling")) setDistortionOversampling(params.getProperty("distortionOversampling"));
     
     // Effects parameters - Delay
     if (params.hasProperty("delayEnabled")) setDelayEnabled(params.getProperty("delayEnabled"));
@@ -1380,6 +2068,51 @@ bool SummonerXSerum2AudioProcessor::applyPresetData(const juce::ValueTree& prese
     if (params.hasProperty("eq2Gain")) setEQ2Gain(params.getProperty("eq2Gain"));
     if (params.hasProperty("eq2Type")) setEQ2Type(params.getProperty("eq2Type"));
     
+    // Presets from before the N-band EQ have two bands
+    setEQBandCount(params.getProperty("eqBandCount", 2));
+    for (int band = 0; band < maxEqBands; ++band)
+    {
+        const juce::String prefix = "eq" + juce::String(band + 1);
+        if (band >= 2)
+        {
+            if (params.hasProperty(prefix + "Enabled")) setEQBandEnabled(band, params.getProperty(prefix + "Enabled"));
+            if (params.hasProperty(prefix + "Frequency")) setEQBandFrequency(band, params.getProperty(prefix + "Frequency"));
+            if (params.hasProperty(prefix + "Q")) setEQBandQ(band, params.getProperty(prefix + "Q"));
+            if (params.hasProperty(prefix + "Gain")) setEQBandGain(band, params.getProperty(prefix + "Gain"));
+        }
+        if (params.hasProperty(prefix + "Filter")) setEQBandFilterType(band, params.getProperty(prefix + "Filter"));
+    }
+    
+    // LFO parameters
+    if (params.hasProperty("lfoRate")) setLfoRate(params.getProperty("lfoRate"));
+    if (params.hasProperty("lfoMode")) setLfoMode(params.getProperty("lfoMode"));
+    if (params.hasProperty("lfoSyncDivision")) setLfoSyncDivision(params.getProperty("lfoSyncDivision"));
+    
+    // Presets saved before the LFO existed get the default sine and no routes
+    auto lfoState = presetData.getChildWithName("LFO");
+    std::vector<float> lfoShape;
+    if (lfoState.isValid())
+    {
+        juce::StringArray points;
+        points.addTokens(lfoState.getProperty("shape").toString(), false);
+        for (const auto& point : points)
+            lfoShape.push_back(juce::jlimit(0.0f, 1.0f, point.getFloatValue()));
+    }
+    setLfoShape(lfoShape);
+    
+    int routeSlot = 0;
+    for (int i = 0; lfoState.isValid() && i < lfoState.getNumChildren() && routeSlot < maxLfoRoutes; ++i)
+    {
+        const auto route = lfoState.getChild(i);
+        if (setLfoRoute(routeSlot, route.getProperty("parameter").toString().toStdString(), route.getProperty("depth")))
+            ++routeSlot;
+    }
+    
+    // Without a reachable impulse file the built-in response plays
+    const juce::File impulseFile(presetData.getChildWithName("IMPULSE").getProperty("file").toString());
+    if (impulseFile.getFullPathName().isEmpty() || !loadReverbImpulse(impulseFile))
+        clearReverbImpulse();
+    
     // Trigger UI update
     updateHostDisplay();
     if (onPresetApplied)
@@ -1617,6 +2350,10 @@ bool SummonerXSerum2AudioProcessor::initializeAllParameters()
         {"osc1Sustain", 0.7f},
         {"osc1Release", 0.3f},
         
+        // Voice Allocation Parameters
+        {"polyphony", 8.0f},
+        {"voiceStealMode", 0.0f},  // Oldest
+        
         // Oscillator 1 Parameters
         {"osc1Type", 1.0f},  // Saw wave
         {"osc1PulseWidth", 0.5f},
@@ -1639,6 +2376,7 @@ bool SummonerXSerum2AudioProcessor::initializeAllParameters()
         {"osc2FineTune", 0.0f},
         {"osc2RandomPhase", 1.0f},  // true
         {"osc2Phase", 0.0f},
+        {"osc2PulseWidth", 0.5f},
         {"osc2Attack", 0.1f},
         {"osc2Decay", 0.2f},
         {"osc2Sustain", 0.7f},
@@ -1655,11 +2393,24 @@ bool SummonerXSerum2AudioProcessor::initializeAllParameters()
         {"filterBPEnabled", 0.0f},
         {"filterNotchEnabled", 0.0f},
         {"filterCombEnabled", 0.0f},
+        {"filterCombNegative", 0.0f},
         {"filterFormantEnabled", 0.0f},
+        {"filterFormantVowel", 0.0f},
         {"filter12dBEnabled", 1.0f},  // true
-        {"filter24dBEnabled", 0.0f}
+        {"filter24dBEnabled", 0.0f},
+        
+        // LFO Parameters
+        {"lfoRate", 1.0f},
+        {"lfoMode", 0.0f},           // Free
+        {"lfoSyncDivision", 5.0f}    // 1 bar
     };
     
+    // The init sound has a sine LFO routed nowhere
+    for (int slot = 0; slot < maxLfoRoutes; ++slot)
+        clearLfoRoute(slot);
+    setLfoShape({});
+    clearReverbImpulse();
+    
     // Apply startup defaults for all parameters
     for (const auto& param : parameterMap)
     {
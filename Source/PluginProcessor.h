@@ -2,6 +2,24 @@
 #include <JuceHeader.h>
 #include <array>
 #include "SettingsComponent.h"
+#include "DSP/WavetableBank.h"
+#include "DSP/UnisonOscillator.h"
+#include "DSP/PolyphonicSynthesiser.h"
+#include "DSP/TailGate.h"
+#include "DSP/Oversampler.h"
+#include "DSP/FdnReverb.h"
+#include "DSP/LinkwitzRileyCrossover.h"
+#include "DSP/ParameterChangeQueue.h"
+#include "DSP/NoiseGenerator.h"
+#include "DSP/TuningTable.h"
+#include "DSP/StateVariableFilter.h"
+#include "DSP/VoiceFilterBank.h"
+#include "DSP/FormantFilter.h"
+#include "DSP/ExponentialEnvelope.h"
+#include "DSP/LfoEngine.h"
+#include "DSP/ModulatedDelayLine.h"
+#include "DSP/PartitionedConvolver.h"
+#include "DSP/BiquadCascade.h"
 
 // One-pole smoothing filter for parameter smoothing
 class OnePoleSmoothing
@@ -31,7 +49,14 @@ public:
         current = current + coefficient * (target - current);
         return current;
     }
-    
+
+    // Advances by numSamples at once (same result as numSamples calls to getNextValue)
+    float skip(int numSamples)
+    {
+        current = target + (current - target) * std::pow(1.0f - coefficient, static_cast<float>(numSamples));
+        return current;
+    }
+
     void reset(float initialValue = 0.0f)
     {
         current = initialValue;
@@ -39,6 +64,7 @@ public:
     }
     
     float getCurrentValue() const { return current; }
+    bool isSettled() const { return current == target; }
     
 private:
     void updateTimeConstant()
@@ -87,6 +113,7 @@ public:
     {
         cutoffSmoothing.setSampleRate(44100.0);
         cutoffSmoothing.setTimeConstantMs(10.0f); // 10ms smoothing time
+        allocateCombDelayLines();
         reset();
     }
     
@@ -94,6 +121,8 @@ public:
     {
         sampleRate = newSampleRate;
         cutoffSmoothing.setSampleRate(newSampleRate);
+        allocateCombDelayLines();
+        formantFilter.setSampleRate(newSampleRate);
         updateCoeff();
     }
     
@@ -128,6 +157,20 @@ public:
         updateCoeff();
     }
     
+    // Vowel position of the formant type, from 0 (a) through e, i and o to 4 (u)
+    void setFormantVowel(float vowel)
+    {
+        formantVowel = juce::jlimit(0.0f, static_cast<float>(FormantFilter::numVowels - 1), vowel);
+        updateCoeff();
+    }
+    
+    // Negative comb feedback flips every other echo, so the peaks fall on the odd harmonics
+    void setCombNegative(bool negative)
+    {
+        combNegative = negative;
+        updateCoeff();
+    }
+    
     void setSmoothingTimeMs(float timeMs)
     {
         cutoffSmoothing.setTimeConstantMs(timeMs);
@@ -138,33 +181,56 @@ public:
     FilterType getFilterType() const { return filterType; }
     FilterSlope getFilterSlope() const { return filterSlope; }
     float getResonance() const { return q; }
+    bool getCombNegative() const { return combNegative; }
+    float getFormantVowel() const { return formantVowel; }
     
     void reset()
     {
-        z1 = 0.0f;
-        z2 = 0.0f;
-        z3 = 0.0f;
-        z4 = 0.0f;
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            svfStages[0][ch].reset();
+            svfStages[1][ch].reset();
+            
+            // Clear comb filter delay line
+            std::fill(delayLine[ch].begin(), delayLine[ch].end(), 0.0f);
+        }
+        delayWriteIndex = 0;
+        formantFilter.reset();
         
         // Reset smoothing to current cutoff frequency
         cutoffSmoothing.reset(cutoffFreq);
+    }
+    
+    // Filters a stereo block in place (right may be nullptr for mono).
+    // The cutoff smoothing advances once per sample frame, shared by both channels.
+    void processBlock(float* left, float* right, int numSamples)
+    {
+        if (filterType == OFF)
+            return;
         
-        // Clear comb filter delay line
-        if (!delayLine.empty())
+        // Coefficients only move while the cutoff is gliding; otherwise run each channel in one pass
+        if (cutoffSmoothing.isSettled() && filterType != COMB)
         {
-            std::fill(delayLine.begin(), delayLine.end(), 0.0f);
-            delayIndex = 0;
+            for (int i = 0; i < numSamples; ++i)
+                left[i] = processChannelSample(left[i], 0);
+            
+            if (right != nullptr)
+                for (int i = 0; i < numSamples; ++i)
+                    right[i] = processChannelSample(right[i], 1);
+            return;
         }
         
-        // Clear formant filter state
-        formant1_z1 = 0.0f; formant1_z2 = 0.0f;
-        formant2_z1 = 0.0f; formant2_z2 = 0.0f;
-        formant3_z1 = 0.0f; formant3_z2 = 0.0f;
-    }
-    
-    void processBlock(juce::AudioBuffer<float>& buffer)
-    {
-        // Not used in our implementation
+        for (int i = 0; i < numSamples; ++i)
+        {
+            updateSmoothedCutoff();
+            left[i] = processChannelSample(left[i], 0);
+            if (right != nullptr)
+                right[i] = processChannelSample(right[i], 1);
+            
+            // The comb delay line is shared by both channels and advances once per frame
+            if (filterType == COMB)
+                delayWriteIndex = (delayWriteIndex + 1) & delayLineMask;
+        }
     }
     
     float processSample(float inputSample, int channel)
@@ -173,264 +239,171 @@ public:
             return inputSample;
             
         // Update smoothed cutoff frequency and recalculate coefficients if needed
+        updateSmoothedCutoff();
+        
+        const float output = processChannelSample(inputSample, channel);
+        
+        if (filterType == COMB)
+            delayWriteIndex = (delayWriteIndex + 1) & delayLineMask;
+        
+        return output;
+    }
+    
+    // The lowpass, highpass, bandpass and notch types run on the state-variable core;
+    // its settings are exposed so the voices can run the same filter as SIMD lanes
+    bool usesStateVariableCore() const
+    {
+        return filterType == LOWPASS || filterType == HIGHPASS || filterType == BANDPASS || filterType == NOTCH;
+    }
+    
+    const StateVariableFilter::Coefficients& getStateVariableCoefficients() const { return svfCoefficients; }
+    StateVariableFilter::Mode getStateVariableMode() const { return svfMode; }
+    int getNumStateVariableStages() const { return filterSlope == SLOPE_24DB ? 2 : 1; }
+
+private:
+    void updateSmoothedCutoff()
+    {
         float newCutoffFreq = cutoffSmoothing.getNextValue();
-        if (std::abs(newCutoffFreq - cutoffFreq) > 0.01f) // Very small threshold for smooth updates
+        
+        if (usesStateVariableCore())
+        {
+            // Cheap enough to follow the glide exactly on every sample
+            cutoffFreq = newCutoffFreq;
+            svfCoefficients = StateVariableFilter::makeCoefficients(cutoffFreq / static_cast<float>(sampleRate), q);
+        }
+        else if (filterType == COMB)
+        {
+            // The read position is fractional, so the delay can follow the glide exactly too
+            cutoffFreq = newCutoffFreq;
+            updateCombDelay();
+        }
+        else if (filterType == FORMANT)
+        {
+            // Formant coefficients are table lookups, refreshed at control rate during a glide
+            cutoffFreq = newCutoffFreq;
+            if (++formantControlCounter >= FormantFilter::controlInterval)
+            {
+                formantControlCounter = 0;
+                updateFormant();
+            }
+        }
+        else if (std::abs(newCutoffFreq - cutoffFreq) > 0.01f) // Very small threshold for smooth updates
         {
             cutoffFreq = newCutoffFreq;
             updateCoeff();
         }
-            
+    }
+    
+    // Runs one sample through the state of the given channel (0 = left, 1 = right)
+    float processChannelSample(float inputSample, int channel)
+    {
+        const int ch = channel & 1;
         
         // Handle comb filter separately as it uses a different processing method
         if (filterType == COMB)
         {
-            if (delayLine.empty())
+            if (delayLine[ch].empty())
                 return inputSample;
-                
-            // Read delayed sample from delay line
-            float delayedSample = delayLine[delayIndex];
-            
-            // Comb filter output: input + feedback * delayed
-            float output = inputSample + feedbackGain * delayedSample;
             
-            // Write new sample to delay line
-            delayLine[delayIndex] = inputSample;
+            // Feedback comb: y[n] = x[n] + g * y[n - delay], read with 4-point Hermite interpolation
+            const float* line = delayLine[ch].data();
+            const int base = delayWriteIndex - combDelayInteger;
+            const float ym1 = line[(base + 1) & delayLineMask];
+            const float y0 = line[base & delayLineMask];
+            const float y1 = line[(base - 1) & delayLineMask];
+            const float y2 = line[(base - 2) & delayLineMask];
             
-            // Update delay index (circular buffer)
-            delayIndex = (delayIndex + 1) % delayLineSize;
+            const float t = combDelayFraction;
+            const float c1 = 0.5f * (y1 - ym1);
+            const float c2 = ym1 - 2.5f * y0 + 2.0f * y1 - 0.5f * y2;
+            const float c3 = 0.5f * (y2 - ym1) + 1.5f * (y0 - y1);
+            const float delayedSample = ((c3 * t + c2) * t + c1) * t + y0;
             
+            const float output = inputSample + feedbackGain * delayedSample;
+            delayLine[ch][static_cast<size_t>(delayWriteIndex)] = output;
             
-            return output;
+            // The resonant peaks reach 1 / (1 - |g|); scale them back to unity
+            return output * combOutputGain;
         }
         
-        // Handle formant filter separately as it uses multiple parallel bandpass filters
+        // Three formant bandpasses, stepped together as SIMD lanes
         if (filterType == FORMANT)
-        {
-            // Process through 3 parallel bandpass filters (formants)
-            // Formant 1
-            float f1_output = inputSample * formant1_a0 + formant1_z1;
-            formant1_z1 = inputSample * formant1_a1 + formant1_z2 - formant1_b1 * f1_output;
-            formant1_z2 = inputSample * formant1_a2 - formant1_b2 * f1_output;
-            
-            // Formant 2
-            float f2_output = inputSample * formant2_a0 + formant2_z1;
-            formant2_z1 = inputSample * formant2_a1 + formant2_z2 - formant2_b1 * f2_output;
-            formant2_z2 = inputSample * formant2_a2 - formant2_b2 * f2_output;
-            
-            // Formant 3
-            float f3_output = inputSample * formant3_a0 + formant3_z1;
-            formant3_z1 = inputSample * formant3_a1 + formant3_z2 - formant3_b1 * f3_output;
-            formant3_z2 = inputSample * formant3_a2 - formant3_b2 * f3_output;
-            
-            // Mix the three formants with emphasis on lower formants
-            float output = f1_output * 0.5f + f2_output * 0.35f + f3_output * 0.15f;
-            
-            
-            return output;
-        }
+            return formantFilter.processSample(inputSample, ch);
         
-        if (filterSlope == SLOPE_12DB)
-        {
-            // Single 12dB stage
-            float output = inputSample * a0 + z1;
-            
-            // Update delay line
-            z1 = inputSample * a1 + z2 - b1 * output;
-            z2 = inputSample * a2 - b2 * output;
-            
-            
-            return output;
-        }
-        else // SLOPE_24DB
-        {
-            // First 12dB stage
-            float stage1 = inputSample * a0 + z1;
-            z1 = inputSample * a1 + z2 - b1 * stage1;
-            z2 = inputSample * a2 - b2 * stage1;
-            
-            // Second 12dB stage (cascaded)
-            float output = stage1 * a0 + z3;
-            z3 = stage1 * a1 + z4 - b1 * output;
-            z4 = stage1 * a2 - b2 * output;
-            
-            
-            return output;
-        }
+        // 12dB is one state-variable stage, 24dB cascades a second with the same settings
+        float output = svfStages[0][ch].processSample(inputSample, svfCoefficients, svfMode);
+        if (filterSlope == SLOPE_24DB)
+            output = svfStages[1][ch].processSample(output, svfCoefficients, svfMode);
+        
+        return output;
     }
-
-private:
+    
+    // The delay lines cover the longest comb delay at this sample rate, so sweeping the
+    // delay never allocates; they are only resized when the sample rate changes
+    void allocateCombDelayLines()
+    {
+        const int longestDelay = static_cast<int>(std::ceil(sampleRate * maxCombDelaySeconds)) + 4;
+        const auto size = static_cast<size_t>(juce::nextPowerOfTwo(longestDelay));
+        
+        if (delayLine[0].size() == size)
+            return;
+        
+        for (auto& line : delayLine)
+            line.assign(size, 0.0f);
+        
+        delayLineMask = static_cast<int>(size) - 1;
+        delayWriteIndex = 0;
+    }
+    
+    // The cutoff shifts every formant, with 1 kHz leaving the vowel at its natural pitch;
+    // resonance sharpens the bands from Q 4 to Q 20
+    void updateFormant()
+    {
+        const float formantQ = 4.0f + (q - 0.707f) / 19.293f * 16.0f;
+        formantFilter.setParameters(formantVowel, cutoffFreq / 1000.0f, formantQ);
+    }
+    
+    // One period of the cutoff, from 3 samples (room for the interpolator) to 50ms
+    void updateCombDelay()
+    {
+        const float longestDelay = static_cast<float>(sampleRate * maxCombDelaySeconds);
+        const float delaySamples = juce::jlimit(3.0f, longestDelay, static_cast<float>(sampleRate) / cutoffFreq);
+        combDelayInteger = static_cast<int>(delaySamples);
+        combDelayFraction = delaySamples - static_cast<float>(combDelayInteger);
+    }
+    
     void updateCoeff()
     {
         if (filterType == OFF)
-        {
-            a0 = 1.0f; a1 = 0.0f; a2 = 0.0f;
-            b1 = 0.0f; b2 = 0.0f;
             return;
-        }
         
-        // Standard 12dB/octave filter design with Q factor
-        float omega = 2.0f * juce::MathConstants<float>::pi * cutoffFreq / static_cast<float>(sampleRate);
-        omega = juce::jlimit(0.001f, juce::MathConstants<float>::pi * 0.99f, omega); // Prevent extreme values
-        float c = 1.0f / std::tan(omega * 0.5f);
-        float cSq = c * c;
-        float safeQ = juce::jlimit(0.5f, 3.0f, q); // Conservative Q range for stability
-        float cQ = c / safeQ;
-        
-        if (filterType == LOWPASS)
-        {
-            // 12dB/octave low-pass coefficients with Q
-            float norm = 1.0f / (1.0f + cQ + cSq);
-            a0 = norm;
-            a1 = 2.0f * a0;
-            a2 = a0;
-            b1 = 2.0f * (1.0f - cSq) * norm;
-            b2 = (1.0f - cQ + cSq) * norm;
-        }
-        else if (filterType == HIGHPASS)
-        {
-            // 12dB/octave high-pass coefficients with Q
-            float norm = 1.0f / (1.0f + cQ + cSq);
-            a0 = cSq * norm;
-            a1 = -2.0f * a0;
-            a2 = a0;
-            b1 = 2.0f * (1.0f - cSq) * norm;
-            b2 = (1.0f - cQ + cSq) * norm;
-        }
-        else if (filterType == BANDPASS)
+        if (usesStateVariableCore())
         {
-            // 12dB/octave band-pass coefficients with Q
-            float norm = 1.0f / (1.0f + cQ + cSq);
-            a0 = cQ * norm;
-            a1 = 0.0f;
-            a2 = -a0;
-            b1 = 2.0f * (1.0f - cSq) * norm;
-            b2 = (1.0f - cQ + cSq) * norm;
-        }
-        else if (filterType == NOTCH)
-        {
-            // 12dB/octave notch (band-reject) coefficients with Q
-            float norm = 1.0f / (1.0f + cQ + cSq);
-            a0 = (1.0f + cSq) * norm;
-            a1 = 2.0f * (1.0f - cSq) * norm;
-            a2 = a0;
-            b1 = a1; // Same as a1 for notch
-            b2 = (1.0f - cQ + cSq) * norm;
-        }
-        else if (filterType == COMB)
-        {
-            // Comb filter setup - uses delay line instead of biquad coefficients
-            // Calculate delay time in samples based on cutoff frequency
-            float delayTimeMs = 1000.0f / cutoffFreq; // Convert frequency to period in ms
-            int newDelaySize = static_cast<int>(delayTimeMs * sampleRate / 1000.0f);
-            
-            // Clamp delay size to reasonable range (1ms to 50ms)
-            newDelaySize = juce::jlimit(static_cast<int>(sampleRate * 0.001f), 
-                                       static_cast<int>(sampleRate * 0.05f), 
-                                       newDelaySize);
-            
-            // Only resize if delay size changed
-            if (newDelaySize != delayLineSize)
+            switch (filterType)
             {
-                delayLineSize = newDelaySize;
-                delayLine.resize(delayLineSize);
-                std::fill(delayLine.begin(), delayLine.end(), 0.0f);
-                delayIndex = 0;
+                case HIGHPASS: svfMode = StateVariableFilter::HIGHPASS; break;
+                case BANDPASS: svfMode = StateVariableFilter::BANDPASS; break;
+                case NOTCH:    svfMode = StateVariableFilter::NOTCH; break;
+                default:       svfMode = StateVariableFilter::LOWPASS; break;
             }
             
-            // Set feedback gain based on Q factor (resonance)
-            // Higher Q = more feedback = more resonance, but keep very conservative
-            feedbackGain = juce::jlimit(0.0f, 0.5f, (safeQ - 0.707f) / 1.293f * 0.4f);
-            
-            // Clear biquad coefficients for comb filter
-            a0 = 1.0f; a1 = 0.0f; a2 = 0.0f;
-            b1 = 0.0f; b2 = 0.0f;
+            svfCoefficients = StateVariableFilter::makeCoefficients(cutoffFreq / static_cast<float>(sampleRate), q);
             return;
         }
-        else if (filterType == FORMANT)
+        
+        if (filterType == COMB)
         {
-            // Formant filter setup - 3 parallel bandpass filters for vowel simulation
-            // Cutoff frequency controls the vowel character by shifting formant frequencies
-            
-            // Base formant frequencies for /a/ vowel (can be modulated by cutoff)
-            float formantShift = cutoffFreq / 1000.0f; // Normalize around 1000Hz
-            float f1_freq = 730.0f * formantShift;  // First formant
-            float f2_freq = 1090.0f * formantShift; // Second formant
-            float f3_freq = 2440.0f * formantShift; // Third formant
-            
-            // Clamp formant frequencies to reasonable range
-            f1_freq = juce::jlimit(200.0f, static_cast<float>(sampleRate * 0.4f), f1_freq);
-            f2_freq = juce::jlimit(400.0f, static_cast<float>(sampleRate * 0.4f), f2_freq);
-            f3_freq = juce::jlimit(800.0f, static_cast<float>(sampleRate * 0.4f), f3_freq);
-            
-            // Calculate bandpass coefficients for each formant
-            // Using moderate Q for realistic vowel formants
-            float formantQ = 4.0f + (q - 0.707f) / 19.293f * 16.0f; // Q range: 4-20
-            
-            // Formant 1 coefficients
-            {
-                float omega = 2.0f * juce::MathConstants<float>::pi * f1_freq / static_cast<float>(sampleRate);
-                float c = 1.0f / std::tan(omega * 0.5f);
-                float cSq = c * c;
-                float cQ = c / formantQ;
-                float norm = 1.0f / (1.0f + cQ + cSq);
-                formant1_a0 = cQ * norm;
-                formant1_a1 = 0.0f;
-                formant1_a2 = -formant1_a0;
-                formant1_b1 = 2.0f * (1.0f - cSq) * norm;
-                formant1_b2 = (1.0f - cQ + cSq) * norm;
-            }
-            
-            // Formant 2 coefficients
-            {
-                float omega = 2.0f * juce::MathConstants<float>::pi * f2_freq / static_cast<float>(sampleRate);
-                float c = 1.0f / std::tan(omega * 0.5f);
-                float cSq = c * c;
-                float cQ = c / formantQ;
-                float norm = 1.0f / (1.0f + cQ + cSq);
-                formant2_a0 = cQ * norm;
-                formant2_a1 = 0.0f;
-                formant2_a2 = -formant2_a0;
-                formant2_b1 = 2.0f * (1.0f - cSq) * norm;
-                formant2_b2 = (1.0f - cQ + cSq) * norm;
-            }
-            
-            // Formant 3 coefficients
-            {
-                float omega = 2.0f * juce::MathConstants<float>::pi * f3_freq / static_cast<float>(sampleRate);
-                float c = 1.0f / std::tan(omega * 0.5f);
-                float cSq = c * c;
-                float cQ = c / formantQ;
-                float norm = 1.0f / (1.0f + cQ + cSq);
-                formant3_a0 = cQ * norm;
-                formant3_a1 = 0.0f;
-                formant3_a2 = -formant3_a0;
-                formant3_b1 = 2.0f * (1.0f - cSq) * norm;
-                formant3_b2 = (1.0f - cQ + cSq) * norm;
-            }
-            
-            // Clamp formant coefficients
-            formant1_a0 = juce::jlimit(-2.0f, 2.0f, formant1_a0);
-            formant1_a2 = juce::jlimit(-2.0f, 2.0f, formant1_a2);
-            formant1_b1 = juce::jlimit(-1.99f, 1.99f, formant1_b1);
-            formant1_b2 = juce::jlimit(-1.99f, 1.99f, formant1_b2);
-            
-            formant2_a0 = juce::jlimit(-2.0f, 2.0f, formant2_a0);
-            formant2_a2 = juce::jlimit(-2.0f, 2.0f, formant2_a2);
-            formant2_b1 = juce::jlimit(-1.99f, 1.99f, formant2_b1);
-            formant2_b2 = juce::jlimit(-1.99f, 1.99f, formant2_b2);
-            
-            formant3_a0 = juce::jlimit(-2.0f, 2.0f, formant3_a0);
-            formant3_a2 = juce::jlimit(-2.0f, 2.0f, formant3_a2);
-            formant3_b1 = juce::jlimit(-1.99f, 1.99f, formant3_b1);
-            formant3_b2 = juce::jlimit(-1.99f, 1.99f, formant3_b2);
-            
-            // Clear main biquad coefficients for formant filter
-            a0 = 1.0f; a1 = 0.0f; a2 = 0.0f;
-            b1 = 0.0f; b2 = 0.0f;
+            // Feedback grows with Q from none at 0.707 to 0.95 at Q 2, the top of the resonance knob
+            const float amount = juce::jlimit(0.0f, 0.95f, (q - 0.707f) / 1.293f * 0.95f);
+            feedbackGain = combNegative ? -amount : amount;
+            combOutputGain = 1.0f - amount;
+            updateCombDelay();
             return;
         }
-        
-        // Coefficients should be stable due to conservative Q range and omega limiting
+        else if (filterType == FORMANT)
+        {
+            updateFormant();
+        }
     }
     
     double sampleRate = 44100.0;
@@ -439,38 +412,38 @@ private:
     FilterType filterType = OFF;
     FilterSlope filterSlope = SLOPE_12DB;
     
-    // Filter coefficients
-    float a0 = 1.0f, a1 = 0.0f, a2 = 0.0f;
-    float b1 = 0.0f, b2 = 0.0f;
-    
-    // State variables (z3, z4 for 24dB filters)
-    float z1 = 0.0f, z2 = 0.0f, z3 = 0.0f, z4 = 0.0f;
+    // Lowpass, highpass, bandpass and notch: [stage][channel], stage 1 only runs at 24dB
+    StateVariableFilter svfStages[2][2];
+    StateVariableFilter::Coefficients svfCoefficients;
+    StateVariableFilter::Mode svfMode = StateVariableFilter::LOWPASS;
     
     // One-pole smoothing for cutoff frequency
     OnePoleSmoothing cutoffSmoothing;
     
-    // Comb filter delay line
-    std::vector<float> delayLine;
-    int delayLineSize = 0;
-    int delayIndex = 0;
+    // Comb filter delay lines (one per channel, sharing the write index), a power of two long
+    static constexpr double maxCombDelaySeconds = 0.05;
+    std::vector<float> delayLine[2];
+    int delayLineMask = 0;
+    int delayWriteIndex = 0;
+    int combDelayInteger = 3;
+    float combDelayFraction = 0.0f;
     float feedbackGain = 0.0f;
+    float combOutputGain = 1.0f;
+    bool combNegative = false;
     
-    // Formant filter state (3 parallel bandpass filters for vowel formants)
-    float formant1_z1 = 0.0f, formant1_z2 = 0.0f;
-    float formant2_z1 = 0.0f, formant2_z2 = 0.0f;
-    float formant3_z1 = 0.0f, formant3_z2 = 0.0f;
-    float formant1_a0 = 1.0f, formant1_a1 = 0.0f, formant1_a2 = 0.0f;
-    float formant1_b1 = 0.0f, formant1_b2 = 0.0f;
-    float formant2_a0 = 1.0f, formant2_a1 = 0.0f, formant2_a2 = 0.0f;
-    float formant2_b1 = 0.0f, formant2_b2 = 0.0f;
-    float formant3_a0 = 1.0f, formant3_a1 = 0.0f, formant3_a2 = 0.0f;
-    float formant3_b1 = 0.0f, formant3_b2 = 0.0f;
+    // Vowel formant filter; the vowel position runs from 0 (a) to 4 (u)
+    FormantFilter formantFilter;
+    float formantVowel = 0.0f;
+    int formantControlCounter = 0;
 };
 
 // Dynamics compressor with optional multiband processing
 class CompressorEffect
 {
 public:
+    // Detector, gain computer and envelope coefficients run once per control block
+    static constexpr int controlBlockSize = 16;
+    
     CompressorEffect()
     {
         reset();
@@ -499,28 +472,23 @@ public:
         mixSmoothing.setSampleRate(sampleRate);
         mixSmoothing.setTimeConstantMs(20.0f);
         
-        // Initialize RMS buffers (10ms window)
-        int rmsBufferSize = static_cast<int>(sampleRate * 0.01);
-        rmsBuffer[0].resize(rmsBufferSize, 0.0f);
-        rmsBuffer[1].resize(rmsBufferSize, 0.0f);
-        rmsBufferSize_ = rmsBufferSize;
+        // Initialize RMS windows (10ms)
+        rmsWindowSize = juce::jmax(1, static_cast<int>(sampleRate * 0.01));
+        singleBand.prepare(rmsWindowSize);
+        for (auto& band : bands)
+            band.prepare(rmsWindowSize);
         
-        // Initialize multiband RMS buffers
-        rmsBufferLow[0].resize(rmsBufferSize, 0.0f);
-        rmsBufferLow[1].resize(rmsBufferSize, 0.0f);
-        rmsBufferMid[0].resize(rmsBufferSize, 0.0f);
-        rmsBufferMid[1].resize(rmsBufferSize, 0.0f);
-        rmsBufferHigh[0].resize(rmsBufferSize, 0.0f);
-        rmsBufferHigh[1].resize(rmsBufferSize, 0.0f);
-        
-        // Initialize 3-band crossover filters for multiband processing
-        initializeCrossoverFilters();
+        // Initialize 3-band crossovers for multiband processing: 200Hz and 2kHz
+        lowCrossover.prepare(sampleRate, 200.0f);
+        highCrossover.prepare(sampleRate, 2000.0f);
+        lowPhaseCompensation.prepare(sampleRate, 2000.0f);
         
         // Reset all processing state to safe defaults
         reset();
     }
     
     void setEnabled(bool enabled) { isEnabled = enabled; }
+    bool getEnabled() const { return isEnabled; }
     void setThreshold(float thresholdDb) { 
         threshold = juce::jlimit(-60.0f, 0.0f, thresholdDb);
         thresholdSmoothing.setTarget(threshold);
@@ -547,63 +515,25 @@ public:
     }
     void setMultiband(bool enabled) { multibandEnabled = enabled; }
     
+    // Silence in gives silence out; the tail only covers the gain recovering after release
+    // (the multiband low band releases 1.2x slower)
+    double getTailLengthSeconds() const
+    {
+        if (!isEnabled)
+            return 0.0;
+        return 0.01 + release * (multibandEnabled ? 0.0012 : 0.001);
+    }
+    
     void reset()
     {
-        // Clear RMS buffers and reset all state
-        for (int ch = 0; ch < 2; ++ch)
-        {
-            std::fill(rmsBuffer[ch].begin(), rmsBuffer[ch].end(), 0.0f);
-            std::fill(rmsBufferLow[ch].begin(), rmsBufferLow[ch].end(), 0.0f);
-            std::fill(rmsBufferMid[ch].begin(), rmsBufferMid[ch].end(), 0.0f);
-            std::fill(rmsBufferHigh[ch].begin(), rmsBufferHigh[ch].end(), 0.0f);
-            
-            rmsIndex[ch] = 0;
-            rmsIndexLow[ch] = 0;
-            rmsIndexMid[ch] = 0;
-            rmsIndexHigh[ch] = 0;
-            
-            rmsSum[ch] = 0.0f;
-            rmsSumLow[ch] = 0.0f;
-            rmsSumMid[ch] = 0.0f;
-            rmsSumHigh[ch] = 0.0f;
-            
-            gainReduction[ch] = 1.0f;
-            gainReductionLow[ch] = 1.0f;
-            gainReductionMid[ch] = 1.0f;
-            gainReductionHigh[ch] = 1.0f;
-        }
-        
-        // Reset parameter smoothing
-        thresholdSmoothing.reset();
-        ratioSmoothing.reset();
-        attackSmoothing.reset();
-        releaseSmoothing.reset();
-        makeupGainSmoothing.reset();
-        mixSmoothing.reset();
-        for (int ch = 0; ch < 2; ++ch)
-        {
-            if (!rmsBuffer[ch].empty())
-                std::fill(rmsBuffer[ch].begin(), rmsBuffer[ch].end(), 0.0f);
-            rmsIndex[ch] = 0;
-            rmsSum[ch] = 0.0f;
-            
-            // Clear multiband RMS buffers
-            if (!rmsBufferLow[ch].empty())
-                std::fill(rmsBufferLow[ch].begin(), rmsBufferLow[ch].end(), 0.0f);
-            if (!rmsBufferMid[ch].empty())
-                std::fill(rmsBufferMid[ch].begin(), rmsBufferMid[ch].end(), 0.0f);
-            if (!rmsBufferHigh[ch].empty())
-                std::fill(rmsBufferHigh[ch].begin(), rmsBufferHigh[ch].end(), 0.0f);
-            
-            rmsIndexLow[ch] = rmsIndexMid[ch] = rmsIndexHigh[ch] = 0;
-            rmsSumLow[ch] = rmsSumMid[ch] = rmsSumHigh[ch] = 0.0f;
-        }
+        // Clear RMS windows and envelope followers
+        singleBand.reset();
+        for (auto& band : bands)
+            band.reset();
         
-        // Reset envelope followers
-        gainReduction[0] = gainReduction[1] = 1.0f;
-        gainReductionLow[0] = gainReductionLow[1] = 1.0f;
-        gainReductionMid[0] = gainReductionMid[1] = 1.0f;
-        gainReductionHigh[0] = gainReductionHigh[1] = 1.0f;
+        lowCrossover.reset();
+        highCrossover.reset();
+        lowPhaseCompensation.reset();
         
         // Reset smoothing
         thresholdSmoothing.reset(threshold);
@@ -612,6 +542,11 @@ public:
         releaseSmoothing.reset(release);
         makeupGainSmoothing.reset(makeupGain);
         mixSmoothing.reset(wetMix);
+        
+        // Force the envelope coefficients to be recomputed on the next block
+        lastAttack = lastRelease = -1.0f;
+        lastMakeupGain = makeupGain;
+        makeupGainLinear = previousMakeupGainLinear = juce::Decibels::decibelsToGain(makeupGain);
     }
     
     void processBlock(juce::AudioBuffer<float>& buffer)
@@ -623,314 +558,294 @@ public:
         const int numChannels = juce::jmin(buffer.getNumChannels(), 2);
         
         // Additional safety checks
-        if (numSamples <= 0 || numChannels <= 0 || rmsBufferSize_ <= 0)
+        if (numSamples <= 0 || numChannels <= 0 || rmsWindowSize <= 0)
             return;
+        
+        for (int start = 0; start < numSamples; start += controlBlockSize)
+        {
+            const int n = juce::jmin(controlBlockSize, numSamples - start);
+            updateControlBlock(n);
             
-        // Temporarily disable multiband to isolate the issue
-        if (false && multibandEnabled) // Force disable multiband for debugging
+            if (multibandEnabled)
+                processMultiband(buffer, start, n, numChannels);
+            else
+                processSingleband(buffer, start, n, numChannels);
+        }
+    }
+    
+private:
+    // Threshold, ratio and envelope decay for one band. The target gain is fixed for a
+    // control block, so the envelope is target + (start - target) * coeff^(i + 1); the
+    // powers are tabulated whenever attack or release move.
+    struct BandSettings
+    {
+        float threshold = 0.0f;
+        float ratio = 1.0f;
+        float attackPowers[controlBlockSize] = {};
+        float releasePowers[controlBlockSize] = {};
+    };
+    
+    // RMS detector and gain envelope for one band, per channel
+    struct BandState
+    {
+        void prepare(int windowSize)
         {
-            processMultiband(buffer, numSamples, numChannels);
+            for (auto& window : squares)
+                window.assign(static_cast<size_t>(windowSize), 0.0f);
+            reset();
         }
-        else
+        
+        void reset()
         {
-            processSingleband(buffer, numSamples, numChannels);
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                std::fill(squares[ch].begin(), squares[ch].end(), 0.0f);
+                index[ch] = 0;
+                sum[ch] = 0.0f;
+                gain[ch] = 1.0f;
+            }
+        }
+        
+        std::vector<float> squares[2]; // Squared samples in the RMS window
+        int index[2] = {0, 0};
+        float sum[2] = {0.0f, 0.0f};
+        float gain[2] = {1.0f, 1.0f};   // Linear gain applied by the envelope follower
+    };
+    
+    enum Band
+    {
+        LOW_BAND = 0,
+        MID_BAND,
+        HIGH_BAND,
+        NUM_BANDS
+    };
+    
+    void setEnvelopeTimes(BandSettings& settings, float attackMs, float releaseMs) const
+    {
+        const float attackCoeff = std::exp(-1.0f / (attackMs * 0.001f * static_cast<float>(sampleRate)));
+        const float releaseCoeff = std::exp(-1.0f / (releaseMs * 0.001f * static_cast<float>(sampleRate)));
+        
+        float attackPower = 1.0f, releasePower = 1.0f;
+        for (int i = 0; i < controlBlockSize; ++i)
+        {
+            attackPower *= attackCoeff;
+            releasePower *= releaseCoeff;
+            settings.attackPowers[i] = attackPower;
+            settings.releasePowers[i] = releasePower;
         }
     }
     
-private:
-    void processSingleband(juce::AudioBuffer<float>& buffer, int numSamples, int numChannels)
+    // Advances the smoothers by one control block and recomputes anything that moved
+    void updateControlBlock(int numSamples)
     {
-        for (int sample = 0; sample < numSamples; ++sample)
+        const float currentThreshold = thresholdSmoothing.skip(numSamples);
+        const float currentRatio = ratioSmoothing.skip(numSamples);
+        const float currentAttack = attackSmoothing.skip(numSamples);
+        const float currentRelease = releaseSmoothing.skip(numSamples);
+        const float currentMakeupGain = makeupGainSmoothing.skip(numSamples);
+        
+        if (currentAttack != lastAttack || currentRelease != lastRelease)
         {
-            // Get smoothed parameters
-            float currentThreshold = thresholdSmoothing.getNextValue();
-            float currentRatio = ratioSmoothing.getNextValue();
-            float currentAttack = attackSmoothing.getNextValue();
-            float currentRelease = releaseSmoothing.getNextValue();
-            float currentMakeupGain = makeupGainSmoothing.getNextValue();
-            float currentMix = mixSmoothing.getNextValue();
+            lastAttack = currentAttack;
+            lastRelease = currentRelease;
             
-            // Calculate envelope coefficients
-            float attackCoeff = std::exp(-1.0f / (currentAttack * 0.001f * static_cast<float>(sampleRate)));
-            float releaseCoeff = std::exp(-1.0f / (currentRelease * 0.001f * static_cast<float>(sampleRate)));
+            setEnvelopeTimes(singleBandSettings, currentAttack, currentRelease);
             
-            for (int ch = 0; ch < numChannels; ++ch)
-            {
-                float inputSample = buffer.getSample(ch, sample);
-                float drySample = inputSample;
-                
-                float compressedSample = compressSample(inputSample, currentThreshold, currentRatio, 
-                                                       attackCoeff, releaseCoeff, ch, 
-                                                       rmsBuffer[ch], rmsIndex[ch], rmsSum[ch], gainReduction[ch]);
-                
-                // Apply makeup gain
-                float makeupGainLinear = std::pow(10.0f, currentMakeupGain / 20.0f);
-                compressedSample *= makeupGainLinear;
-                
-                // Mix dry and wet (parallel compression)
-                float outputSample = drySample * (1.0f - currentMix) + compressedSample * currentMix;
-                
-                buffer.setSample(ch, sample, outputSample);
-            }
+            // OTT-style timing: faster attacks everywhere, slower release on the low band
+            setEnvelopeTimes(bandSettings[LOW_BAND], currentAttack * 0.5f, currentRelease * 1.2f);
+            setEnvelopeTimes(bandSettings[MID_BAND], currentAttack * 0.4f, currentRelease);
+            setEnvelopeTimes(bandSettings[HIGH_BAND], currentAttack * 0.8f, currentRelease);
+        }
+        
+        singleBandSettings.threshold = currentThreshold;
+        singleBandSettings.ratio = currentRatio;
+        
+        // Low band: very aggressive for that signature OTT bass punch
+        bandSettings[LOW_BAND].threshold = currentThreshold - 8.0f;
+        bandSettings[LOW_BAND].ratio = juce::jmax(4.0f, currentRatio * 1.8f);
+        // Mid band: aggressive for vocal/instrument clarity (OTT's strength)
+        bandSettings[MID_BAND].threshold = currentThreshold - 3.0f;
+        bandSettings[MID_BAND].ratio = juce::jmax(3.0f, currentRatio * 1.2f);
+        // High band: moderate but present compression for sparkle
+        bandSettings[HIGH_BAND].threshold = currentThreshold + 2.0f;
+        bandSettings[HIGH_BAND].ratio = juce::jmax(2.0f, currentRatio * 0.9f);
+        
+        // Makeup gain ramps linearly from the previous block's value
+        previousMakeupGainLinear = makeupGainLinear;
+        if (currentMakeupGain != lastMakeupGain)
+        {
+            lastMakeupGain = currentMakeupGain;
+            makeupGainLinear = juce::Decibels::decibelsToGain(currentMakeupGain);
         }
     }
     
-    void processMultiband(juce::AudioBuffer<float>& buffer, int numSamples, int numChannels)
+    void processSingleband(juce::AudioBuffer<float>& buffer, int start, int numSamples, int numChannels)
     {
-        for (int sample = 0; sample < numSamples; ++sample)
+        for (int ch = 0; ch < numChannels; ++ch)
         {
-            // Get smoothed parameters
-            float currentThreshold = thresholdSmoothing.getNextValue();
-            float currentRatio = ratioSmoothing.getNextValue();
-            float currentAttack = attackSmoothing.getNextValue();
-            float currentRelease = releaseSmoothing.getNextValue();
-            float currentMakeupGain = makeupGainSmoothing.getNextValue();
-            float currentMix = mixSmoothing.getNextValue();
+            const float* input = buffer.getReadPointer(ch, start);
+            std::copy(input, input + numSamples, wet[ch]);
+            compressBand(singleBand, ch, wet[ch], numSamples, singleBandSettings);
+        }
+        
+        applyMakeupAndMix(buffer, start, numSamples, numChannels);
+    }
+    
+    void processMultiband(juce::AudioBuffer<float>& buffer, int start, int numSamples, int numChannels)
+    {
+        // Split into phase-coherent bands; the low band gets the 2kHz allpass the others went through.
+        // Both channels run in the same loop so their filter feedback chains overlap.
+        const float* input[2] = { buffer.getReadPointer(0, start), buffer.getReadPointer(numChannels - 1, start) };
+        
+        for (int i = 0; i < numSamples; ++i)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                float low, rest, mid, high;
+                lowCrossover.processSample(input[ch][i], ch, low, rest);
+                highCrossover.processSample(rest, ch, mid, high);
+                bandBuffers[LOW_BAND][ch][i] = lowPhaseCompensation.processAllPassSample(low, ch);
+                bandBuffers[MID_BAND][ch][i] = mid;
+                bandBuffers[HIGH_BAND][ch][i] = high;
+            }
+        }
+        
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            for (int band = 0; band < NUM_BANDS; ++band)
+                compressBand(bands[band], ch, bandBuffers[band][ch], numSamples, bandSettings[band]);
             
-            // Calculate envelope coefficients
-            float attackCoeff = std::exp(-1.0f / (currentAttack * 0.001f * static_cast<float>(sampleRate)));
-            float releaseCoeff = std::exp(-1.0f / (currentRelease * 0.001f * static_cast<float>(sampleRate)));
+            const float* low = bandBuffers[LOW_BAND][ch];
+            const float* mid = bandBuffers[MID_BAND][ch];
+            const float* high = bandBuffers[HIGH_BAND][ch];
+            float* output = wet[ch];
             
-            for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
             {
-                float inputSample = buffer.getSample(ch, sample);
-                float drySample = inputSample;
-                
-                // Split into frequency bands
-                float lowBand = inputSample;
-                lowBand = lowBandFilter[ch][0].processSample(lowBand, ch);
-                lowBand = lowBandFilter[ch][1].processSample(lowBand, ch);
-                
-                float midBand = inputSample;
-                midBand = midBandFilterHP[ch][0].processSample(midBand, ch);
-                midBand = midBandFilterHP[ch][1].processSample(midBand, ch);
-                midBand = midBandFilterLP[ch][0].processSample(midBand, ch);
-                midBand = midBandFilterLP[ch][1].processSample(midBand, ch);
-                
-                float highBand = inputSample;
-                highBand = highBandFilter[ch][0].processSample(highBand, ch);
-                highBand = highBandFilter[ch][1].processSample(highBand, ch);
-                
-                // OTT-style per-band processing with more aggressive characteristics
-                // Low band: Very aggressive for that signature OTT bass punch
-                float lowThreshold = currentThreshold - 8.0f; // More compression
-                float lowRatio = juce::jmax(4.0f, currentRatio * 1.8f); // Much higher ratio, minimum 4:1
-                float compressedLow = compressSample(lowBand, lowThreshold, lowRatio,
-                                                   attackCoeff * 0.5f, releaseCoeff * 1.2f, ch, // Faster attack, slower release
-                                                   rmsBufferLow[ch], rmsIndexLow[ch], rmsSumLow[ch], gainReductionLow[ch]);
-                
-                // Mid band: Aggressive for vocal/instrument clarity (OTT's strength)
-                float midThreshold = currentThreshold - 3.0f; // More sensitive
-                float midRatio = juce::jmax(3.0f, currentRatio * 1.2f); // Higher ratio, minimum 3:1
-                float compressedMid = compressSample(midBand, midThreshold, midRatio,
-                                                   attackCoeff * 0.4f, releaseCoeff, ch, // Very fast attack
-                                                   rmsBufferMid[ch], rmsIndexMid[ch], rmsSumMid[ch], gainReductionMid[ch]);
+                // Conservative band balancing (no boosts to prevent gain stacking)
+                float compressedSample = low[i] * 0.95f + mid[i] + high[i] * 0.98f;
                 
-                // High band: Moderate but present compression for sparkle
-                float highThreshold = currentThreshold + 2.0f; // Still gentler but more active
-                float highRatio = juce::jmax(2.0f, currentRatio * 0.9f); // Moderate ratio, minimum 2:1
-                float compressedHigh = compressSample(highBand, highThreshold, highRatio,
-                                                    attackCoeff * 0.8f, releaseCoeff, ch, // Medium-fast attack
-                                                    rmsBufferHigh[ch], rmsIndexHigh[ch], rmsSumHigh[ch], gainReductionHigh[ch]);
+                // 12dB cut before saturation so the limiter is not hit too hard
+                compressedSample *= 0.25118864f;
                 
-                // Apply conservative band balancing (no boosts to prevent gain stacking)
-                compressedLow *= 0.95f;   // Slight reduction to prevent bass buildup
-                compressedMid *= 1.0f;    // Keep mids neutral 
-                compressedHigh *= 0.98f;  // Slight high reduction
-                
-                // Sum the compressed bands with safety checks
-                float compressedSample = compressedLow + compressedMid + compressedHigh;
-                
-                // Safety check after band summing
-                if (!std::isfinite(compressedSample) || std::abs(compressedSample) > 100.0f)
+                // OTT-style harmonic saturation
+                if (std::abs(compressedSample) > 0.005f)
                 {
-                    compressedSample = 0.0f; // Return silence if something went wrong
+                    const float saturation = 0.08f;
+                    compressedSample = fastTanh(compressedSample * (1.0f + saturation)) / (1.0f + saturation);
                 }
-                else
-                {
-                    // Apply gain cut early in chain to prevent saturation/limiting from being hit too hard
-                    float gainCutEarly = std::pow(10.0f, -12.0f / 20.0f); // 12dB cut before saturation
-                    compressedSample *= gainCutEarly;
-                    
-                    // Add OTT-style harmonic saturation
-                    if (std::abs(compressedSample) > 0.005f)
-                    {
-                        float saturation = 0.08f; // More noticeable saturation for OTT character
-                        compressedSample = std::tanh(compressedSample * (1.0f + saturation)) / (1.0f + saturation);
-                    }
-                    
-                    // Soft limiting with OTT-style characteristics
-                    compressedSample = std::tanh(compressedSample * 0.9f) * 0.9f;
-                    
-                    // Apply additional 6dB cut after processing (total 18dB with early cut)
-                    float gainCutLate = std::pow(10.0f, -6.0f / 20.0f); // Additional 6dB cut
-                    compressedSample *= gainCutLate;
-                    
-                    // Final safety check
-                    if (!std::isfinite(compressedSample))
-                    {
-                        compressedSample = 0.0f;
-                    }
-                }
-                
-                // Apply makeup gain
-                float makeupGainLinear = std::pow(10.0f, currentMakeupGain / 20.0f);
-                compressedSample *= makeupGainLinear;
-                
-                // Mix dry and wet (parallel compression)
-                float outputSample = drySample * (1.0f - currentMix) + compressedSample * currentMix;
                 
-                buffer.setSample(ch, sample, outputSample);
+                // Soft limiting, then a further 6dB cut (18dB in total)
+                output[i] = fastTanh(compressedSample * 0.9f) * 0.9f * 0.50118723f;
             }
         }
+        
+        applyMakeupAndMix(buffer, start, numSamples, numChannels);
     }
     
-    float compressSample(float inputSample, float threshold, float ratio, 
-                        float attackCoeff, float releaseCoeff, int channel,
-                        std::vector<float>& rmsBuffer, int& rmsIndex, float& rmsSum, float& gainReduction)
+    // Runs one channel of one band through its detector and envelope, in place
+    void compressBand(BandState& state, int ch, float* samples, int numSamples, const BandSettings& settings)
     {
-        // RMS Detection (10ms window)
-        float inputSquared = inputSample * inputSample;
+        // RMS detection over the 10ms window
+        auto& squares = state.squares[ch];
+        int index = state.index[ch];
+        float sum = state.sum[ch];
         
-        // Update RMS circular buffer
-        if (rmsBufferSize_ > 0)
+        for (int i = 0; i < numSamples; ++i)
         {
-            rmsSum -= rmsBuffer[rmsIndex]; // Remove old sample
-            rmsBuffer[rmsIndex] = inputSquared; // Add new sample
-            rmsSum += inputSquared;
-            rmsIndex = (rmsIndex + 1) % rmsBufferSize_;
-            
-            // Calculate RMS level in dB
-            float rmsValue = std::sqrt(rmsSum / static_cast<float>(rmsBufferSize_));
-            float rmsDb = rmsValue > 0.0f ? 20.0f * std::log10(rmsValue) : -100.0f;
-            
-            // True OTT-style dual compression with proper upward/downward sections
-            float gainChangeDb = 0.0f;
-            
-            // Split threshold into upward and downward sections like real OTT
-            float upwardThreshold = threshold - 15.0f; // 15dB below for upward section
-            float downwardThreshold = threshold; // Main threshold for downward
-            
-            // Downward compression (compress loud signals above threshold)
-            if (rmsDb > downwardThreshold)
-            {
-                float overshoot = rmsDb - downwardThreshold;
-                float downwardRatio = juce::jmax(2.0f, ratio); // Minimum 2:1 for downward
-                gainChangeDb -= overshoot * (1.0f - 1.0f / downwardRatio);
-            }
-            
-            // Upward compression (OTT's signature - aggressively boost quiet parts)
-            if (rmsDb < upwardThreshold && rmsDb > -50.0f) // Don't boost noise floor
-            {
-                float undershoot = upwardThreshold - rmsDb;
-                float upwardRatio = juce::jmax(3.0f, ratio * 0.8f); // Strong upward compression
-                
-                // More aggressive upward compression curve - this is the OTT magic
-                float upwardGain = undershoot * (1.0f - 1.0f / upwardRatio);
-                
-                // Apply controlled scaling to prevent excessive gain buildup
-                float quietnessScale = juce::jlimit(0.1f, 0.6f, (upwardThreshold - rmsDb) / 30.0f);
-                gainChangeDb += upwardGain * quietnessScale * 0.2f; // Controlled upward compression to prevent gain stacking
-            }
-            
-            // Middle zone (between upward and downward thresholds) - gentle expansion
-            if (rmsDb >= upwardThreshold && rmsDb <= downwardThreshold)
-            {
-                // Controlled expansion in the middle zone to prevent gain stacking
-                float middleZoneWidth = downwardThreshold - upwardThreshold;
-                float positionInZone = (rmsDb - upwardThreshold) / middleZoneWidth; // 0-1
-                float expansionAmount = (1.0f - positionInZone) * 0.05f; // Reduced expansion to control gain
-                gainChangeDb += expansionAmount;
-            }
-            
-            // Convert to linear gain change
-            float targetGainReduction = std::pow(10.0f, gainChangeDb / 20.0f);
-            
-            // Apply attack/release envelope
-            if (targetGainReduction < gainReduction)
-            {
-                // Attack (gain reduction increasing or boost decreasing)
-                gainReduction = targetGainReduction + (gainReduction - targetGainReduction) * attackCoeff;
-            }
-            else
-            {
-                // Release (gain reduction decreasing or boost increasing)  
-                gainReduction = targetGainReduction + (gainReduction - targetGainReduction) * releaseCoeff;
-            }
-            
-            // Apply compression/expansion with safety checks
-            float outputSample = inputSample * gainReduction;
-            
-            // Safety check for NaN, infinity, or excessive values
-            if (!std::isfinite(outputSample) || std::abs(outputSample) > 10.0f)
-            {
-                return 0.0f; // Return silence if something went wrong
-            }
-            
-            return outputSample;
+            const float squared = samples[i] * samples[i];
+            sum += squared - squares[static_cast<size_t>(index)];
+            squares[static_cast<size_t>(index)] = squared;
+            if (++index == rmsWindowSize)
+                index = 0;
         }
         
-        return inputSample;
+        sum = juce::jmax(0.0f, sum); // Rounding can leave the running sum slightly negative
+        state.index[ch] = index;
+        state.sum[ch] = sum;
+        
+        // Gain computer, once per control block
+        const float meanSquare = sum / static_cast<float>(rmsWindowSize);
+        const float rmsDb = meanSquare > 1.0e-10f ? 10.0f * std::log10(meanSquare) : -100.0f;
+        const float targetGain = juce::Decibels::decibelsToGain(computeGainChangeDb(rmsDb, settings.threshold, settings.ratio), -200.0f);
+        
+        // Attack/release envelope; it never crosses the target, so one direction holds for the block
+        const float distance = state.gain[ch] - targetGain;
+        const float* powers = distance > 0.0f ? settings.attackPowers : settings.releasePowers;
+        for (int i = 0; i < numSamples; ++i)
+            samples[i] *= targetGain + distance * powers[i];
+        
+        // Safety check for NaN or infinity in the envelope
+        const float gain = targetGain + distance * powers[numSamples - 1];
+        state.gain[ch] = std::isfinite(gain) ? gain : 1.0f;
     }
     
-    void initializeCrossoverFilters()
+    // Pade approximant of tanh, within 1e-4 of std::tanh over the whole range
+    static float fastTanh(float x)
     {
-        // Crossover frequencies: 200Hz and 2kHz
-        float lowCrossover = 200.0f;
-        float highCrossover = 2000.0f;
+        x = juce::jlimit(-4.97f, 4.97f, x);
+        const float x2 = x * x;
+        const float numerator = x * (135135.0f + x2 * (17325.0f + x2 * (378.0f + x2)));
+        const float denominator = 135135.0f + x2 * (62370.0f + x2 * (3150.0f + x2 * 28.0f));
+        return numerator / denominator;
+    }
+    
+    // OTT-style dual compression: downward above the threshold, upward well below it
+    static float computeGainChangeDb(float rmsDb, float threshold, float ratio)
+    {
+        float gainChangeDb = 0.0f;
         
-        for (int ch = 0; ch < 2; ++ch)
+        // Split threshold into upward and downward sections like real OTT
+        const float upwardThreshold = threshold - 15.0f; // 15dB below for upward section
+        const float downwardThreshold = threshold;       // Main threshold for downward
+        
+        // Downward compression (compress loud signals above threshold)
+        if (rmsDb > downwardThreshold)
         {
-            // Low band: Lowpass at 200Hz (24dB/octave Linkwitz-Riley)
-            lowBandFilter[ch][0].setSampleRate(sampleRate);
-            lowBandFilter[ch][0].setCutoffFrequency(lowCrossover);
-            lowBandFilter[ch][0].setResonance(0.707f);
-            lowBandFilter[ch][0].setFilterType(SimpleStableFilter::LOWPASS);
-            lowBandFilter[ch][0].setFilterSlope(SimpleStableFilter::SLOPE_12DB);
-            
-            lowBandFilter[ch][1].setSampleRate(sampleRate);
-            lowBandFilter[ch][1].setCutoffFrequency(lowCrossover);
-            lowBandFilter[ch][1].setResonance(0.707f);
-            lowBandFilter[ch][1].setFilterType(SimpleStableFilter::LOWPASS);
-            lowBandFilter[ch][1].setFilterSlope(SimpleStableFilter::SLOPE_12DB);
-            
-            // Mid band: Highpass at 200Hz + Lowpass at 2kHz
-            midBandFilterHP[ch][0].setSampleRate(sampleRate);
-            midBandFilterHP[ch][0].setCutoffFrequency(lowCrossover);
-            midBandFilterHP[ch][0].setResonance(0.707f);
-            midBandFilterHP[ch][0].setFilterType(SimpleStableFilter::HIGHPASS);
-            midBandFilterHP[ch][0].setFilterSlope(SimpleStableFilter::SLOPE_12DB);
-            
-            midBandFilterHP[ch][1].setSampleRate(sampleRate);
-            midBandFilterHP[ch][1].setCutoffFrequency(lowCrossover);
-            midBandFilterHP[ch][1].setResonance(0.707f);
-            midBandFilterHP[ch][1].setFilterType(SimpleStableFilter::HIGHPASS);
-            midBandFilterHP[ch][1].setFilterSlope(SimpleStableFilter::SLOPE_12DB);
-            
-            midBandFilterLP[ch][0].setSampleRate(sampleRate);
-            midBandFilterLP[ch][0].setCutoffFrequency(highCrossover);
-            midBandFilterLP[ch][0].setResonance(0.707f);
-            midBandFilterLP[ch][0].setFilterType(SimpleStableFilter::LOWPASS);
-            midBandFilterLP[ch][0].setFilterSlope(SimpleStableFilter::SLOPE_12DB);
-            
-            midBandFilterLP[ch][1].setSampleRate(sampleRate);
-            midBandFilterLP[ch][1].setCutoffFrequency(highCrossover);
-            midBandFilterLP[ch][1].setResonance(0.707f);
-            midBandFilterLP[ch][1].setFilterType(SimpleStableFilter::LOWPASS);
-            midBandFilterLP[ch][1].setFilterSlope(SimpleStableFilter::SLOPE_12DB);
+            const float overshoot = rmsDb - downwardThreshold;
+            const float downwardRatio = juce::jmax(2.0f, ratio); // Minimum 2:1 for downward
+            gainChangeDb -= overshoot * (1.0f - 1.0f / downwardRatio);
+        }
+        
+        // Upward compression (OTT's signature - boost quiet parts, but not the noise floor)
+        if (rmsDb < upwardThreshold && rmsDb > -50.0f)
+        {
+            const float undershoot = upwardThreshold - rmsDb;
+            const float upwardRatio = juce::jmax(3.0f, ratio * 0.8f);
+            const float upwardGain = undershoot * (1.0f - 1.0f / upwardRatio);
             
-            // High band: Highpass at 2kHz (24dB/octave Linkwitz-Riley)
-            highBandFilter[ch][0].setSampleRate(sampleRate);
-            highBandFilter[ch][0].setCutoffFrequency(highCrossover);
-            highBandFilter[ch][0].setResonance(0.707f);
-            highBandFilter[ch][0].setFilterType(SimpleStableFilter::HIGHPASS);
-            highBandFilter[ch][0].setFilterSlope(SimpleStableFilter::SLOPE_12DB);
+            // Controlled scaling to prevent excessive gain buildup
+            const float quietnessScale = juce::jlimit(0.1f, 0.6f, undershoot / 30.0f);
+            gainChangeDb += upwardGain * quietnessScale * 0.2f;
+        }
+        
+        // Middle zone (between upward and downward thresholds) - gentle expansion
+        if (rmsDb >= upwardThreshold && rmsDb <= downwardThreshold)
+        {
+            const float positionInZone = (rmsDb - upwardThreshold) / (downwardThreshold - upwardThreshold); // 0-1
+            gainChangeDb += (1.0f - positionInZone) * 0.05f;
+        }
+        
+        return gainChangeDb;
+    }
+    
+    // Applies the makeup ramp to the wet scratch and mixes it with the dry signal in the buffer
+    void applyMakeupAndMix(juce::AudioBuffer<float>& buffer, int start, int numSamples, int numChannels)
+    {
+        const float makeupStep = (makeupGainLinear - previousMakeupGainLinear) / static_cast<float>(numSamples);
+        
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float currentMix = mixSmoothing.getNextValue();
+            const float currentMakeup = previousMakeupGainLinear + makeupStep * static_cast<float>(i + 1);
             
-            highBandFilter[ch][1].setSampleRate(sampleRate);
-            highBandFilter[ch][1].setCutoffFrequency(highCrossover);
-            highBandFilter[ch][1].setResonance(0.707f);
-            highBandFilter[ch][1].setFilterType(SimpleStableFilter::HIGHPASS);
-            highBandFilter[ch][1].setFilterSlope(SimpleStableFilter::SLOPE_12DB);
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                float* output = buffer.getWritePointer(ch, start);
+                
+                // Mix dry and wet (parallel compression)
+                output[i] = output[i] * (1.0f - currentMix) + wet[ch][i] * currentMakeup * currentMix;
+            }
         }
     }
     
@@ -947,25 +862,25 @@ private:
     // Parameter smoothing
     OnePoleSmoothing thresholdSmoothing, ratioSmoothing, attackSmoothing, releaseSmoothing, makeupGainSmoothing, mixSmoothing;
     
+    // Per-block values derived from the smoothed parameters
+    BandSettings singleBandSettings {};
+    BandSettings bandSettings[NUM_BANDS] {};
+    float lastAttack = -1.0f, lastRelease = -1.0f, lastMakeupGain = -1.0f;
+    float makeupGainLinear = 1.0f, previousMakeupGainLinear = 1.0f;
+    
     // Processing state
     double sampleRate = 44100.0;
-    std::vector<float> rmsBuffer[2]; // RMS calculation buffers
-    int rmsBufferSize_ = 0;
-    int rmsIndex[2] = {0, 0};
-    float rmsSum[2] = {0.0f, 0.0f};
-    float gainReduction[2] = {1.0f, 1.0f}; // Linear gain reduction values
-    
-    // Multiband crossover filters (2 stages each for 24dB/octave Linkwitz-Riley)
-    SimpleStableFilter lowBandFilter[2][2];     // Low band: LP @ 200Hz (2 stages)
-    SimpleStableFilter midBandFilterHP[2][2];   // Mid band: HP @ 200Hz (2 stages)
-    SimpleStableFilter midBandFilterLP[2][2];   // Mid band: LP @ 2kHz (2 stages)  
-    SimpleStableFilter highBandFilter[2][2];    // High band: HP @ 2kHz (2 stages)
-    
-    // Multiband RMS buffers (separate per band)
-    std::vector<float> rmsBufferLow[2], rmsBufferMid[2], rmsBufferHigh[2];
-    int rmsIndexLow[2] = {0, 0}, rmsIndexMid[2] = {0, 0}, rmsIndexHigh[2] = {0, 0};
-    float rmsSumLow[2] = {0.0f, 0.0f}, rmsSumMid[2] = {0.0f, 0.0f}, rmsSumHigh[2] = {0.0f, 0.0f};
-    float gainReductionLow[2] = {1.0f, 1.0f}, gainReductionMid[2] = {1.0f, 1.0f}, gainReductionHigh[2] = {1.0f, 1.0f};
+    int rmsWindowSize = 0;
+    BandState singleBand;
+    BandState bands[NUM_BANDS];
+    
+    // Multiband crossovers (24dB/octave Linkwitz-Riley at 200Hz and 2kHz)
+    LinkwitzRileyCrossover lowCrossover, highCrossover;
+    LinkwitzRileyCrossover lowPhaseCompensation; // 2kHz allpass on the low band
+    
+    // Scratch for one control block
+    float wet[2][controlBlockSize];
+    float bandBuffers[NUM_BANDS][2][controlBlockSize];
 };
 
 // Multi-mode distortion effect with pre/post filtering
@@ -1026,6 +941,7 @@ public:
     }
     
     void setEnabled(bool enabled) { isEnabled = enabled; }
+    bool getEnabled() const { return isEnabled; }
     void setType(int type) { 
         distortionType = juce::jlimit(1, 16, type);
     }
@@ -1068,6 +984,30 @@ public:
         updateFilters();
     }
     
+    // 0 = off, 1 = 2x, 2 = 4x, 3 = 8x; the switch happens at the start of the next block
+    void setOversampling(int stages) { requestedOversampling = juce::jlimit(0, Oversampler::maxStages, stages); }
+    
+    // Latency of the requested oversampling mode, at the host sample rate
+    int getLatencySamples() const { return getLatencyForMode(isEnabled, requestedOversampling.load()); }
+    
+    static int getLatencyForMode(bool enabled, int stages)
+    {
+        return enabled ? Oversampler::getLatencyForStages(juce::jlimit(0, Oversampler::maxStages, stages)) : 0;
+    }
+    
+    // Waveshapers are memoryless; only the pre/post filter, the downsample hold and
+    // the oversampling filters ring on
+    double getTailLengthSeconds() const
+    {
+        if (!isEnabled || sampleRate <= 0.0)
+            return 0.0;
+        
+        double tail = (8.0 + getLatencySamples()) / sampleRate;
+        if (filterPosition != FILTER_OFF)
+            tail += TailGate::getResonanceTailSeconds(filterFreq, filterQ);
+        return tail;
+    }
+    
     void reset()
     {
         // Reset parameter smoothing
@@ -1084,6 +1024,14 @@ public:
         // Reset bitcrusher state
         bitcrushHold[0] = bitcrushHold[1] = 0.0f;
         bitcrushCounter[0] = bitcrushCounter[1] = 0;
+        
+        // Reset oversampling and the matching dry delay
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            oversamplers[ch].reset();
+            std::fill(std::begin(dryDelay[ch]), std::end(dryDelay[ch]), 0.0f);
+        }
+        dryDelayIndex = 0;
     }
     
     void processBlock(juce::AudioBuffer<float>& buffer)
@@ -1097,6 +1045,25 @@ public:
         if (numSamples <= 0 || numChannels <= 0)
             return;
         
+        // Apply a pending oversampling change on the audio thread
+        const int stages = requestedOversampling.load();
+        if (stages != oversamplers[0].getNumStages())
+        {
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                oversamplers[ch].setNumStages(stages);
+                std::fill(std::begin(dryDelay[ch]), std::end(dryDelay[ch]), 0.0f);
+            }
+            dryDelayIndex = 0;
+            decimateInterval = 8 << stages;
+        }
+        
+        if (stages > 0)
+        {
+            processOversampled(buffer, numSamples, numChannels);
+            return;
+        }
+        
         for (int sample = 0; sample < numSamples; ++sample)
         {
             float currentDrive = driveSmoothing.getNextValue();
@@ -1132,6 +1099,61 @@ public:
     }
     
 private:
+    // Pre-filter and dry path at the host rate, waveshaper at the oversampled rate.
+    // The dry signal is delayed by the oversampler latency so the mix stays aligned.
+    void processOversampled(juce::AudioBuffer<float>& buffer, int numSamples, int numChannels)
+    {
+        const int factor = oversamplers[0].getFactor();
+        const int latency = oversamplers[0].getLatencySamples();
+        
+        for (int start = 0; start < numSamples; start += Oversampler::maxChunkSize)
+        {
+            const int chunkSize = juce::jmin(Oversampler::maxChunkSize, numSamples - start);
+            
+            for (int i = 0; i < chunkSize; ++i)
+            {
+                driveValues[i] = driveSmoothing.getNextValue();
+                mixValues[i] = mixSmoothing.getNextValue();
+            }
+            
+            int writeIndex = dryDelayIndex;
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                float* channelData = buffer.getWritePointer(ch, start);
+                
+                // Pre-filtering (will pass through unchanged if filter is OFF)
+                for (int i = 0; i < chunkSize; ++i)
+                    chunkBuffer[i] = preFilter[ch].processSample(channelData[i], ch);
+                
+                float* oversampled = oversamplers[ch].upsample(chunkBuffer, chunkSize);
+                for (int i = 0; i < chunkSize * factor; ++i)
+                    oversampled[i] = applyDistortion(oversampled[i], driveValues[i / factor], ch);
+                oversamplers[ch].downsample(chunkBuffer, chunkSize);
+                
+                writeIndex = dryDelayIndex;
+                for (int i = 0; i < chunkSize; ++i)
+                {
+                    dryDelay[ch][writeIndex] = channelData[i];
+                    const float drySample = dryDelay[ch][(writeIndex - latency) & (dryDelaySize - 1)];
+                    writeIndex = (writeIndex + 1) & (dryDelaySize - 1);
+                    
+                    // Post-filtering (will pass through unchanged if filter is OFF)
+                    const float processedSample = postFilter[ch].processSample(chunkBuffer[i], ch);
+                    
+                    // Mix dry and wet
+                    float outputSample = drySample * (1.0f - mixValues[i]) + processedSample * mixValues[i];
+                    
+                    // Safety check
+                    if (!std::isfinite(outputSample))
+                        outputSample = 0.0f;
+                    
+                    channelData[i] = outputSample;
+                }
+            }
+            dryDelayIndex = writeIndex;
+        }
+    }
+    
     float applyDistortion(float input, float driveAmount, int channel)
     {
         if (driveAmount <= 0.0f) return input;
@@ -1298,8 +1320,8 @@ private:
     
     float decimateDistortion(float x, int channel)
     {
-        // Reduce effective sample rate (downsample)
-        if (++bitcrushCounter[channel] >= 8)
+        // Reduce effective sample rate (downsample, same hold time when oversampled)
+        if (++bitcrushCounter[channel] >= decimateInterval)
         {
             bitcrushHold[channel] = x;
             bitcrushCounter[channel] = 0;
@@ -1397,9 +1419,27 @@ private:
     // Bitcrusher state
     float bitcrushHold[2] = {0.0f, 0.0f};
     int bitcrushCounter[2] = {0, 0};
+    int decimateInterval = 8;
+    
+    // Oversampling state
+    std::atomic<int> requestedOversampling { 0 };
+    Oversampler oversamplers[2];
+    float chunkBuffer[Oversampler::maxChunkSize] = {};
+    float driveValues[Oversampler::maxChunkSize] = {};
+    float mixValues[Oversampler::maxChunkSize] = {};
+    
+    // Dry path delay matching the oversampler latency
+    static constexpr int dryDelaySize = 32; // Power of two above the largest latency
+    float dryDelay[2][dryDelaySize] = {};
+    int dryDelayIndex = 0;
 };
 
-// Stereo delay effect with ping-pong, filtering, and tempo sync
+// Stereo delay effect with ping-pong, filtering, and tempo sync. Each side reads its
+// delay line at a fractional delay with cubic interpolation. A new delay time is
+// reached by crossfading from the old read position, so moving the time knob or a
+// tempo change never jumps the read point. Between changes the delay is fixed and
+// the block is processed in runs: the delayed signal is copied out of the ring and
+// the feedback written back as contiguous blocks.
 class DelayEffect
 {
 public:
@@ -1425,21 +1465,22 @@ public:
         mixSmoothing.setSampleRate(sampleRate);
         mixSmoothing.setTimeConstantMs(20.0f);
         
-        // Allocate delay buffers - maximum 2 seconds at any sample rate
-        int maxDelaySize = static_cast<int>(sampleRate * 2.0);
-        delayBufferL.resize(maxDelaySize, 0.0f);
-        delayBufferR.resize(maxDelaySize, 0.0f);
-        delayBufferSize = maxDelaySize;
+        // Room for the longest free time, and for synced note lengths at slow tempos
+        for (auto& line : delayLines)
+            line.prepare(static_cast<int>(sampleRate * maxDelaySeconds));
+        crossfadeLength = juce::jmax(1, static_cast<int>(sampleRate * crossfadeMs * 0.001));
         
         // Initialize filters for feedback path
         feedbackFilterL.setSampleRate(sampleRate);
         feedbackFilterR.setSampleRate(sampleRate);
         updateFilters();
         
+        updateDelayTimes();
         reset();
     }
     
     void setEnabled(bool enabled) { isEnabled = enabled; }
+    bool getEnabled() const { return isEnabled; }
     
     void setFeedback(float feedback) { 
         feedbackAmount = juce::jlimit(0.0f, 0.95f, feedback);
@@ -1470,7 +1511,19 @@ public:
         }
     }
     
-    void setBpmSync(bool sync) { bpmSync = sync; }
+    void setBpmSync(bool sync) { bpmSync = sync; updateDelayTimes(); }
+    bool getBpmSync() const { return bpmSync; }
+    
+    // Tempo from the host's play head, called every block; only synced times depend on it
+    void setHostTempo(double bpm)
+    {
+        if (bpm <= 0.0 || bpm == hostBpm)
+            return;
+        
+        hostBpm = bpm;
+        if (bpmSync)
+            updateDelayTimes();
+    }
     
     void setLeftTriplet(bool triplet) { leftIsTriplet = triplet; updateDelayTimes(); }
     void setLeftDotted(bool dotted) { leftIsDotted = dotted; updateDelayTimes(); }
@@ -1488,12 +1541,29 @@ public:
         updateFilters();
     }
     
+    double getTailLengthSeconds() const
+    {
+        if (!isEnabled || sampleRate <= 0.0)
+            return 0.0;
+        
+        // Ping-pong echoes alternate sides, so one round trip covers both delay times
+        const float left = juce::jmax(currentDelay[0], targetDelay[0]);
+        const float right = juce::jmax(currentDelay[1], targetDelay[1]);
+        const float loopSamples = delayMode == PING_PONG ? left + right : juce::jmax(left, right);
+        return TailGate::getFeedbackTailSeconds(loopSamples / sampleRate, feedbackAmount)
+             + TailGate::getResonanceTailSeconds(filterFreq, filterQ);
+    }
+    
     void reset()
     {
-        // Clear delay buffers
-        std::fill(delayBufferL.begin(), delayBufferL.end(), 0.0f);
-        std::fill(delayBufferR.begin(), delayBufferR.end(), 0.0f);
-        delayIndexL = delayIndexR = 0;
+        // Clear delay buffers and settle on the current times
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            if (delayLines[ch].isPrepared())
+                delayLines[ch].reset();
+            currentDelay[ch] = previousDelay[ch] = targetDelay[ch];
+        }
+        crossfadeRemaining = 0;
         
         // Reset parameter smoothing
         feedbackSmoothing.reset(feedbackAmount);
@@ -1512,114 +1582,166 @@ public:
         const int numSamples = buffer.getNumSamples();
         const int numChannels = juce::jmin(buffer.getNumChannels(), 2);
         
-        if (numSamples <= 0 || numChannels <= 0 || delayBufferSize <= 0)
+        if (numSamples <= 0 || numChannels <= 0 || !delayLines[0].isPrepared())
             return;
         
-        for (int sample = 0; sample < numSamples; ++sample)
+        float* left = buffer.getWritePointer(0);
+        float* right = numChannels > 1 ? buffer.getWritePointer(1) : nullptr;
+        
+        for (int start = 0; start < numSamples;)
         {
-            float currentFeedback = feedbackSmoothing.getNextValue();
-            float currentMix = mixSmoothing.getNextValue();
-            
-            // Process stereo or mono
-            float inputL = buffer.getSample(0, sample);
-            float inputR = numChannels > 1 ? buffer.getSample(1, sample) : inputL;
-            
-            float outputL, outputR;
+            if (crossfadeRemaining == 0)
+                startCrossfadeIfNeeded();
             
-            if (delayMode == PING_PONG)
+            if (crossfadeRemaining > 0)
             {
-                processPingPong(inputL, inputR, outputL, outputR, currentFeedback);
+                const int count = juce::jmin(numSamples - start, crossfadeRemaining);
+                processCrossfade(left, right, start, count);
+                start += count;
             }
             else
             {
-                processNormal(inputL, inputR, outputL, outputR, currentFeedback);
+                // A run may not read anything it is about to write
+                const int count = juce::jmin(numSamples - start, runSize,
+                                              DelayLine::getMaximumBlockLength(currentDelay[0]),
+                                              DelayLine::getMaximumBlockLength(currentDelay[1]));
+                processRun(left, right, start, count);
+                start += count;
             }
-            
-            // Mix dry and wet
-            float finalL = inputL * (1.0f - currentMix) + outputL * currentMix;
-            float finalR = inputR * (1.0f - currentMix) + outputR * currentMix;
-            
-            // Safety checks
-            if (!std::isfinite(finalL)) finalL = 0.0f;
-            if (!std::isfinite(finalR)) finalR = 0.0f;
-            
-            buffer.setSample(0, sample, finalL);
-            if (numChannels > 1)
-                buffer.setSample(1, sample, finalR);
         }
     }
     
 private:
-    void processNormal(float inputL, float inputR, float& outputL, float& outputR, float feedback)
+    using DelayLine = ModulatedDelayLine<DelayInterpolation::CUBIC>;
+    
+    static constexpr double maxDelaySeconds = 4.0;
+    static constexpr double crossfadeMs = 30.0;
+    static constexpr int runSize = 256;
+    
+    // Filters the delayed pair, mixes it into the dry signal in place and returns what
+    // goes back into the delay lines
+    void processFrame(float& sampleL, float& sampleR, float delayedL, float delayedR, float& writeL, float& writeR)
     {
-        // Read delayed samples
-        float delayedL = delayBufferL[delayIndexL];
-        float delayedR = delayBufferR[delayIndexR];
+        const float feedback = feedbackSmoothing.getNextValue();
+        const float mix = mixSmoothing.getNextValue();
         
         // Apply feedback filtering
         delayedL = feedbackFilterL.processSample(delayedL, 0);
         delayedR = feedbackFilterR.processSample(delayedR, 1);
         
-        // Feedback path
-        float feedbackL = inputL + delayedL * feedback;
-        float feedbackR = inputR + delayedR * feedback;
-        
-        // Write to delay buffers
-        delayBufferL[delayIndexL] = feedbackL;
-        delayBufferR[delayIndexR] = feedbackR;
+        if (delayMode == PING_PONG)
+        {
+            // Ping-pong: cross-feed the delays
+            writeL = sampleL + delayedR * feedback; // Right delay feeds left
+            writeR = sampleR + delayedL * feedback; // Left delay feeds right
+        }
+        else
+        {
+            writeL = sampleL + delayedL * feedback;
+            writeR = sampleR + delayedR * feedback;
+        }
         
-        // Advance delay indices
-        delayIndexL = (delayIndexL + 1) % leftDelaySamples;
-        delayIndexR = (delayIndexR + 1) % rightDelaySamples;
+        // Mix dry and wet
+        float finalL = sampleL * (1.0f - mix) + delayedL * mix;
+        float finalR = sampleR * (1.0f - mix) + delayedR * mix;
         
-        // Output delayed signals
-        outputL = delayedL;
-        outputR = delayedR;
+        // Safety checks
+        sampleL = std::isfinite(finalL) ? finalL : 0.0f;
+        sampleR = std::isfinite(finalR) ? finalR : 0.0f;
     }
     
-    void processPingPong(float inputL, float inputR, float& outputL, float& outputR, float feedback)
+    // Steady delay times: block reads and writes around a per-sample feedback loop
+    void processRun(float* left, float* right, int start, int numSamples)
     {
-        // Read delayed samples
-        float delayedL = delayBufferL[delayIndexL];
-        float delayedR = delayBufferR[delayIndexR];
+        delayLines[0].readBlock(currentDelay[0], delayedBlock[0], numSamples);
+        delayLines[1].readBlock(currentDelay[1], delayedBlock[1], numSamples);
         
-        // Apply feedback filtering
-        delayedL = feedbackFilterL.processSample(delayedL, 0);
-        delayedR = feedbackFilterR.processSample(delayedR, 1);
+        for (int i = 0; i < numSamples; ++i)
+        {
+            float sampleL = left[start + i];
+            float sampleR = right != nullptr ? right[start + i] : sampleL;
+            processFrame(sampleL, sampleR, delayedBlock[0][i], delayedBlock[1][i], feedbackBlock[0][i], feedbackBlock[1][i]);
+            
+            left[start + i] = sampleL;
+            if (right != nullptr)
+                right[start + i] = sampleR;
+        }
         
-        // Ping-pong: cross-feed the delays
-        float feedbackL = inputL + delayedR * feedback; // Right delay feeds left
-        float feedbackR = inputR + delayedL * feedback; // Left delay feeds right
+        delayLines[0].writeBlock(feedbackBlock[0], numSamples);
+        delayLines[1].writeBlock(feedbackBlock[1], numSamples);
+    }
+    
+    // A time change in progress: each side fades from its old read position to its new one
+    void processCrossfade(float* left, float* right, int start, int numSamples)
+    {
+        const float step = 1.0f / static_cast<float>(crossfadeLength);
         
-        // Write to delay buffers
-        delayBufferL[delayIndexL] = feedbackL;
-        delayBufferR[delayIndexR] = feedbackR;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float fade = 1.0f - static_cast<float>(--crossfadeRemaining) * step;
+            float delayed[2];
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                const float from = delayLines[ch].read(previousDelay[ch]);
+                const float to = delayLines[ch].read(currentDelay[ch]);
+                delayed[ch] = from + fade * (to - from);
+            }
+            
+            float sampleL = left[start + i];
+            float sampleR = right != nullptr ? right[start + i] : sampleL;
+            float writeL, writeR;
+            processFrame(sampleL, sampleR, delayed[0], delayed[1], writeL, writeR);
+            delayLines[0].write(writeL);
+            delayLines[1].write(writeR);
+            
+            left[start + i] = sampleL;
+            if (right != nullptr)
+                right[start + i] = sampleR;
+        }
+    }
+    
+    // Begins a fade to the latest times; one that arrives mid-fade waits for it to finish
+    void startCrossfadeIfNeeded()
+    {
+        if (currentDelay[0] == targetDelay[0] && currentDelay[1] == targetDelay[1])
+            return;
         
-        // Advance delay indices
-        delayIndexL = (delayIndexL + 1) % leftDelaySamples;
-        delayIndexR = (delayIndexR + 1) % rightDelaySamples;
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            previousDelay[ch] = currentDelay[ch];
+            currentDelay[ch] = targetDelay[ch];
+        }
+        crossfadeRemaining = crossfadeLength;
+    }
+    
+    // Length of one side in milliseconds. Synced, the knob keeps its meaning at 120 BPM:
+    // its time there is snapped to the nearest note length, from 1/64 to a whole note,
+    // which is then played at the host tempo.
+    float getSideTimeMs(float timeMs, bool triplet, bool dotted) const
+    {
+        double time = timeMs;
+        if (bpmSync)
+        {
+            const double beats = juce::jlimit(1.0 / 16.0, 4.0, std::exp2(std::round(std::log2(timeMs / 500.0))));
+            time = beats * 60000.0 / hostBpm;
+        }
         
-        // Output delayed signals
-        outputL = delayedL;
-        outputR = delayedR;
+        // Apply triplet/dotted modifiers
+        if (triplet) time *= 2.0 / 3.0;
+        if (dotted) time *= 1.5;
+        return static_cast<float>(time);
     }
     
     void updateDelayTimes()
     {
         if (sampleRate <= 0.0) return;
         
-        float leftTime = leftTimeMs;
-        float rightTime = rightTimeMs;
-        
-        // Apply triplet/dotted modifiers
-        if (leftIsTriplet) leftTime *= 2.0f / 3.0f;
-        if (leftIsDotted) leftTime *= 1.5f;
-        if (rightIsTriplet) rightTime *= 2.0f / 3.0f;
-        if (rightIsDotted) rightTime *= 1.5f;
-        
-        // Convert to samples
-        leftDelaySamples = juce::jlimit(1, delayBufferSize - 1, static_cast<int>(leftTime * 0.001f * sampleRate));
-        rightDelaySamples = juce::jlimit(1, delayBufferSize - 1, static_cast<int>(rightTime * 0.001f * sampleRate));
+        // Convert to samples; the shortest time still leaves room for a block run
+        const float maxDelay = static_cast<float>(sampleRate * maxDelaySeconds);
+        const float times[2] = { getSideTimeMs(leftTimeMs, leftIsTriplet, leftIsDotted),
+                                 getSideTimeMs(rightTimeMs, rightIsTriplet, rightIsDotted) };
+        for (int ch = 0; ch < 2; ++ch)
+            targetDelay[ch] = juce::jlimit(8.0f, maxDelay, times[ch] * 0.001f * static_cast<float>(sampleRate));
     }
     
     void updateFilters()
@@ -1648,31 +1770,39 @@ private:
     bool rightIsDotted = false;
     float filterFreq = 8000.0f;
     float filterQ = 0.707f;
+    double hostBpm = 120.0;
     
     // Parameter smoothing
     OnePoleSmoothing feedbackSmoothing, mixSmoothing;
     
     // Processing state
     double sampleRate = 44100.0;
-    std::vector<float> delayBufferL, delayBufferR;
-    int delayBufferSize = 0;
-    int delayIndexL = 0, delayIndexR = 0;
-    int leftDelaySamples = 0, rightDelaySamples = 0;
+    DelayLine delayLines[2];
+    float targetDelay[2] = { 11025.0f, 11025.0f };  // Samples, from the parameters
+    float currentDelay[2] = { 11025.0f, 11025.0f }; // Samples, being read
+    float previousDelay[2] = { 11025.0f, 11025.0f }; // Samples, faded out during a change
+    int crossfadeLength = 1;
+    int crossfadeRemaining = 0;
+    float delayedBlock[2][runSize] = {};
+    float feedbackBlock[2][runSize] = {};
     
     // Feedback filters
     SimpleStableFilter feedbackFilterL, feedbackFilterR;
 };
 
-// Multi-tap stereo chorus effect
+// Multi-voice stereo chorus. Each channel reads several taps from one modulated delay
+// line: their delays are spread between delay 1 and delay 2 (mirrored on the right) and
+// their LFO phases evenly around the cycle, the right channel a quarter cycle on. One
+// quadrature oscillator supplies every tap's LFO.
 class ChorusEffect
 {
 public:
+    static constexpr int minVoices = 3;
+    static constexpr int maxVoices = 6;
+    
     ChorusEffect()
     {
-        // Initialize LFO phases - offset by 90 degrees for stereo width
-        lfoPhase[0] = 0.0f;
-        lfoPhase[1] = juce::MathConstants<float>::pi * 0.5f; // 90 degree offset
-        
+        setVoices(minVoices);
         reset();
     }
     
@@ -1696,11 +1826,11 @@ public:
         lpfCutoffSmoothing.setSampleRate(sampleRate);
         lpfCutoffSmoothing.setTimeConstantMs(5.0f); // Much faster smoothing for gentle transitions
         
-        // Allocate delay buffers - maximum 100ms at any sample rate
-        int maxDelaySize = static_cast<int>(sampleRate * 0.1); // 100ms
-        delayBuffer[0].resize(maxDelaySize, 0.0f);
-        delayBuffer[1].resize(maxDelaySize, 0.0f);
-        delayBufferSize = maxDelaySize;
+        // Allocate delay lines - maximum 100ms at any sample rate
+        const int maxDelaySize = static_cast<int>(sampleRate * 0.1); // 100ms
+        delayLine[0].prepare(maxDelaySize);
+        delayLine[1].prepare(maxDelaySize);
+        updateVoiceLayout();
         
         // Initialize LPF
         lpf[0].setSampleRate(sampleRate);
@@ -1709,15 +1839,18 @@ public:
     }
     
     void setEnabled(bool enabled) { isEnabled = enabled; }
+    bool getEnabled() const { return isEnabled; }
     void setRate(float rate) { 
         rateHz = juce::jlimit(0.1f, 10.0f, rate);
         rateSmoothing.setTarget(rateHz);
     }
     void setDelay1(float delayMs) { 
         delay1Ms = juce::jlimit(1.0f, 50.0f, delayMs);
+        updateVoiceLayout();
     }
     void setDelay2(float delayMs) { 
         delay2Ms = juce::jlimit(1.0f, 50.0f, delayMs);
+        updateVoiceLayout();
     }
     void setDepth(float depth) { 
         depthMs = juce::jlimit(0.0f, 20.0f, depth);
@@ -1738,20 +1871,27 @@ public:
         wetMix = juce::jlimit(0.0f, 1.0f, mix);
         mixSmoothing.setTarget(wetMix);
     }
+    void setVoices(int voices) {
+        numVoices = juce::jlimit(minVoices, maxVoices, voices);
+        updateVoiceLayout();
+    }
+    
+    double getTailLengthSeconds() const
+    {
+        if (!isEnabled)
+            return 0.0;
+        const double longestDelayMs = juce::jmax(delay1Ms, delay2Ms) + depthMs;
+        return TailGate::getFeedbackTailSeconds(longestDelayMs * 0.001, feedbackAmount);
+    }
     
     void reset()
     {
-        // Clear delay buffers
-        for (int ch = 0; ch < 2; ++ch)
-        {
-            if (!delayBuffer[ch].empty())
-                std::fill(delayBuffer[ch].begin(), delayBuffer[ch].end(), 0.0f);
-            delayIndex[ch] = 0;
-        }
+        // Clear delay lines
+        delayLine[0].reset();
+        delayLine[1].reset();
         
-        // Reset LFO phases
-        lfoPhase[0] = 0.0f;
-        lfoPhase[1] = juce::MathConstants<float>::pi * 0.5f;
+        // Reset LFO phase
+        lfo.reset();
         
         // Reset filters
         lpf[0].reset();
@@ -1772,86 +1912,70 @@ public:
     
     void processBlock(juce::AudioBuffer<float>& buffer)
     {
-        if (!isEnabled || sampleRate <= 0.0)
+        if (!isEnabled || sampleRate <= 0.0 || !delayLine[0].isPrepared())
             return;
             
         const int numSamples = buffer.getNumSamples();
         const int numChannels = juce::jmin(buffer.getNumChannels(), 2);
+        const float samplesPerMs = static_cast<float>(sampleRate) * 0.001f;
+        const float voiceGain = 1.0f / static_cast<float>(numVoices);
         
         // LPF is updated immediately in setLPFCutoff() - no per-sample updates needed
+        const bool filterWet = currentLPFCutoff < 18000.0f; // Only filter if cutoff is meaningfully low
         
-        for (int sample = 0; sample < numSamples; ++sample)
+        for (int start = 0; start < numSamples; start += controlBlockSize)
         {
-            // Get smoothed parameters
-            float currentRate = rateSmoothing.getNextValue();
-            float currentDepth = depthSmoothing.getNextValue();
-            float currentFeedback = feedbackSmoothing.getNextValue();
-            float currentMix = mixSmoothing.getNextValue();
+            const int blockSamples = juce::jmin(controlBlockSize, numSamples - start);
             
-            // Calculate LFO increment
-            float lfoIncrement = 2.0f * juce::MathConstants<float>::pi * currentRate / static_cast<float>(sampleRate);
+            // The LFO rate moves once per control block; the other parameters per sample
+            lfo.setFrequency(rateSmoothing.skip(blockSamples), sampleRate);
+            lfo.fillBlock(lfoSin, lfoCos, blockSamples);
+            for (int i = 0; i < blockSamples; ++i)
+            {
+                depthSamples[i] = depthSmoothing.getNextValue() * samplesPerMs;
+                feedbackValues[i] = feedbackSmoothing.getNextValue();
+                mixValues[i] = mixSmoothing.getNextValue();
+            }
             
             for (int ch = 0; ch < numChannels; ++ch)
             {
-                // Read input sample
-                float inputSample = buffer.getSample(ch, sample);
-                float drySample = inputSample;
-                
-                // Update LFO
-                lfoPhase[ch] += lfoIncrement;
-                if (lfoPhase[ch] >= 2.0f * juce::MathConstants<float>::pi)
-                    lfoPhase[ch] -= 2.0f * juce::MathConstants<float>::pi;
-                
-                // Calculate modulated delay time
-                float lfoValue = std::sin(lfoPhase[ch]);
-                float baseDelay = (ch == 0) ? delay1Ms : delay2Ms;
-                float modulatedDelayMs = baseDelay + (currentDepth * lfoValue);
+                float* data = buffer.getWritePointer(ch, start);
+                auto& line = delayLine[ch];
+                const float* baseDelay = voiceBaseDelay[ch];
+                const float* phaseCos = voicePhaseCos[ch];
+                const float* phaseSin = voicePhaseSin[ch];
                 
-                // Convert to samples and clamp
-                float delaySamples = modulatedDelayMs * static_cast<float>(sampleRate) / 1000.0f;
-                delaySamples = juce::jlimit(1.0f, static_cast<float>(delayBufferSize - 1), delaySamples);
-                
-                // Calculate interpolated delay tap
-                int delayInt = static_cast<int>(delaySamples);
-                float delayFrac = delaySamples - delayInt;
-                
-                int readPos1 = (delayIndex[ch] - delayInt + delayBufferSize) % delayBufferSize;
-                int readPos2 = (readPos1 - 1 + delayBufferSize) % delayBufferSize;
-                
-                float sample1 = delayBuffer[ch][readPos1];
-                float sample2 = delayBuffer[ch][readPos2];
-                float delayedSample = sample1 + delayFrac * (sample2 - sample1); // Linear interpolation
-                
-                // Apply feedback
-                float feedbackSample = inputSample + (currentFeedback * delayedSample);
-                
-                // Write to delay buffer
-                delayBuffer[ch][delayIndex[ch]] = feedbackSample;
-                
-                // Create wet signal and apply lowpass filter to wet signal (if cutoff is low enough to matter)
-                float wetSample;
-                if (currentLPFCutoff < 18000.0f) // Only filter if cutoff is meaningfully low
-                {
-                    wetSample = lpf[ch].processSample(delayedSample, ch);
-                }
-                else
+                for (int i = 0; i < blockSamples; ++i)
                 {
-                    wetSample = delayedSample; // Bypass filter when at high frequencies
+                    const float inputSample = data[i];
+                    
+                    // Sum the voices, each at its own base delay and LFO phase
+                    float delayedSample = 0.0f;
+                    for (int voice = 0; voice < numVoices; ++voice)
+                    {
+                        const float lfoValue = lfoSin[i] * phaseCos[voice] + lfoCos[i] * phaseSin[voice];
+                        delayedSample += line.read(baseDelay[voice] + depthSamples[i] * lfoValue);
+                    }
+                    delayedSample *= voiceGain;
+                    
+                    // Apply feedback
+                    line.write(inputSample + feedbackValues[i] * delayedSample);
+                    
+                    // Lowpass the wet signal, then mix dry and wet
+                    const float wetSample = filterWet ? lpf[ch].processSample(delayedSample, ch) : delayedSample;
+                    data[i] = inputSample * (1.0f - mixValues[i]) + wetSample * mixValues[i];
                 }
-                
-                // Mix dry and wet
-                float outputSample = drySample * (1.0f - currentMix) + wetSample * currentMix;
-                
-                // Write back to buffer
-                buffer.setSample(ch, sample, outputSample);
-                
-                // Advance delay index
-                delayIndex[ch] = (delayIndex[ch] + 1) % delayBufferSize;
             }
         }
     }
     
 private:
+    static constexpr int controlBlockSize = 64;
+    
+    // Linear taps keep many voices cheap; the slight dulling they add is masked by the
+    // sum of the voices and the wet lowpass
+    using DelayLine = ModulatedDelayLine<DelayInterpolation::LINEAR>;
+    
     void updateLPF()
     {
         lpf[0].setCutoffFrequency(currentLPFCutoff);
@@ -1865,6 +1989,26 @@ private:
         lpf[1].setFilterSlope(SimpleStableFilter::SLOPE_12DB); // Standard 12dB slope
     }
     
+    // Tap delays (in samples) and LFO phase offsets for every voice of both channels
+    void updateVoiceLayout()
+    {
+        const float samplesPerMs = static_cast<float>(sampleRate) * 0.001f;
+        for (int voice = 0; voice < numVoices; ++voice)
+        {
+            const float spread = static_cast<float>(voice) / static_cast<float>(numVoices - 1);
+            const float phase = juce::MathConstants<float>::twoPi * static_cast<float>(voice) / static_cast<float>(numVoices);
+            
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                const float position = ch == 0 ? spread : 1.0f - spread;
+                const float channelPhase = phase + (ch == 0 ? 0.0f : juce::MathConstants<float>::halfPi);
+                voiceBaseDelay[ch][voice] = (delay1Ms + position * (delay2Ms - delay1Ms)) * samplesPerMs;
+                voicePhaseCos[ch][voice] = std::cos(channelPhase);
+                voicePhaseSin[ch][voice] = std::sin(channelPhase);
+            }
+        }
+    }
+    
     // Parameters
     bool isEnabled = false;
     float rateHz = 2.0f;
@@ -1875,16 +2019,25 @@ private:
     float lpfCutoff = 20000.0f;
     float wetMix = 0.5f;
     float currentLPFCutoff = 20000.0f;
+    int numVoices = minVoices;
     
     // Parameter smoothing
     OnePoleSmoothing rateSmoothing, depthSmoothing, feedbackSmoothing, mixSmoothing, lpfCutoffSmoothing;
     
     // Processing state
     double sampleRate = 44100.0;
-    std::vector<float> delayBuffer[2]; // Stereo delay buffers
-    int delayBufferSize = 0;
-    int delayIndex[2] = {0, 0};
-    float lfoPhase[2] = {0.0f, 0.0f}; // LFO phases for L/R channels
+    DelayLine delayLine[2]; // Stereo delay lines
+    QuadratureOscillator lfo;
+    float voiceBaseDelay[2][maxVoices] = {};
+    float voicePhaseCos[2][maxVoices] = {};
+    float voicePhaseSin[2][maxVoices] = {};
+    
+    // Per-sample values for the current control block
+    float lfoSin[controlBlockSize] = {};
+    float lfoCos[controlBlockSize] = {};
+    float depthSamples[controlBlockSize] = {};
+    float feedbackValues[controlBlockSize] = {};
+    float mixValues[controlBlockSize] = {};
     
     // Built-in lowpass filters
     SimpleStableFilter lpf[2];
@@ -1896,10 +2049,6 @@ class FlangerEffect
 public:
     FlangerEffect()
     {
-        // Initialize LFO phases - offset by 90 degrees for stereo width
-        lfoPhase[0] = 0.0f;
-        lfoPhase[1] = juce::MathConstants<float>::pi * 0.5f; // 90 degree offset
-        
         reset();
     }
     
@@ -1923,14 +2072,16 @@ public:
         phaseSmoothing.setSampleRate(sampleRate);
         phaseSmoothing.setTimeConstantMs(50.0f); // Slower smoothing for phase changes
         
-        // Allocate delay buffers - maximum 20ms for flanger
-        int maxDelaySize = static_cast<int>(sampleRate * 0.02); // 20ms
-        delayBuffer[0].resize(maxDelaySize, 0.0f);
-        delayBuffer[1].resize(maxDelaySize, 0.0f);
-        delayBufferSize = maxDelaySize;
+        // Allocate delay lines - maximum 20ms for flanger
+        const int maxDelaySize = static_cast<int>(sampleRate * 0.02); // 20ms
+        delayLine[0].prepare(maxDelaySize);
+        delayLine[1].prepare(maxDelaySize);
+        tap[0] = {};
+        tap[1] = {};
     }
     
     void setEnabled(bool enabled) { isEnabled = enabled; }
+    bool getEnabled() const { return isEnabled; }
     void setRate(float rate) { 
         rateHz = juce::jlimit(0.1f, 10.0f, rate);
         rateSmoothing.setTarget(rateHz);
@@ -1952,16 +2103,19 @@ public:
         phaseSmoothing.setTarget(phaseOffset);
     }
     
+    double getTailLengthSeconds() const
+    {
+        if (!isEnabled)
+            return 0.0;
+        return TailGate::getFeedbackTailSeconds(0.02, feedbackAmount); // 20ms delay buffer
+    }
+    
     void reset()
     {
-        delayIndex[0] = 0;
-        delayIndex[1] = 0;
-        
-        if (!delayBuffer[0].empty())
-        {
-            std::fill(delayBuffer[0].begin(), delayBuffer[0].end(), 0.0f);
-            std::fill(delayBuffer[1].begin(), delayBuffer[1].end(), 0.0f);
-        }
+        delayLine[0].reset();
+        delayLine[1].reset();
+        tap[0] = {};
+        tap[1] = {};
         
         // Reset smoothing
         rateSmoothing.reset(rateHz);
@@ -1979,70 +2133,64 @@ public:
         const int numSamples = buffer.getNumSamples();
         const int numChannels = juce::jmin(buffer.getNumChannels(), 2);
         
-        if (numSamples <= 0 || numChannels <= 0 || delayBufferSize <= 0)
+        if (numSamples <= 0 || numChannels <= 0 || !delayLine[0].isPrepared())
             return;
         
-        for (int sample = 0; sample < numSamples; ++sample)
+        const float samplesPerMs = static_cast<float>(sampleRate) * 0.001f;
+        
+        for (int start = 0; start < numSamples; start += controlBlockSize)
         {
-            // Get smoothed parameters
-            float currentRate = rateSmoothing.getNextValue();
-            float currentDepth = depthSmoothing.getNextValue();
-            float currentFeedback = feedbackSmoothing.getNextValue();
-            float currentMix = mixSmoothing.getNextValue();
-            float currentPhase = phaseSmoothing.getNextValue();
+            const int blockSamples = juce::jmin(controlBlockSize, numSamples - start);
+            
+            // The LFO rate and the right channel's phase move once per control block
+            lfo.setFrequency(rateSmoothing.skip(blockSamples), sampleRate);
+            lfo.fillBlock(lfoSin, lfoCos, blockSamples);
+            const float rightPhase = juce::MathConstants<float>::halfPi + phaseSmoothing.skip(blockSamples);
+            const float rightPhaseCos = std::cos(rightPhase);
+            const float rightPhaseSin = std::sin(rightPhase);
             
-            // Calculate LFO increment
-            float lfoIncrement = 2.0f * juce::MathConstants<float>::pi * currentRate / static_cast<float>(sampleRate);
+            for (int i = 0; i < blockSamples; ++i)
+            {
+                depthValues[i] = depthSmoothing.getNextValue();
+                feedbackValues[i] = feedbackSmoothing.getNextValue();
+                mixValues[i] = mixSmoothing.getNextValue();
+            }
             
             for (int ch = 0; ch < numChannels; ++ch)
             {
-                // Read input sample
-                float inputSample = buffer.getSample(ch, sample);
-                float drySample = inputSample;
-                
-                // Update LFO with phase offset for right channel
-                float effectivePhase = lfoPhase[ch];
-                if (ch == 1) // Right channel gets phase offset
-                    effectivePhase += currentPhase;
-                
-                lfoPhase[ch] += lfoIncrement;
-                if (lfoPhase[ch] >= 2.0f * juce::MathConstants<float>::pi)
-                    lfoPhase[ch] -= 2.0f * juce::MathConstants<float>::pi;
-                
-                // Calculate modulated delay time (flanger uses shorter delays than chorus)
-                float lfoValue = std::sin(effectivePhase);
-                float delayMs = 1.0f + (currentDepth * 0.5f * (1.0f + lfoValue)); // 1-6ms range typically
-                float delaySamples = delayMs * static_cast<float>(sampleRate) / 1000.0f;
-                
-                // Ensure delay is within bounds
-                delaySamples = juce::jlimit(1.0f, static_cast<float>(delayBufferSize - 1), delaySamples);
-                
-                // Linear interpolation for smooth delay modulation
-                int delayInt = static_cast<int>(delaySamples);
-                float delayFrac = delaySamples - delayInt;
-                
-                int readIndex1 = (delayIndex[ch] - delayInt + delayBufferSize) % delayBufferSize;
-                int readIndex2 = (readIndex1 - 1 + delayBufferSize) % delayBufferSize;
-                
-                float delayedSample1 = delayBuffer[ch][readIndex1];
-                float delayedSample2 = delayBuffer[ch][readIndex2];
-                float interpolatedSample = delayedSample1 + delayFrac * (delayedSample2 - delayedSample1);
-                
-                // Apply feedback
-                float feedbackSample = inputSample + currentFeedback * interpolatedSample;
+                float* data = buffer.getWritePointer(ch, start);
+                auto& line = delayLine[ch];
                 
-                // Write to delay buffer
-                delayBuffer[ch][delayIndex[ch]] = feedbackSample;
-                delayIndex[ch] = (delayIndex[ch] + 1) % delayBufferSize;
+                // The right channel runs a quarter cycle plus the phase setting ahead
+                const float phaseCos = ch == 0 ? 1.0f : rightPhaseCos;
+                const float phaseSin = ch == 0 ? 0.0f : rightPhaseSin;
                 
-                // Mix dry and wet signals
-                float output = drySample + currentMix * (interpolatedSample - drySample);
-                buffer.setSample(ch, sample, output);
+                for (int i = 0; i < blockSamples; ++i)
+                {
+                    const float inputSample = data[i];
+                    
+                    // Calculate modulated delay time (flanger uses shorter delays than chorus)
+                    const float lfoValue = lfoSin[i] * phaseCos + lfoCos[i] * phaseSin;
+                    const float delayMs = 1.0f + (depthValues[i] * 0.5f * (1.0f + lfoValue)); // 1-6ms range typically
+                    const float delayedSample = line.read(delayMs * samplesPerMs, tap[ch]);
+                    
+                    // Apply feedback
+                    line.write(inputSample + feedbackValues[i] * delayedSample);
+                    
+                    // Mix dry and wet signals
+                    data[i] = inputSample + mixValues[i] * (delayedSample - inputSample);
+                }
             }
         }
     }
     
 private:
+    static constexpr int controlBlockSize = 64;
+    
+    // Allpass interpolation keeps the feedback loop's response flat, which the sharp
+    // flanger notches need, and the sweeps are slow enough for its coefficient changes
+    using DelayLine = ModulatedDelayLine<DelayInterpolation::ALLPASS>;
+    
     // Parameters
     bool isEnabled = false;
     float rateHz = 1.0f;
@@ -2056,64 +2204,26 @@ private:
     
     // Processing state
     double sampleRate = 44100.0;
-    std::vector<float> delayBuffer[2]; // Stereo delay buffers
-    int delayBufferSize = 0;
-    int delayIndex[2] = {0, 0};
-    float lfoPhase[2] = {0.0f, 0.0f}; // LFO phases for L/R channels
-};
-
-// First-order all-pass filter for phaser effect
-class AllPassFilter
-{
-public:
-    AllPassFilter() = default;
-    
-    void setSampleRate(double newSampleRate)
-    {
-        sampleRate = newSampleRate;
-    }
-    
-    void setCoefficient(float coeff)
-    {
-        // Coefficient should be between -1 and 1
-        a = juce::jlimit(-0.99f, 0.99f, coeff);
-    }
-    
-    void reset()
-    {
-        x1 = 0.0f;
-        y1 = 0.0f;
-    }
-    
-    float processSample(float input)
-    {
-        // First-order all-pass: y[n] = -a*x[n] + x[n-1] + a*y[n-1]
-        float output = -a * input + x1 + a * y1;
-        
-        // Update delay elements
-        x1 = input;
-        y1 = output;
-        
-        return output;
-    }
-    
-private:
-    double sampleRate = 44100.0;
-    float a = 0.0f;  // All-pass coefficient
-    float x1 = 0.0f; // Input delay
-    float y1 = 0.0f; // Output delay
+    DelayLine delayLine[2]; // Stereo delay lines
+    DelayLine::Tap tap[2];
+    QuadratureOscillator lfo;
+    
+    // Per-sample values for the current control block
+    float lfoSin[controlBlockSize] = {};
+    float lfoCos[controlBlockSize] = {};
+    float depthValues[controlBlockSize] = {};
+    float feedbackValues[controlBlockSize] = {};
+    float mixValues[controlBlockSize] = {};
 };
 
-// Multi-stage stereo phaser effect
+// Multi-stage stereo phaser effect. The stage coefficients follow the LFO at a control
+// rate and ramp linearly in between, and the left and right all-pass chains run side by
+// side as lanes 0 and 1 of one SIMD register (lanes 2 and 3 are idle).
 class PhaserEffect
 {
 public:
     PhaserEffect()
     {
-        // Initialize LFO phases - offset by 90 degrees for stereo width
-        lfoPhase[0] = 0.0f;
-        lfoPhase[1] = juce::MathConstants<float>::pi * 0.5f; // 90 degree offset
-        
         reset();
     }
     
@@ -2143,18 +2253,12 @@ public:
         frequencySmoothing.setSampleRate(sampleRate);
         frequencySmoothing.setTimeConstantMs(30.0f);
         
-        // Initialize all-pass filters
-        for (int ch = 0; ch < 2; ++ch)
-        {
-            for (int stage = 0; stage < MAX_POLES; ++stage)
-            {
-                allPassFilters[ch][stage].setSampleRate(sampleRate);
-                allPassFilters[ch][stage].setCoefficient(0.5f); // Start with neutral coefficient
-            }
-        }
+        // The first control block jumps straight to its coefficients
+        coefficientsValid = false;
     }
     
     void setEnabled(bool enabled) { isEnabled = enabled; }
+    bool getEnabled() const { return isEnabled; }
     void setRate(float rate) { 
         rateHz = juce::jlimit(0.1f, 10.0f, rate);
         rateSmoothing.setTarget(rateHz);
@@ -2187,16 +2291,28 @@ public:
         numPoles = juce::jlimit(1, MAX_POLES, poles);
     }
     
+    // Each all-pass stage rings for roughly its time constant at the lowest sweep frequency
+    double getTailLengthSeconds() const
+    {
+        if (!isEnabled)
+            return 0.0;
+        const double stageSeconds = -std::log(static_cast<double>(TailGate::silenceThreshold)) / (juce::MathConstants<double>::twoPi * 20.0);
+        return TailGate::getFeedbackTailSeconds(stageSeconds * numPoles, feedbackAmount);
+    }
+    
     void reset()
     {
-        for (int ch = 0; ch < 2; ++ch)
+        for (int stage = 0; stage < MAX_POLES; ++stage)
         {
-            for (int stage = 0; stage < MAX_POLES; ++stage)
+            for (int lane = 0; lane < 4; ++lane)
             {
-                allPassFilters[ch][stage].reset();
+                stageInputs[stage][lane] = 0.0f;
+                stageOutputs[stage][lane] = 0.0f;
             }
-            feedbackDelay[ch] = 0.0f;
         }
+        for (int lane = 0; lane < 4; ++lane)
+            feedbackDelay[lane] = 0.0f;
+        coefficientsValid = false;
         
         // Reset smoothing
         rateSmoothing.reset(rateHz);
@@ -2219,83 +2335,108 @@ public:
         if (numSamples <= 0 || numChannels <= 0)
             return;
         
-        for (int sample = 0; sample < numSamples; ++sample)
+        float* left = buffer.getWritePointer(0);
+        float* right = numChannels > 1 ? buffer.getWritePointer(1) : nullptr;
+        alignas(16) float output[4];
+        
+        auto feedback = SimdFloat4::load(feedbackDelay);
+        
+        for (int start = 0; start < numSamples; start += controlInterval)
         {
-            // Get smoothed parameters
-            float currentRate = rateSmoothing.getNextValue();
-            float currentDepth1 = depth1Smoothing.getNextValue();
-            float currentDepth2 = depth2Smoothing.getNextValue();
-            float currentFeedback = feedbackSmoothing.getNextValue();
-            float currentMix = mixSmoothing.getNextValue();
-            float currentPhase = phaseSmoothing.getNextValue();
-            float currentFreq = frequencySmoothing.getNextValue();
-            
-            // Calculate LFO increment
-            float lfoIncrement = 2.0f * juce::MathConstants<float>::pi * currentRate / static_cast<float>(sampleRate);
+            const int blockSamples = juce::jmin(controlInterval, numSamples - start);
+            updateCoefficients(blockSamples);
             
-            for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = start; i < start + blockSamples; ++i)
             {
-                // Read input sample
-                float inputSample = buffer.getSample(ch, sample);
-                float drySample = inputSample;
-                
-                // Update LFO with phase offset for right channel
-                float effectivePhase = lfoPhase[ch];
-                if (ch == 1) // Right channel gets phase offset
-                    effectivePhase += currentPhase;
+                const float currentFeedback = feedbackSmoothing.getNextValue();
+                const float currentMix = mixSmoothing.getNextValue();
                 
-                lfoPhase[ch] += lfoIncrement;
-                if (lfoPhase[ch] >= 2.0f * juce::MathConstants<float>::pi)
-                    lfoPhase[ch] -= 2.0f * juce::MathConstants<float>::pi;
-                
-                // Calculate LFO values - use both depth controls to modulate different aspects
-                float lfo1Value = std::sin(effectivePhase);
-                float lfo2Value = std::sin(effectivePhase + juce::MathConstants<float>::pi * 0.25f);
-                
-                // Calculate all-pass coefficients based on frequency and LFO modulation
-                // Map frequency to coefficient range for musical phasing
-                float baseCoeff = (currentFreq - 20.0f) / (2000.0f - 20.0f); // Normalize 20-2000Hz to 0-1
-                baseCoeff = baseCoeff * 1.8f - 0.9f; // Map to -0.9 to 0.9 range
-                
-                // Modulate coefficients with LFO
-                float depthScale1 = currentDepth1 * 0.6f; // Scale depth to reasonable range
-                float depthScale2 = currentDepth2 * 0.4f;
+                const auto dry = SimdFloat4::fromValues(left[i], right != nullptr ? right[i] : 0.0f, 0.0f, 0.0f);
                 
                 // Add feedback before all-pass processing
-                float feedbackSample = inputSample + currentFeedback * feedbackDelay[ch];
-                
-                // Process through all-pass filter stages
-                float allPassOutput = feedbackSample;
+                auto signal = dry + SimdFloat4::expand(currentFeedback) * feedback;
                 
+                // First-order all-pass per stage: y[n] = a * (y[n-1] - x[n]) + x[n-1]
                 for (int stage = 0; stage < numPoles; ++stage)
                 {
-                    // Use different LFO modulation for different stages to create complex phasing
-                    float stageModulation = (stage % 2 == 0) ? lfo1Value * depthScale1 : lfo2Value * depthScale2;
-                    
-                    // Calculate stage-specific coefficient
-                    float stageOffset = (float)stage / (float)numPoles * 0.3f; // Spread stages
-                    float stageCoeff = baseCoeff + stageModulation + stageOffset;
-                    
-                    allPassFilters[ch][stage].setCoefficient(stageCoeff);
-                    allPassOutput = allPassFilters[ch][stage].processSample(allPassOutput);
+                    const auto a = SimdFloat4::load(coefficients[stage]);
+                    const auto allPassOutput = a * (SimdFloat4::load(stageOutputs[stage]) - signal) + SimdFloat4::load(stageInputs[stage]);
+                    signal.store(stageInputs[stage]);
+                    allPassOutput.store(stageOutputs[stage]);
+                    (a + SimdFloat4::load(coefficientSteps[stage])).store(coefficients[stage]);
+                    signal = allPassOutput;
                 }
                 
                 // Store feedback (from all-pass output, not final mix)
-                feedbackDelay[ch] = allPassOutput;
+                feedback = signal;
                 
-                // The KEY to phasing: mix the all-pass filtered signal with the dry signal
-                // This creates the characteristic notches due to phase cancellation
-                float phasedSignal = drySample + allPassOutput;
-                
-                // Final mix control
-                float output = drySample + currentMix * (phasedSignal - drySample);
-                buffer.setSample(ch, sample, output);
+                // The KEY to phasing: the all-pass output summed with the dry signal
+                // notches where the two are out of phase. Mixing that against the dry
+                // signal leaves dry + mix * all-pass.
+                (dry + SimdFloat4::expand(currentMix) * signal).store(output);
+                left[i] = output[0];
+                if (right != nullptr)
+                    right[i] = output[1];
             }
         }
+        
+        feedback.store(feedbackDelay);
     }
     
 private:
     static constexpr int MAX_POLES = 16;
+    static constexpr int controlInterval = 32; // Samples between coefficient updates
+    
+    // Moves the LFO on by one control block and sets every stage to ramp from its current
+    // coefficient to the one at the end of the block
+    void updateCoefficients(int blockSamples)
+    {
+        const float currentRate = rateSmoothing.skip(blockSamples);
+        const float currentDepth1 = depth1Smoothing.skip(blockSamples);
+        const float currentDepth2 = depth2Smoothing.skip(blockSamples);
+        const float currentPhase = phaseSmoothing.skip(blockSamples);
+        const float currentFreq = frequencySmoothing.skip(blockSamples);
+        
+        lfoPhase += juce::MathConstants<float>::twoPi * currentRate * static_cast<float>(blockSamples) / static_cast<float>(sampleRate);
+        if (lfoPhase >= juce::MathConstants<float>::twoPi)
+            lfoPhase -= juce::MathConstants<float>::twoPi;
+        
+        // Map frequency to coefficient range for musical phasing
+        float baseCoeff = (currentFreq - 20.0f) / (2000.0f - 20.0f); // Normalize 20-2000Hz to 0-1
+        baseCoeff = baseCoeff * 1.8f - 0.9f; // Map to -0.9 to 0.9 range
+        
+        // Scale depth to reasonable range
+        const float depthScale1 = currentDepth1 * 0.6f;
+        const float depthScale2 = currentDepth2 * 0.4f;
+        
+        // Two LFOs per channel, the second an eighth of a cycle on; the right channel runs
+        // a quarter cycle plus the phase setting ahead of the left
+        float lfo1Values[2], lfo2Values[2];
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            const float effectivePhase = lfoPhase + (ch == 1 ? juce::MathConstants<float>::halfPi + currentPhase : 0.0f);
+            lfo1Values[ch] = std::sin(effectivePhase);
+            lfo2Values[ch] = std::sin(effectivePhase + juce::MathConstants<float>::pi * 0.25f);
+        }
+        
+        const float rampScale = 1.0f / static_cast<float>(blockSamples);
+        for (int stage = 0; stage < numPoles; ++stage)
+        {
+            // Alternate stages follow different LFOs, and the stages are spread apart
+            const float stageOffset = (float)stage / (float)numPoles * 0.3f;
+            
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                const float stageModulation = (stage % 2 == 0) ? lfo1Values[ch] * depthScale1 : lfo2Values[ch] * depthScale2;
+                const float target = juce::jlimit(-0.99f, 0.99f, baseCoeff + stageModulation + stageOffset);
+                
+                if (!coefficientsValid)
+                    coefficients[stage][ch] = target;
+                coefficientSteps[stage][ch] = (target - coefficients[stage][ch]) * rampScale;
+            }
+        }
+        coefficientsValid = true;
+    }
     
     // Parameters
     bool isEnabled = false;
@@ -2314,9 +2455,15 @@ private:
     
     // Processing state
     double sampleRate = 44100.0;
-    AllPassFilter allPassFilters[2][MAX_POLES]; // Stereo array of all-pass filters
-    float feedbackDelay[2] = {0.0f, 0.0f}; // Feedback delay for each channel
-    float lfoPhase[2] = {0.0f, 0.0f}; // LFO phases for L/R channels
+    float lfoPhase = 0.0f; // Left channel LFO phase in radians
+    bool coefficientsValid = false;
+    
+    // All-pass chains, one SIMD lane per channel: [left, right, unused, unused]
+    alignas(16) float coefficients[MAX_POLES][4] = {};
+    alignas(16) float coefficientSteps[MAX_POLES][4] = {}; // Per-sample ramp to the next update
+    alignas(16) float stageInputs[MAX_POLES][4] = {};     // x[n-1] of each stage
+    alignas(16) float stageOutputs[MAX_POLES][4] = {};    // y[n-1] of each stage
+    alignas(16) float feedbackDelay[4] = {};              // Feedback delay for each channel
 };
 
 class ReverbEffect
@@ -2328,14 +2475,27 @@ public:
         HALL = 2,       // "HALL"
         VINTAGE = 3,    // "VINTAGE"
         ROOM = 4,       // "ROOM"
-        AMBIENCE = 5    // "AMBIENCE"
+        AMBIENCE = 5,   // "AMBIENCE"
+        CONVOLUTION = 6 // "IMPULSE": a loaded impulse response instead of the FDN
     };
     
+    // Block length for parameter updates; size, damping, width and pre-delay move once per chunk
+    static constexpr int chunkSize = 256;
+    
+    // Longest impulse response kept; anything past this is cut off
+    static constexpr double maxImpulseSeconds = 10.0;
+    
     ReverbEffect()
     {
         reset();
     }
     
+    ~ReverbEffect()
+    {
+        delete pendingConvolver.exchange(nullptr);
+        delete retiredConvolver.exchange(nullptr);
+    }
+    
     void setSampleRate(double newSampleRate)
     {
         sampleRate = newSampleRate;
@@ -2357,36 +2517,37 @@ public:
         widthSmoothing.setSampleRate(sampleRate);
         widthSmoothing.setTimeConstantMs(30.0f);
         
-        // Initialize JUCE Reverb
-        reverb.setSampleRate(sampleRate);
-        updateReverbParameters();
+        // Initialize the FDN engine (allocates every delay line up front)
+        engine.prepare(sampleRate);
+        engine.setAlgorithm(juce::jmin(requestedType.load(), static_cast<int>(AMBIENCE)) - 1);
+        engine.setSizeAndDamping(roomSize, damping);
+        engine.setWidth(width);
         
         // Initialize pre-delay buffer
-        int maxPreDelaySize = static_cast<int>(sampleRate * 0.2); // 200ms max
+        int maxPreDelaySize = static_cast<int>(sampleRate * 0.2) + chunkSize; // 200ms max plus one chunk
         preDelayBufferL.resize(maxPreDelaySize, 0.0f);
         preDelayBufferR.resize(maxPreDelaySize, 0.0f);
         preDelayBufferSize = maxPreDelaySize;
         
         // Initialize filters
-        lowCutFilterL.setSampleRate(sampleRate);
-        lowCutFilterR.setSampleRate(sampleRate);
-        highCutFilterL.setSampleRate(sampleRate);
-        highCutFilterR.setSampleRate(sampleRate);
+        lowCutFilter.setSampleRate(sampleRate);
+        highCutFilter.setSampleRate(sampleRate);
         updateFilters();
         
         reset();
     }
     
     void setEnabled(bool enabled) { isEnabled = enabled; }
+    bool getEnabled() const { return isEnabled; }
     
     void setMix(float mixValue) { 
         wetMix = juce::jlimit(0.0f, 1.0f, mixValue);
         mixSmoothing.setTarget(wetMix);
     }
     
+    // Applied on the audio thread at the start of the next block, since switching clears the network
     void setType(ReverbType type) { 
-        reverbType = type;
-        updateReverbParameters();
+        requestedType.store(type);
     }
     
     void setSize(float size) { 
@@ -2408,7 +2569,6 @@ public:
     void setPreDelay(float delayMs) { 
         preDelayMs = juce::jlimit(0.0f, 200.0f, delayMs);
         preDelaySmoothing.setTarget(preDelayMs);
-        updatePreDelayTime();
     }
     
     void setLowCut(float freq) { 
@@ -2421,6 +2581,52 @@ public:
         updateFilters();
     }
     
+    // The engine's RT60 is the time to fall 60 dB; the tail gate waits for 100 dB.
+    // An impulse response simply lasts as long as it is.
+    double getTailLengthSeconds() const
+    {
+        if (!isEnabled)
+            return 0.0;
+        if (requestedType.load() == CONVOLUTION)
+            return preDelayMs * 0.001 + convolverSeconds.load();
+        const double longestLineSeconds = 0.09;
+        return preDelayMs * 0.001 + engine.getDecaySeconds() * 100.0 / 60.0 + longestLineSeconds;
+    }
+    
+    // Hands over a convolver built for the current sample rate. Called from the thread
+    // that builds them, never the audio thread; the audio thread swaps it in at its next
+    // block. Whatever it replaces is freed here on the following call, so the audio
+    // thread never frees memory.
+    void setConvolver(std::unique_ptr<PartitionedConvolver> newConvolver)
+    {
+        delete retiredConvolver.exchange(nullptr);
+        delete pendingConvolver.exchange(newConvolver.release());
+    }
+    
+    // A dark, decaying stereo noise burst, used until an impulse response is loaded
+    static juce::AudioBuffer<float> makeDefaultImpulse(double sampleRate)
+    {
+        const double decaySeconds = 2.4; // RT60
+        const int length = static_cast<int>(decaySeconds * sampleRate);
+        juce::AudioBuffer<float> impulse(2, length);
+        juce::Random random(0x5eed);
+        
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            float* data = impulse.getWritePointer(ch);
+            float lowpass = 0.0f;
+            for (int i = 0; i < length; ++i)
+            {
+                // Highs die away faster: the smoothing closes in as the tail decays
+                const double t = i / sampleRate;
+                const float coefficient = static_cast<float>(std::exp(-juce::MathConstants<double>::twoPi * (9000.0 * std::exp(-1.5 * t) + 500.0) / sampleRate));
+                lowpass = (2.0f * random.nextFloat() - 1.0f) * (1.0f - coefficient) + lowpass * coefficient;
+                data[i] = lowpass * static_cast<float>(std::exp(-6.9 * t / decaySeconds));
+            }
+        }
+        return impulse;
+    }
+    
     void processBlock(juce::AudioBuffer<float>& buffer)
     {
         if (!isEnabled)
@@ -2431,55 +2637,78 @@ public:
         
         if (numChannels < 2)
             return;
+        
+        pickUpConvolver();
+        
+        // Switching clears the old tail, like a change of FDN algorithm
+        const int type = requestedType.load();
+        const bool convolution = type == CONVOLUTION;
+        if (convolution && activeType != CONVOLUTION && convolver != nullptr)
+            convolver->reset();
+        else if (!convolution && type - 1 != engine.getAlgorithm())
+            engine.setAlgorithm(type - 1);
+        activeType = type;
             
         float* leftChannel = buffer.getWritePointer(0);
         float* rightChannel = buffer.getWritePointer(1);
         
-        // Update smoothed parameters
-        for (int sample = 0; sample < numSamples; ++sample)
+        // The convolver's latency comes out of the pre-delay, so the onset stays where it is set
+        const float convolverLatencyMs = static_cast<float>(PartitionedConvolver::headBlockSize * 1000.0 / sampleRate);
+        
+        for (int start = 0; start < numSamples; start += chunkSize)
         {
-            float currentMix = mixSmoothing.getNextValue();
-            float currentSize = sizeSmoothing.getNextValue();
-            float currentDamp = dampSmoothing.getNextValue();
-            float currentWidth = widthSmoothing.getNextValue();
-            float currentPreDelay = preDelaySmoothing.getNextValue();
-            
-            // Update reverb parameters if they changed
-            updateReverbParametersIfNeeded(currentSize, currentDamp, currentWidth);
-            
-            // Store dry signals
-            float dryL = leftChannel[sample];
-            float dryR = rightChannel[sample];
+            const int n = juce::jmin(chunkSize, numSamples - start);
+            float* left = leftChannel + start;
+            float* right = rightChannel + start;
             
-            // Apply pre-delay
-            float delayedL = applyPreDelay(dryL, 0, currentPreDelay);
-            float delayedR = applyPreDelay(dryR, 1, currentPreDelay);
+            // Block-rate parameters, advanced by the whole chunk
+            const float currentSize = sizeSmoothing.skip(n);
+            const float currentDamping = dampSmoothing.skip(n);
+            const float currentWidth = widthSmoothing.skip(n);
+            const float currentPreDelay = preDelaySmoothing.skip(n);
             
-            // Apply filters before reverb
-            delayedL = lowCutFilterL.processSample(delayedL, 0);
-            delayedL = highCutFilterL.processSample(delayedL, 0);
-            delayedR = lowCutFilterR.processSample(delayedR, 1);
-            delayedR = highCutFilterR.processSample(delayedR, 1);
+            // Pre-delay, then band-limit the send before it enters the network
+            applyPreDelay(left, right, n, convolution ? juce::jmax(0.0f, currentPreDelay - convolverLatencyMs) : currentPreDelay);
+            lowCutFilter.processBlock(wetLeft, wetRight, n);
+            highCutFilter.processBlock(wetLeft, wetRight, n);
             
-            // Process through reverb
-            float reverbL = delayedL;
-            float reverbR = delayedR;
-            reverb.processStereo(&reverbL, &reverbR, 1);
+            if (!convolution)
+            {
+                engine.setSizeAndDamping(currentSize, currentDamping);
+                engine.setWidth(currentWidth);
+                engine.process(wetLeft, wetRight, wetLeft, wetRight, n);
+            }
+            else if (convolver != nullptr)
+            {
+                convolver->process(wetLeft, wetRight, wetLeft, wetRight, n);
+                applyWidth(n, currentWidth);
+            }
+            else
+            {
+                std::fill(wetLeft, wetLeft + n, 0.0f);
+                std::fill(wetRight, wetRight + n, 0.0f);
+            }
             
-            // Mix wet and dry signals
-            leftChannel[sample] = dryL * (1.0f - currentMix) + reverbL * currentMix;
-            rightChannel[sample] = dryR * (1.0f - currentMix) + reverbR * currentMix;
+            // Mix wet and dry signals, with the mix smoothed per sample
+            for (int i = 0; i < n; ++i)
+            {
+                const float currentMix = mixSmoothing.getNextValue();
+                left[i] = left[i] * (1.0f - currentMix) + wetLeft[i] * currentMix;
+                right[i] = right[i] * (1.0f - currentMix) + wetRight[i] * currentMix;
+            }
         }
     }
     
     void reset()
     {
-        reverb.reset();
+        engine.reset();
+        if (convolver != nullptr)
+            convolver->reset();
         
         // Clear pre-delay buffers
         std::fill(preDelayBufferL.begin(), preDelayBufferL.end(), 0.0f);
         std::fill(preDelayBufferR.begin(), preDelayBufferR.end(), 0.0f);
-        preDelayIndexL = preDelayIndexR = 0;
+        preDelayWriteIndex = 0;
         
         // Reset parameter smoothing
         mixSmoothing.reset(wetMix);
@@ -2489,117 +2718,65 @@ public:
         widthSmoothing.reset(width);
         
         // Reset filters
-        lowCutFilterL.reset();
-        lowCutFilterR.reset();
-        highCutFilterL.reset();
-        highCutFilterR.reset();
+        lowCutFilter.reset();
+        highCutFilter.reset();
     }
 
 private:
-    void updateReverbParameters()
+    // Audio thread: takes a newly built convolver, unless the last one it replaced has not
+    // been collected yet, in which case it tries again next block
+    void pickUpConvolver()
     {
-        juce::Reverb::Parameters params;
-        
-        // Base parameters based on reverb type
-        // Use damping for reverb tail control
-        float effectiveDamping = damping;
+        if (retiredConvolver.load() != nullptr)
+            return;
         
-        switch (reverbType)
+        if (auto* next = pendingConvolver.exchange(nullptr))
         {
-            case PLATE:
-                params.roomSize = (roomSize * 0.8f + 0.1f);  // Plate reverb size
-                params.damping = effectiveDamping * 0.3f + 0.1f;
-                params.wetLevel = 1.0f;
-                params.dryLevel = 0.0f;
-                params.width = width;
-                params.freezeMode = 0.0f;
-                break;
-                
-            case HALL:
-                params.roomSize = (roomSize * 0.9f + 0.1f);  // Hall reverb size
-                params.damping = effectiveDamping * 0.4f + 0.2f;
-                params.wetLevel = 1.0f;
-                params.dryLevel = 0.0f;
-                params.width = width;
-                params.freezeMode = 0.0f;
-                break;
-                
-            case VINTAGE:
-                params.roomSize = (roomSize * 0.6f + 0.3f);  // Vintage reverb size
-                params.damping = effectiveDamping * 0.7f + 0.3f;
-                params.wetLevel = 1.0f;
-                params.dryLevel = 0.0f;
-                params.width = width * 0.8f;
-                params.freezeMode = 0.0f;
-                break;
-                
-            case ROOM:
-                params.roomSize = (roomSize * 0.5f + 0.1f);  // Room reverb size
-                params.damping = effectiveDamping * 0.8f + 0.2f;
-                params.wetLevel = 1.0f;
-                params.dryLevel = 0.0f;
-                params.width = width;
-                params.freezeMode = 0.0f;
-                break;
-                
-            case AMBIENCE:
-                params.roomSize = (roomSize * 0.3f + 0.05f); // Ambience reverb size
-                params.damping = effectiveDamping * 0.9f + 0.1f;
-                params.wetLevel = 1.0f;
-                params.dryLevel = 0.0f;
-                params.width = width * 1.2f;
-                params.freezeMode = 0.0f;
-                break;
+            retiredConvolver.store(convolver.release());
+            convolver.reset(next);
+            convolverSeconds.store(next->getLength() / sampleRate);
         }
-        
-        reverb.setParameters(params);
-        lastSize = roomSize;
-        lastDamping = damping;
-        lastWidth = width;
     }
     
-    inline void updateReverbParametersIfNeeded(float currentSize, float currentDamp, float currentWidth)
+    // Mid/side width for the convolution output; the FDN sets its own width
+    void applyWidth(int numSamples, float currentWidth)
     {
-        if (std::abs(currentSize - lastSize) > 0.001f ||
-            std::abs(currentDamp - lastDamping) > 0.001f ||
-            std::abs(currentWidth - lastWidth) > 0.001f)
+        for (int i = 0; i < numSamples; ++i)
         {
-            roomSize = currentSize;
-            damping = currentDamp;
-            width = currentWidth;
-            updateReverbParameters();
+            const float mid = 0.5f * (wetLeft[i] + wetRight[i]);
+            const float side = 0.5f * (wetLeft[i] - wetRight[i]) * currentWidth;
+            wetLeft[i] = mid + side;
+            wetRight[i] = mid - side;
         }
     }
     
-    void updatePreDelayTime()
+    // Writes the dry chunk into the pre-delay line and reads the delayed send into wetLeft/wetRight
+    void applyPreDelay(const float* left, const float* right, int numSamples, float currentDelayMs)
     {
-        if (sampleRate > 0.0)
+        if (preDelayBufferSize <= 0 || currentDelayMs <= 0.0f)
         {
-            preDelaySamples = static_cast<int>(preDelayMs * 0.001f * sampleRate);
-            preDelaySamples = juce::jlimit(0, preDelayBufferSize - 1, preDelaySamples);
+            std::copy(left, left + numSamples, wetLeft);
+            std::copy(right, right + numSamples, wetRight);
+            return;
         }
-    }
-    
-    float applyPreDelay(float input, int channel, float currentDelayMs)
-    {
-        if (currentDelayMs <= 0.0f)
-            return input;
-            
-        auto& buffer = (channel == 0) ? preDelayBufferL : preDelayBufferR;
-        auto& index = (channel == 0) ? preDelayIndexL : preDelayIndexR;
         
         int delaySamples = static_cast<int>(currentDelayMs * 0.001f * sampleRate);
-        delaySamples = juce::jlimit(0, preDelayBufferSize - 1, delaySamples);
-        
-        // Read delayed sample
-        int readIndex = (index - delaySamples + preDelayBufferSize) % preDelayBufferSize;
-        float output = buffer[readIndex];
-        
-        // Write new sample
-        buffer[index] = input;
-        index = (index + 1) % preDelayBufferSize;
+        delaySamples = juce::jlimit(0, preDelayBufferSize - chunkSize, delaySamples);
+        int readIndex = (preDelayWriteIndex - delaySamples + preDelayBufferSize) % preDelayBufferSize;
         
-        return output;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            // Write first so a zero delay passes the input straight through
+            preDelayBufferL[preDelayWriteIndex] = left[i];
+            preDelayBufferR[preDelayWriteIndex] = right[i];
+            wetLeft[i] = preDelayBufferL[readIndex];
+            wetRight[i] = preDelayBufferR[readIndex];
+            
+            if (++preDelayWriteIndex == preDelayBufferSize)
+                preDelayWriteIndex = 0;
+            if (++readIndex == preDelayBufferSize)
+                readIndex = 0;
+        }
     }
     
     void updateFilters()
@@ -2608,27 +2785,19 @@ private:
             return;
             
         // Low cut filter (high-pass)
-        lowCutFilterL.setFilterType(SimpleStableFilter::HIGHPASS);
-        lowCutFilterL.setCutoffFrequency(lowCutFreq);
-        lowCutFilterL.setResonance(0.707f);
-        
-        lowCutFilterR.setFilterType(SimpleStableFilter::HIGHPASS);
-        lowCutFilterR.setCutoffFrequency(lowCutFreq);
-        lowCutFilterR.setResonance(0.707f);
+        lowCutFilter.setFilterType(SimpleStableFilter::HIGHPASS);
+        lowCutFilter.setCutoffFrequency(lowCutFreq);
+        lowCutFilter.setResonance(0.707f);
         
         // High cut filter (low-pass)
-        highCutFilterL.setFilterType(SimpleStableFilter::LOWPASS);
-        highCutFilterL.setCutoffFrequency(highCutFreq);
-        highCutFilterL.setResonance(0.707f);
-        
-        highCutFilterR.setFilterType(SimpleStableFilter::LOWPASS);
-        highCutFilterR.setCutoffFrequency(highCutFreq);
-        highCutFilterR.setResonance(0.707f);
+        highCutFilter.setFilterType(SimpleStableFilter::LOWPASS);
+        highCutFilter.setCutoffFrequency(highCutFreq);
+        highCutFilter.setResonance(0.707f);
     }
     
     // Parameters
     bool isEnabled = false;
-    ReverbType reverbType = HALL;
+    std::atomic<int> requestedType { HALL };
     float wetMix = 0.3f;
     float roomSize = 0.5f;
     float damping = 0.5f;
@@ -2643,378 +2812,224 @@ private:
     
     // Processing state
     double sampleRate = 44100.0;
-    juce::Reverb reverb;
+    FdnReverb engine;
+    int activeType = HALL;
+    
+    // Convolution mode. The audio thread owns convolver; new ones arrive through
+    // pendingConvolver and the one they replace leaves through retiredConvolver.
+    std::unique_ptr<PartitionedConvolver> convolver;
+    std::atomic<PartitionedConvolver*> pendingConvolver { nullptr };
+    std::atomic<PartitionedConvolver*> retiredConvolver { nullptr };
+    std::atomic<double> convolverSeconds { 0.0 };
     
     // Pre-delay buffers
     std::vector<float> preDelayBufferL, preDelayBufferR;
     int preDelayBufferSize = 0;
-    int preDelayIndexL = 0, preDelayIndexR = 0;
-    int preDelaySamples = 0;
+    int preDelayWriteIndex = 0;
     
-    // Filters for frequency shaping
-    SimpleStableFilter lowCutFilterL, lowCutFilterR;
-    SimpleStableFilter highCutFilterL, highCutFilterR;
+    // Filters for frequency shaping (each keeps separate left/right state)
+    SimpleStableFilter lowCutFilter;
+    SimpleStableFilter highCutFilter;
     
-    // Cached values for parameter updates
-    float lastSize = -1.0f, lastDamping = -1.0f, lastWidth = -1.0f;
+    // Wet send for the current chunk
+    alignas(16) float wetLeft[chunkSize];
+    alignas(16) float wetRight[chunkSize];
 };
 
 //==============================================================================
-// Biquad IIR Filter for Parametric EQ
-class BiquadFilter
+// N-band parametric EQ. Band parameters are smoothed at control rate: every control
+// block the bands that moved get new coefficients, and the cascade glides to them over
+// the block. Once nothing is moving the whole buffer runs in one pass.
+class ParametricEQEffect
 {
 public:
-    enum FilterType
-    {
-        PEAK,
-        LOW_SHELF,
-        HIGH_SHELF,
-        LOW_PASS,
-        HIGH_PASS,
-        BAND_PASS
-    };
+    static constexpr int maxBands = BiquadCascade::maxBands;
+    static constexpr int controlInterval = 64; // Samples between coefficient updates
     
-    BiquadFilter() = default;
+    ParametricEQEffect() = default;
     
-    void setSampleRate(double sampleRate)
+    void setSampleRate(double newSampleRate)
     {
-        this->sampleRate = sampleRate;
+        sampleRate = newSampleRate;
+        
+        for (auto& band : bands)
+        {
+            band.frequencySmoothing.setSampleRate(sampleRate);
+            band.frequencySmoothing.setTimeConstantMs(20.0f);
+            band.qSmoothing.setSampleRate(sampleRate);
+            band.qSmoothing.setTimeConstantMs(30.0f);
+            band.gainSmoothing.setSampleRate(sampleRate);
+            band.gainSmoothing.setTimeConstantMs(25.0f);
+        }
+        
         reset();
-        updateCoefficients();
-    }
-    
-    void setFilterType(FilterType type)
-    {
-        filterType = type;
-        updateCoefficients();
-    }
-    
-    void setFrequency(float freq)
-    {
-        frequency = juce::jlimit(20.0f, 20000.0f, freq);
-        frequencySmoothing.setTarget(frequency);
-        if (sampleRate > 0.0)
-            updateCoefficients();
-    }
-    
-    void setQ(float qValue)
-    {
-        q = juce::jlimit(0.1f, 30.0f, qValue);
-        qSmoothing.setTarget(q);
-        if (sampleRate > 0.0)
-            updateCoefficients();
-    }
-    
-    void setGain(float gainDb)
-    {
-        gain = juce::jlimit(-15.0f, 15.0f, gainDb);
-        gainSmoothing.setTarget(gain);
-        if (sampleRate > 0.0)
-            updateCoefficients();
     }
     
-    void reset()
-    {
-        x1 = x2 = y1 = y2 = 0.0f;
-        frequencySmoothing.reset(frequency);
-        qSmoothing.reset(q);
-        gainSmoothing.reset(gain);
-    }
+    void setEnabled(bool enabled) { isEnabled = enabled; }
+    bool getEnabled() const { return isEnabled; }
     
-    void prepare(double sampleRate)
+    // Bands from numBands on are bypassed
+    void setBandCount(int numBands)
     {
-        this->sampleRate = sampleRate;
-        
-        // Setup parameter smoothing
-        frequencySmoothing.setSampleRate(sampleRate);
-        frequencySmoothing.setTimeConstantMs(20.0f);
-        
-        qSmoothing.setSampleRate(sampleRate);
-        qSmoothing.setTimeConstantMs(30.0f);
-        
-        gainSmoothing.setSampleRate(sampleRate);
-        gainSmoothing.setTimeConstantMs(25.0f);
-        
-        reset();
-        updateCoefficients();
+        bandCount = juce::jlimit(1, maxBands, numBands);
+        for (auto& band : bands)
+            band.needsUpdate = true;
     }
     
-    float processSample(float input)
+    void setBandEnabled(int index, bool enabled)
     {
-        // Check if parameters need updating
-        float currentFreq = frequencySmoothing.getNextValue();
-        float currentQ = qSmoothing.getNextValue();
-        float currentGain = gainSmoothing.getNextValue();
-        
-        if (std::abs(currentFreq - lastFreq) > 0.1f ||
-            std::abs(currentQ - lastQ) > 0.001f ||
-            std::abs(currentGain - lastGain) > 0.001f)
+        if (auto* band = getBand(index))
         {
-            lastFreq = currentFreq;
-            lastQ = currentQ;
-            lastGain = currentGain;
-            calculateCoefficients(currentFreq, currentQ, currentGain);
+            band->enabled = enabled;
+            band->needsUpdate = true;
         }
-        
-        // Biquad processing: y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] - a1*y[n-1] - a2*y[n-2]
-        float output = b0 * input + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
-        
-        // Update delay elements
-        x2 = x1;
-        x1 = input;
-        y2 = y1;
-        y1 = output;
-        
-        return output;
     }
     
-private:
-    void updateCoefficients()
+    void setBandType(int index, BiquadCoefficients::FilterType type)
     {
-        if (sampleRate <= 0.0) return;
-        calculateCoefficients(frequency, q, gain);
+        if (auto* band = getBand(index))
+        {
+            band->type = type;
+            band->needsUpdate = true;
+        }
     }
     
-    void calculateCoefficients(float freq, float qVal, float gainDb)
+    void setBandFrequency(int index, float freq)
     {
-        const double omega = 2.0 * juce::MathConstants<double>::pi * freq / sampleRate;
-        const double sinOmega = std::sin(omega);
-        const double cosOmega = std::cos(omega);
-        const double alpha = sinOmega / (2.0 * qVal);
-        const double A = std::pow(10.0, gainDb / 40.0); // Convert dB to linear gain
-        const double beta = std::sqrt(A) / qVal;
-        
-        double a0, a1Temp, a2Temp, b0Temp, b1Temp, b2Temp;
-        
-        switch (filterType)
+        if (auto* band = getBand(index))
         {
-            case PEAK:
-                a0 = 1.0 + alpha / A;
-                a1Temp = -2.0 * cosOmega;
-                a2Temp = 1.0 - alpha / A;
-                b0Temp = 1.0 + alpha * A;
-                b1Temp = -2.0 * cosOmega;
-                b2Temp = 1.0 - alpha * A;
-                break;
-                
-            case LOW_SHELF:
-                {
-                    double S = 1.0;
-                    double beta = std::sqrt(A) / qVal;
-                    
-                    a0 = (A + 1.0) + (A - 1.0) * cosOmega + beta * sinOmega;
-                    a1Temp = -2.0 * ((A - 1.0) + (A + 1.0) * cosOmega);
-                    a2Temp = (A + 1.0) + (A - 1.0) * cosOmega - beta * sinOmega;
-                    b0Temp = A * ((A + 1.0) - (A - 1.0) * cosOmega + beta * sinOmega);
-                    b1Temp = 2.0 * A * ((A - 1.0) - (A + 1.0) * cosOmega);
-                    b2Temp = A * ((A + 1.0) - (A - 1.0) * cosOmega - beta * sinOmega);
-                }
-                break;
-                
-            case HIGH_SHELF:
-                {
-                    double S = 1.0;
-                    double beta = std::sqrt(A) / qVal;
-                    
-                    a0 = (A + 1.0) - (A - 1.0) * cosOmega + beta * sinOmega;
-                    a1Temp = 2.0 * ((A - 1.0) - (A + 1.0) * cosOmega);
-                    a2Temp = (A + 1.0) - (A - 1.0) * cosOmega - beta * sinOmega;
-                    b0Temp = A * ((A + 1.0) + (A - 1.0) * cosOmega + beta * sinOmega);
-                    b1Temp = -2.0 * A * ((A - 1.0) + (A + 1.0) * cosOmega);
-                    b2Temp = A * ((A + 1.0) + (A - 1.0) * cosOmega - beta * sinOmega);
-                }
-                break;
-                
-            case LOW_PASS:
-                a0 = 1.0 + alpha;
-                a1Temp = -2.0 * cosOmega;
-                a2Temp = 1.0 - alpha;
-                b0Temp = (1.0 - cosOmega) / 2.0;
-                b1Temp = 1.0 - cosOmega;
-                b2Temp = (1.0 - cosOmega) / 2.0;
-                break;
-                
-            case HIGH_PASS:
-                a0 = 1.0 + alpha;
-                a1Temp = -2.0 * cosOmega;
-                a2Temp = 1.0 - alpha;
-                b0Temp = (1.0 + cosOmega) / 2.0;
-                b1Temp = -(1.0 + cosOmega);
-                b2Temp = (1.0 + cosOmega) / 2.0;
-                break;
-                
-            case BAND_PASS:
-                a0 = 1.0 + alpha;
-                a1Temp = -2.0 * cosOmega;
-                a2Temp = 1.0 - alpha;
-                b0Temp = alpha;
-                b1Temp = 0.0;
-                b2Temp = -alpha;
-                break;
-                
-            default:
-                // Unity filter (no change)
-                a0 = 1.0;
-                a1Temp = 0.0;
-                a2Temp = 0.0;
-                b0Temp = 1.0;
-                b1Temp = 0.0;
-                b2Temp = 0.0;
-                break;
+            band->frequency = juce::jlimit(20.0f, 20000.0f, freq);
+            band->frequencySmoothing.setTarget(band->frequency);
         }
-        
-        // Normalize coefficients
-        b0 = static_cast<float>(b0Temp / a0);
-        b1 = static_cast<float>(b1Temp / a0);
-        b2 = static_cast<float>(b2Temp / a0);
-        a1 = static_cast<float>(a1Temp / a0);
-        a2 = static_cast<float>(a2Temp / a0);
     }
     
-    // Filter coefficients
-    float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f;
-    float a1 = 0.0f, a2 = 0.0f;
-    
-    // Delay elements
-    float x1 = 0.0f, x2 = 0.0f;
-    float y1 = 0.0f, y2 = 0.0f;
-    
-    // Parameters
-    FilterType filterType = PEAK;
-    float frequency = 1000.0f;
-    float q = 1.0f;
-    float gain = 0.0f;
-    
-    // Parameter smoothing
-    OnePoleSmoothing frequencySmoothing, qSmoothing, gainSmoothing;
-    float lastFreq = -1.0f, lastQ = -1.0f, lastGain = -1000.0f;
-    
-    double sampleRate = 44100.0;
-};
-
-//==============================================================================
-// 2-Band Parametric EQ Effect
-class ParametricEQEffect
-{
-public:
-    ParametricEQEffect() = default;
-    
-    void setSampleRate(double sampleRate)
+    void setBandQ(int index, float q)
     {
-        this->sampleRate = sampleRate;
-        
-        // Initialize filters for both channels
-        for (int ch = 0; ch < 2; ++ch)
+        if (auto* band = getBand(index))
         {
-            band1Filters[ch].setSampleRate(sampleRate);
-            band2Filters[ch].setSampleRate(sampleRate);
-            band1Filters[ch].prepare(sampleRate);
-            band2Filters[ch].prepare(sampleRate);
+            band->q = juce::jlimit(0.1f, 30.0f, q);
+            band->qSmoothing.setTarget(band->q);
         }
     }
     
-    void setEnabled(bool enabled) { isEnabled = enabled; }
-    void setBand1Enabled(bool enabled) { band1Enabled = enabled; }
-    void setBand2Enabled(bool enabled) { band2Enabled = enabled; }
-    
-    // Band 1 controls
-    void setBand1Type(BiquadFilter::FilterType type)
+    void setBandGain(int index, float gainDb)
     {
-        for (int ch = 0; ch < 2; ++ch)
-            band1Filters[ch].setFilterType(type);
+        if (auto* band = getBand(index))
+        {
+            band->gain = juce::jlimit(-15.0f, 15.0f, gainDb);
+            band->gainSmoothing.setTarget(band->gain);
+        }
     }
     
-    void setBand1Frequency(float freq)
+    double getTailLengthSeconds() const
     {
-        for (int ch = 0; ch < 2; ++ch)
-            band1Filters[ch].setFrequency(freq);
+        if (!isEnabled)
+            return 0.0;
+        
+        double tail = 0.0;
+        for (int i = 0; i < bandCount; ++i)
+            if (bands[static_cast<size_t>(i)].enabled)
+                tail += TailGate::getResonanceTailSeconds(bands[static_cast<size_t>(i)].frequency, bands[static_cast<size_t>(i)].q);
+        return tail;
     }
     
-    void setBand1Q(float q)
+    void reset()
     {
-        for (int ch = 0; ch < 2; ++ch)
-            band1Filters[ch].setQ(q);
+        for (size_t i = 0; i < bands.size(); ++i)
+        {
+            auto& band = bands[i];
+            band.frequencySmoothing.reset(band.frequency);
+            band.qSmoothing.reset(band.q);
+            band.gainSmoothing.reset(band.gain);
+            band.needsUpdate = false;
+            cascade.setTarget(static_cast<int>(i), getCoefficients(static_cast<int>(i)));
+        }
+        cascade.reset();
     }
     
-    void setBand1Gain(float gain)
+    void processBlock(juce::AudioBuffer<float>& buffer)
     {
-        for (int ch = 0; ch < 2; ++ch)
-            band1Filters[ch].setGain(gain);
+        if (!isEnabled || buffer.getNumChannels() == 0)
+            return;
+        
+        const int numSamples = buffer.getNumSamples();
+        float* left = buffer.getWritePointer(0);
+        float* right = buffer.getNumChannels() > 1 ? buffer.getWritePointer(1) : nullptr;
+        
+        for (int start = 0; start < numSamples;)
+        {
+            const int count = isGliding() ? juce::jmin(controlInterval, numSamples - start) : numSamples - start;
+            updateTargets(count);
+            cascade.process(left + start, right != nullptr ? right + start : nullptr, count);
+            start += count;
+        }
     }
     
-    // Band 2 controls
-    void setBand2Type(BiquadFilter::FilterType type)
+private:
+    struct Band
     {
-        for (int ch = 0; ch < 2; ++ch)
-            band2Filters[ch].setFilterType(type);
-    }
+        BiquadCoefficients::FilterType type = BiquadCoefficients::PEAK;
+        bool enabled = true;
+        float frequency = 1000.0f; // 20.0 to 20000.0 Hz
+        float q = 1.0f; // 0.1 to 30.0
+        float gain = 0.0f; // -15.0 to +15.0 dB
+        OnePoleSmoothing frequencySmoothing, qSmoothing, gainSmoothing;
+        bool needsUpdate = true; // Type, enable or band count changed since the last update
+    };
     
-    void setBand2Frequency(float freq)
+    Band* getBand(int index)
     {
-        for (int ch = 0; ch < 2; ++ch)
-            band2Filters[ch].setFrequency(freq);
+        return juce::isPositiveAndBelow(index, maxBands) ? &bands[static_cast<size_t>(index)] : nullptr;
     }
     
-    void setBand2Q(float q)
+    bool isGliding() const
     {
-        for (int ch = 0; ch < 2; ++ch)
-            band2Filters[ch].setQ(q);
+        for (const auto& band : bands)
+            if (!band.frequencySmoothing.isSettled() || !band.qSmoothing.isSettled() || !band.gainSmoothing.isSettled())
+                return true;
+        return false;
     }
     
-    void setBand2Gain(float gain)
+    // Advances a smoother by numSamples, snapping to the target once the rest is inaudible
+    static void advance(OnePoleSmoothing& smoothing, float target, int numSamples, float tolerance)
     {
-        for (int ch = 0; ch < 2; ++ch)
-            band2Filters[ch].setGain(gain);
+        if (std::abs(smoothing.skip(numSamples) - target) < tolerance)
+            smoothing.reset(target);
     }
     
-    void reset()
+    // Moves the smoothing on by numSamples and retargets every band that changed
+    void updateTargets(int numSamples)
     {
-        for (int ch = 0; ch < 2; ++ch)
+        for (size_t i = 0; i < bands.size(); ++i)
         {
-            band1Filters[ch].reset();
-            band2Filters[ch].reset();
+            auto& band = bands[i];
+            const bool moving = !band.frequencySmoothing.isSettled() || !band.qSmoothing.isSettled() || !band.gainSmoothing.isSettled();
+            if (!moving && !band.needsUpdate)
+                continue;
+            
+            advance(band.frequencySmoothing, band.frequency, numSamples, 0.01f);
+            advance(band.qSmoothing, band.q, numSamples, 1.0e-4f);
+            advance(band.gainSmoothing, band.gain, numSamples, 1.0e-4f);
+            band.needsUpdate = false;
+            cascade.setTarget(static_cast<int>(i), getCoefficients(static_cast<int>(i)));
         }
     }
     
-    void processBlock(juce::AudioBuffer<float>& buffer)
+    // A disabled or uncounted band is a wire, which the cascade glides to like any other
+    BiquadCoefficients getCoefficients(int index) const
     {
-        if (!isEnabled)
-            return;
-            
-        const int numSamples = buffer.getNumSamples();
-        const int numChannels = juce::jmin(buffer.getNumChannels(), 2);
-        
-        for (int ch = 0; ch < numChannels; ++ch)
-        {
-            float* channelData = buffer.getWritePointer(ch);
-            
-            for (int sample = 0; sample < numSamples; ++sample)
-            {
-                float input = channelData[sample];
-                float output = input;
-                
-                // Process through band 1 if enabled
-                if (band1Enabled)
-                    output = band1Filters[ch].processSample(output);
-                    
-                // Process through band 2 if enabled  
-                if (band2Enabled)
-                    output = band2Filters[ch].processSample(output);
-                
-                channelData[sample] = output;
-            }
-        }
+        const auto& band = bands[static_cast<size_t>(index)];
+        if (!band.enabled || index >= bandCount)
+            return {};
+        return BiquadCoefficients::make(band.type, sampleRate, band.frequencySmoothing.getCurrentValue(),
+                                        band.qSmoothing.getCurrentValue(), band.gainSmoothing.getCurrentValue());
     }
     
-private:
     bool isEnabled = false;
-    bool band1Enabled = true;
-    bool band2Enabled = true;
+    int bandCount = 2;
     double sampleRate = 44100.0;
-    
-    // Stereo filters for each band
-    BiquadFilter band1Filters[2];
-    BiquadFilter band2Filters[2];
+    std::array<Band, maxBands> bands;
+    BiquadCascade cascade;
 };
 
 class SummonerXSerum2AudioProcessor : public juce::AudioProcessor
@@ -3062,9 +3077,24 @@ public:
     }
     
     // Synthesizer controls
-    void setMasterVolume(float volume) { masterVolume = volume; }
+    void setMasterVolume(float volume) {
+        masterVolume = volume;
+        pushParameterChange([](auto& p, const auto& v) { p.outputGain = v[0]; }, volume);
+    }
     float getMasterVolume() const { return masterVolume; }
     
+    void setPolyphony(int voices) {
+        polyphony = juce::jlimit(1, PolyphonicSynthesiser::maxPolyphony, voices);
+        pushParameterChange([](auto& p, const auto& v) { p.synthesiser.setPolyphony(static_cast<int>(v[0])); }, static_cast<float>(polyphony));
+    }
+    int getPolyphony() const { return polyphony; }
+    
+    void setVoiceStealMode(int mode) {
+        voiceStealMode = juce::jlimit(0, 2, mode);
+        pushParameterChange([](auto& p, const auto& v) { p.synthesiser.setStealMode(static_cast<int>(v[0])); }, static_cast<float>(voiceStealMode));
+    }
+    int getVoiceStealMode() const { return voiceStealMode; }
+    
     void setOsc1Detune(float detune) { 
         osc1Detune = detune; 
         updateDetune();
@@ -3217,6 +3247,12 @@ public:
     }
     float getOsc2Phase() const { return osc2Phase; }
     
+    void setOsc2PulseWidth(float width) { 
+        osc2PulseWidth = width; 
+        updateOsc2PulseWidth();
+    }
+    float getOsc2PulseWidth() const { return osc2PulseWidth; }
+    
     void setOsc2Enabled(bool enabled) { 
         osc2Enabled = enabled; 
         updateOsc2Parameters();
@@ -3317,12 +3353,24 @@ public:
     }
     bool getFilterCombEnabled() const { return filterCombEnabled; }
     
+    void setFilterCombNegative(bool negative) {
+        filterCombNegative = negative;
+        updateFilterParameters();
+    }
+    bool getFilterCombNegative() const { return filterCombNegative; }
+    
     void setFilterFormantEnabled(bool enabled) {
         filterFormantEnabled = enabled;
         updateFilterParameters();
     }
     bool getFilterFormantEnabled() const { return filterFormantEnabled; }
     
+    void setFilterFormantVowel(float vowel) {
+        filterFormantVowel = vowel;
+        updateFilterParameters();
+    }
+    float getFilterFormantVowel() const { return filterFormantVowel; }
+    
     void setFilter12dBEnabled(bool enabled) {
         filter12dBEnabled = enabled;
         updateFilterParameters();
@@ -3338,221 +3386,228 @@ public:
     // Chorus effect controls
     void setChorusEnabled(bool enabled) {
         chorusEnabled = enabled;
-        chorus.setEnabled(enabled);
+        pushParameterChange([](auto& p, const auto& v) { p.chorus.setEnabled(v[0] != 0.0f); }, static_cast<float>(enabled));
     }
     bool getChorusEnabled() const { return chorusEnabled; }
     
     void setChorusRate(float rate) {
         chorusRate = rate;
-        chorus.setRate(rate);
+        pushParameterChange([](auto& p, const auto& v) { p.chorus.setRate(v[0]); }, rate);
     }
     float getChorusRate() const { return chorusRate; }
     
     void setChorusDelay1(float delayMs) {
         chorusDelay1 = delayMs;
-        chorus.setDelay1(delayMs);
+        pushParameterChange([](auto& p, const auto& v) { p.chorus.setDelay1(v[0]); }, delayMs);
     }
     float getChorusDelay1() const { return chorusDelay1; }
     
     void setChorusDelay2(float delayMs) {
         chorusDelay2 = delayMs;
-        chorus.setDelay2(delayMs);
+        pushParameterChange([](auto& p, const auto& v) { p.chorus.setDelay2(v[0]); }, delayMs);
     }
     float getChorusDelay2() const { return chorusDelay2; }
     
     void setChorusDepth(float depth) {
         chorusDepth = depth;
-        chorus.setDepth(depth);
+        pushParameterChange([](auto& p, const auto& v) { p.chorus.setDepth(v[0]); }, depth);
     }
     float getChorusDepth() const { return chorusDepth; }
     
     void setChorusFeedback(float feedback) {
         chorusFeedback = feedback;
-        chorus.setFeedback(feedback);
+        pushParameterChange([](auto& p, const auto& v) { p.chorus.setFeedback(v[0]); }, feedback);
     }
     float getChorusFeedback() const { return chorusFeedback; }
     
     void setChorusLPF(float cutoffHz) {
         chorusLPF = cutoffHz;
-        chorus.setLPFCutoff(cutoffHz);
+        pushParameterChange([](auto& p, const auto& v) { p.chorus.setLPFCutoff(v[0]); }, cutoffHz);
     }
     float getChorusLPF() const { return chorusLPF; }
     
     void setChorusMix(float mix) {
         chorusMix = mix;
-        chorus.setMix(mix);
+        pushParameterChange([](auto& p, const auto& v) { p.chorus.setMix(v[0]); }, mix);
     }
     float getChorusMix() const { return chorusMix; }
+    
+    void setChorusVoices(int voices) {
+        chorusVoices = juce::jlimit(ChorusEffect::minVoices, ChorusEffect::maxVoices, voices);
+        pushParameterChange([](auto& p, const auto& v) { p.chorus.setVoices(static_cast<int>(v[0])); }, static_cast<float>(chorusVoices));
+    }
+    int getChorusVoices() const { return chorusVoices; }
 
     // Flanger effect controls
     void setFlangerEnabled(bool enabled) {
         flangerEnabled = enabled;
-        flanger.setEnabled(enabled);
+        pushParameterChange([](auto& p, const auto& v) { p.flanger.setEnabled(v[0] != 0.0f); }, static_cast<float>(enabled));
     }
     bool getFlangerEnabled() const { return flangerEnabled; }
     
     void setFlangerRate(float rate) {
         flangerRate = rate;
-        flanger.setRate(rate);
+        pushParameterChange([](auto& p, const auto& v) { p.flanger.setRate(v[0]); }, rate);
     }
     float getFlangerRate() const { return flangerRate; }
     
     void setFlangerDepth(float depthMs) {
         flangerDepth = depthMs;
-        flanger.setDepth(depthMs);
+        pushParameterChange([](auto& p, const auto& v) { p.flanger.setDepth(v[0]); }, depthMs);
     }
     float getFlangerDepth() const { return flangerDepth; }
     
     void setFlangerFeedback(float feedbackPercent) {
         flangerFeedback = feedbackPercent;
-        flanger.setFeedback(feedbackPercent);
+        pushParameterChange([](auto& p, const auto& v) { p.flanger.setFeedback(v[0]); }, feedbackPercent);
     }
     float getFlangerFeedback() const { return flangerFeedback; }
     
     void setFlangerMix(float mixPercent) {
         flangerMix = mixPercent;
-        flanger.setMix(mixPercent);
+        pushParameterChange([](auto& p, const auto& v) { p.flanger.setMix(v[0]); }, mixPercent);
     }
     float getFlangerMix() const { return flangerMix; }
     
     void setFlangerPhase(float phaseDegrees) {
         flangerPhase = phaseDegrees;
-        flanger.setPhase(phaseDegrees);
+        pushParameterChange([](auto& p, const auto& v) { p.flanger.setPhase(v[0]); }, phaseDegrees);
     }
     float getFlangerPhase() const { return flangerPhase; }
 
     // Phaser effect controls
     void setPhaserEnabled(bool enabled) {
         phaserEnabled = enabled;
-        phaser.setEnabled(enabled);
+        pushParameterChange([](auto& p, const auto& v) { p.phaser.setEnabled(v[0] != 0.0f); }, static_cast<float>(enabled));
     }
     bool getPhaserEnabled() const { return phaserEnabled; }
     
     void setPhaserRate(float rate) {
         phaserRate = rate;
-        phaser.setRate(rate);
+        pushParameterChange([](auto& p, const auto& v) { p.phaser.setRate(v[0]); }, rate);
     }
     float getPhaserRate() const { return phaserRate; }
     
     void setPhaserDepth1(float depth) {
         phaserDepth1 = depth;
-        phaser.setDepth1(depth);
+        pushParameterChange([](auto& p, const auto& v) { p.phaser.setDepth1(v[0]); }, depth);
     }
     float getPhaserDepth1() const { return phaserDepth1; }
     
     void setPhaserDepth2(float depth) {
         phaserDepth2 = depth;
-        phaser.setDepth2(depth);
+        pushParameterChange([](auto& p, const auto& v) { p.phaser.setDepth2(v[0]); }, depth);
     }
     float getPhaserDepth2() const { return phaserDepth2; }
     
     void setPhaserFeedback(float feedback) {
         phaserFeedback = feedback;
-        phaser.setFeedback(feedback);
+        pushParameterChange([](auto& p, const auto& v) { p.phaser.setFeedback(v[0]); }, feedback);
     }
     float getPhaserFeedback() const { return phaserFeedback; }
     
     void setPhaserMix(float mix) {
         phaserMix = mix;
-        phaser.setMix(mix);
+        pushParameterChange([](auto& p, const auto& v) { p.phaser.setMix(v[0]); }, mix);
     }
     float getPhaserMix() const { return phaserMix; }
     
     void setPhaserPhase(float phase) {
         phaserPhase = phase;
-        phaser.setPhase(phase);
+        pushParameterChange([](auto& p, const auto& v) { p.phaser.setPhase(v[0]); }, phase);
     }
     float getPhaserPhase() const { return phaserPhase; }
     
     void setPhaserFrequency(float freq) {
         phaserFrequency = freq;
-        phaser.setFrequency(freq);
+        pushParameterChange([](auto& p, const auto& v) { p.phaser.setFrequency(v[0]); }, freq);
     }
     float getPhaserFrequency() const { return phaserFrequency; }
     
     void setPhaserPoles(int poles) {
         phaserPoles = poles;
-        phaser.setPoles(poles);
+        pushParameterChange([](auto& p, const auto& v) { p.phaser.setPoles(static_cast<int>(v[0])); }, static_cast<float>(poles));
     }
     int getPhaserPoles() const { return phaserPoles; }
 
     // Compressor effect controls
     void setCompressorEnabled(bool enabled) {
         compressorEnabled = enabled;
-        compressor.setEnabled(enabled);
+        pushParameterChange([](auto& p, const auto& v) { p.compressor.setEnabled(v[0] != 0.0f); }, static_cast<float>(enabled));
     }
     bool getCompressorEnabled() const { return compressorEnabled; }
     
     void setCompressorThreshold(float thresholdDb) {
         compressorThreshold = thresholdDb;
-        compressor.setThreshold(thresholdDb);
+        pushParameterChange([](auto& p, const auto& v) { p.compressor.setThreshold(v[0]); }, thresholdDb);
     }
     float getCompressorThreshold() const { return compressorThreshold; }
     
     void setCompressorRatio(float ratio) {
         compressorRatio = ratio;
-        compressor.setRatio(ratio);
+        pushParameterChange([](auto& p, const auto& v) { p.compressor.setRatio(v[0]); }, ratio);
     }
     float getCompressorRatio() const { return compressorRatio; }
     
     void setCompressorAttack(float attackMs) {
         compressorAttack = attackMs;
-        compressor.setAttack(attackMs);
+        pushParameterChange([](auto& p, const auto& v) { p.compressor.setAttack(v[0]); }, attackMs);
     }
     float getCompressorAttack() const { return compressorAttack; }
     
     void setCompressorRelease(float releaseMs) {
         compressorRelease = releaseMs;
-        compressor.setRelease(releaseMs);
+        pushParameterChange([](auto& p, const auto& v) { p.compressor.setRelease(v[0]); }, releaseMs);
     }
     float getCompressorRelease() const { return compressorRelease; }
     
     void setCompressorGain(float gainDb) {
         compressorGain = gainDb;
-        compressor.setMakeupGain(gainDb);
+        pushParameterChange([](auto& p, const auto& v) { p.compressor.setMakeupGain(v[0]); }, gainDb);
     }
     float getCompressorGain() const { return compressorGain; }
     
     void setCompressorMix(float mix) {
         compressorMix = mix;
-        compressor.setMix(mix);
+        pushParameterChange([](auto& p, const auto& v) { p.compressor.setMix(v[0]); }, mix);
     }
     float getCompressorMix() const { return compressorMix; }
     
     void setCompressorMultiband(bool enabled) {
         compressorMultiband = enabled;
-        compressor.setMultiband(enabled);
+        pushParameterChange([](auto& p, const auto& v) { p.compressor.setMultiband(v[0] != 0.0f); }, static_cast<float>(enabled));
     }
     bool getCompressorMultiband() const { return compressorMultiband; }
     
     // Distortion effect control methods
     void setDistortionEnabled(bool enabled) {
         distortionEnabled = enabled;
-        distortion.setEnabled(enabled);
+        pushParameterChange([](auto& p, const auto& v) { p.distortion.setEnabled(v[0] != 0.0f); }, static_cast<float>(enabled));
+        setLatencySamples(DistortionEffect::getLatencyForMode(distortionEnabled, distortionOversampling));
     }
     bool getDistortionEnabled() const { return distortionEnabled; }
     
     void setDistortionType(int type) {
         distortionType = juce::jlimit(1, 16, type);
-        distortion.setType(type);
+        pushParameterChange([](auto& p, const auto& v) { p.distortion.setType(static_cast<int>(v[0])); }, static_cast<float>(type));
     }
     int getDistortionType() const { return distortionType; }
     
     void setDistortionDrive(float drive) {
         distortionDrive = juce::jlimit(0.0f, 100.0f, drive);
-        distortion.setDrive(drive);
+        pushParameterChange([](auto& p, const auto& v) { p.distortion.setDrive(v[0]); }, drive);
     }
     float getDistortionDrive() const { return distortionDrive; }
     
     void setDistortionMix(float mix) {
         distortionMix = juce::jlimit(0.0f, 1.0f, mix);
-        distortion.setMix(mix);
+        pushParameterChange([](auto& p, const auto& v) { p.distortion.setMix(v[0]); }, mix);
     }
     float getDistortionMix() const { return distortionMix; }
     
     void setDistortionFilterPosition(int position) {
         distortionFilterPosition = juce::jlimit(0, 2, position);
-        distortion.setFilterPosition(static_cast<DistortionEffect::FilterPosition>(position));
+        pushParameterChange([](auto& p, const auto& v) { p.distortion.setFilterPosition(static_cast<DistortionEffect::FilterPosition>(static_cast<int>(v[0]))); }, static_cast<float>(position));
     }
     int getDistortionFilterPosition() const { return distortionFilterPosition; }
     
@@ -3561,231 +3616,247 @@ public:
         SimpleStableFilter::FilterType filterType = SimpleStableFilter::LOWPASS;
         if (type == 2) filterType = SimpleStableFilter::BANDPASS;
         else if (type == 3) filterType = SimpleStableFilter::HIGHPASS;
-        distortion.setFilterType(filterType);
+        pushParameterChange([](auto& p, const auto& v) { p.distortion.setFilterType(static_cast<SimpleStableFilter::FilterType>(static_cast<int>(v[0]))); }, static_cast<float>(filterType));
     }
     int getDistortionFilterType() const { return distortionFilterType; }
     
     void setDistortionFilterFreq(float freq) {
         distortionFilterFreq = juce::jlimit(20.0f, 20000.0f, freq);
-        distortion.setFilterFrequency(freq);
+        pushParameterChange([](auto& p, const auto& v) { p.distortion.setFilterFrequency(v[0]); }, freq);
     }
     float getDistortionFilterFreq() const { return distortionFilterFreq; }
     
     void setDistortionFilterQ(float q) {
         distortionFilterQ = juce::jlimit(0.1f, 30.0f, q);
-        distortion.setFilterQ(q);
+        pushParameterChange([](auto& p, const auto& v) { p.distortion.setFilterQ(v[0]); }, q);
     }
     float getDistortionFilterQ() const { return distortionFilterQ; }
     
+    void setDistortionOversampling(int mode) {
+        distortionOversampling = juce::jlimit(0, 3, mode);
+        pushParameterChange([](auto& p, const auto& v) { p.distortion.setOversampling(static_cast<int>(v[0])); }, static_cast<float>(distortionOversampling));
+        setLatencySamples(DistortionEffect::getLatencyForMode(distortionEnabled, distortionOversampling));
+    }
+    int getDistortionOversampling() const { return distortionOversampling; }
+    
     // Delay effect control methods
     void setDelayEnabled(bool enabled) {
         delayEnabled = enabled;
-        delay.setEnabled(enabled);
+        pushParameterChange([](auto& p, const auto& v) { p.delay.setEnabled(v[0] != 0.0f); }, static_cast<float>(enabled));
     }
     bool getDelayEnabled() const { return delayEnabled; }
     
     void setDelayFeedback(float feedback) {
         delayFeedback = juce::jlimit(0.0f, 0.95f, feedback);
-        delay.setFeedback(feedback);
+        pushParameterChange([](auto& p, const auto& v) { p.delay.setFeedback(v[0]); }, feedback);
     }
     float getDelayFeedback() const { return delayFeedback; }
     
     void setDelayMix(float mix) {
         delayMix = juce::jlimit(0.0f, 1.0f, mix);
-        delay.setMix(mix);
+        pushParameterChange([](auto& p, const auto& v) { p.delay.setMix(v[0]); }, mix);
     }
     float getDelayMix() const { return delayMix; }
     
     void setDelayPingPong(bool pingPong) {
         delayPingPong = pingPong;
-        delay.setDelayMode(pingPong ? DelayEffect::PING_PONG : DelayEffect::NORMAL);
+        pushParameterChange([](auto& p, const auto& v) { p.delay.setDelayMode(static_cast<DelayEffect::DelayMode>(static_cast<int>(v[0]))); }, static_cast<float>(pingPong ? DelayEffect::PING_PONG : DelayEffect::NORMAL));
     }
     bool getDelayPingPong() const { return delayPingPong; }
     
     void setDelayLeftTime(float timeMs) {
         delayLeftTime = juce::jlimit(1.0f, 2000.0f, timeMs);
-        delay.setLeftTime(timeMs);
+        pushParameterChange([](auto& p, const auto& v) { p.delay.setLeftTime(v[0]); }, timeMs);
     }
     float getDelayLeftTime() const { return delayLeftTime; }
     
     void setDelayRightTime(float timeMs) {
         delayRightTime = juce::jlimit(1.0f, 2000.0f, timeMs);
-        delay.setRightTime(timeMs);
+        pushParameterChange([](auto& p, const auto& v) { p.delay.setRightTime(v[0]); }, timeMs);
     }
     float getDelayRightTime() const { return delayRightTime; }
     
     void setDelaySync(bool sync) {
         delaySync = sync;
-        delay.setBpmSync(sync);
+        pushParameterChange([](auto& p, const auto& v) { p.delay.setBpmSync(v[0] != 0.0f); }, static_cast<float>(sync));
     }
     bool getDelaySync() const { return delaySync; }
     
     void setDelayTriplet(bool triplet) {
         delayTriplet = triplet;
-        delay.setLeftTriplet(triplet);
+        pushParameterChange([](auto& p, const auto& v) { p.delay.setLeftTriplet(v[0] != 0.0f); }, static_cast<float>(triplet));
     }
     bool getDelayTriplet() const { return delayTriplet; }
     
     void setDelayDotted(bool dotted) {
         delayDotted = dotted;
-        delay.setLeftDotted(dotted);
+        pushParameterChange([](auto& p, const auto& v) { p.delay.setLeftDotted(v[0] != 0.0f); }, static_cast<float>(dotted));
     }
     bool getDelayDotted() const { return delayDotted; }
     
     void setDelayRTriplet(bool triplet) {
         delayRTriplet = triplet;
-        delay.setRightTriplet(triplet);
+        pushParameterChange([](auto& p, const auto& v) { p.delay.setRightTriplet(v[0] != 0.0f); }, static_cast<float>(triplet));
     }
     bool getDelayRTriplet() const { return delayRTriplet; }
     
     void setDelayRDotted(bool dotted) {
         delayRDotted = dotted;
-        delay.setRightDotted(dotted);
+        pushParameterChange([](auto& p, const auto& v) { p.delay.setRightDotted(v[0] != 0.0f); }, static_cast<float>(dotted));
     }
     bool getDelayRDotted() const { return delayRDotted; }
     
     void setDelayFilterFreq(float freq) {
         delayFilterFreq = juce::jlimit(20.0f, 20000.0f, freq);
-        delay.setFilterFreq(freq);
+        pushParameterChange([](auto& p, const auto& v) { p.delay.setFilterFreq(v[0]); }, freq);
     }
     float getDelayFilterFreq() const { return delayFilterFreq; }
     
     void setDelayFilterQ(float q) {
         delayFilterQ = juce::jlimit(0.1f, 30.0f, q);
-        delay.setFilterQ(q);
+        pushParameterChange([](auto& p, const auto& v) { p.delay.setFilterQ(v[0]); }, q);
     }
     float getDelayFilterQ() const { return delayFilterQ; }
     
     // Reverb effect controls
     void setReverbEnabled(bool enabled) {
         reverbEnabled = enabled;
-        reverb.setEnabled(enabled);
+        pushParameterChange([](auto& p, const auto& v) { p.reverb.setEnabled(v[0] != 0.0f); }, static_cast<float>(enabled));
     }
     bool getReverbEnabled() const { return reverbEnabled; }
     
     void setReverbMix(float mix) {
         reverbMix = juce::jlimit(0.0f, 100.0f, mix);
-        reverb.setMix(reverbMix / 100.0f);
+        pushParameterChange([](auto& p, const auto& v) { p.reverb.setMix(v[0]); }, reverbMix / 100.0f);
     }
     float getReverbMix() const { return reverbMix; }
     
     void setReverbType(int type) {
-        reverbType = juce::jlimit(1, 5, type);
-        reverb.setType(static_cast<ReverbEffect::ReverbType>(reverbType));
+        reverbType = juce::jlimit(1, 6, type);
+        pushParameterChange([](auto& p, const auto& v) { p.reverb.setType(static_cast<ReverbEffect::ReverbType>(static_cast<int>(v[0]))); }, static_cast<float>(reverbType));
     }
     int getReverbType() const { return reverbType; }
     
     void setReverbLowCut(float freq) {
         reverbLowCut = juce::jlimit(20.0f, 1000.0f, freq);
-        reverb.setLowCut(freq);
+        pushParameterChange([](auto& p, const auto& v) { p.reverb.setLowCut(v[0]); }, freq);
     }
     float getReverbLowCut() const { return reverbLowCut; }
     
     void setReverbHighCut(float freq) {
         reverbHighCut = juce::jlimit(1000.0f, 20000.0f, freq);
-        reverb.setHighCut(freq);
+        pushParameterChange([](auto& p, const auto& v) { p.reverb.setHighCut(v[0]); }, freq);
     }
     float getReverbHighCut() const { return reverbHighCut; }
     
     void setReverbSize(float size) {
         reverbSize = juce::jlimit(0.0f, 100.0f, size);
-        reverb.setSize(reverbSize / 100.0f);
+        pushParameterChange([](auto& p, const auto& v) { p.reverb.setSize(v[0]); }, reverbSize / 100.0f);
     }
     float getReverbSize() const { return reverbSize; }
     
     void setReverbPreDelay(float delay) {
         reverbPreDelay = juce::jlimit(0.0f, 200.0f, delay);
-        reverb.setPreDelay(delay);
+        pushParameterChange([](auto& p, const auto& v) { p.reverb.setPreDelay(v[0]); }, delay);
     }
     float getReverbPreDelay() const { return reverbPreDelay; }
     
     void setReverbDamping(float damp) {
         reverbDamping = juce::jlimit(0.0f, 100.0f, damp);
-        reverb.setDamping(reverbDamping / 100.0f);
+        pushParameterChange([](auto& p, const auto& v) { p.reverb.setDamping(v[0]); }, reverbDamping / 100.0f);
     }
     float getReverbDamping() const { return reverbDamping; }
     
     
     void setReverbWidth(float width) {
         reverbWidth = juce::jlimit(0.0f, 100.0f, width);
-        reverb.setWidth(reverbWidth / 100.0f);
+        pushParameterChange([](auto& p, const auto& v) { p.reverb.setWidth(v[0]); }, reverbWidth / 100.0f);
     }
     float getReverbWidth() const { return reverbWidth; }
     
     // EQ effect controls
     void setEQEnabled(bool enabled) {
         eqEnabled = enabled;
-        eq.setEnabled(enabled);
+        pushParameterChange([](auto& p, const auto& v) { p.eq.setEnabled(v[0] != 0.0f); }, static_cast<float>(enabled));
     }
     bool getEQEnabled() const { return eqEnabled; }
     
-    // Band 1 controls
-    void setEQ1Enabled(bool enabled) {
-        eq1Enabled = enabled;
-        eq.setBand1Enabled(enabled);
-    }
-    bool getEQ1Enabled() const { return eq1Enabled; }
+    // N-band controls, band 0 first. Bands from the band count on are bypassed.
+    static constexpr int maxEqBands = ParametricEQEffect::maxBands;
     
-    void setEQ1Frequency(float freq) {
-        eq1Frequency = juce::jlimit(20.0f, 20000.0f, freq);
-        eq.setBand1Frequency(eq1Frequency);
+    void setEQBandCount(int count) {
+        eqBandCount = juce::jlimit(1, maxEqBands, count);
+        pushParameterChange([](auto& p, const auto& v) { p.eq.setBandCount(static_cast<int>(v[0])); }, static_cast<float>(eqBandCount));
     }
-    float getEQ1Frequency() const { return eq1Frequency; }
+    int getEQBandCount() const { return eqBandCount; }
     
-    void setEQ1Q(float q) {
-        eq1Q = juce::jlimit(0.1f, 30.0f, q);
-        eq.setBand1Q(eq1Q);
+    void setEQBandEnabled(int band, bool enabled) {
+        if (!juce::isPositiveAndBelow(band, maxEqBands)) return;
+        eqBandEnabled[static_cast<size_t>(band)] = enabled;
+        pushParameterChange([](auto& p, const auto& v) { p.eq.setBandEnabled(static_cast<int>(v[0]), v[1] != 0.0f); }, static_cast<float>(band), static_cast<float>(enabled));
     }
-    float getEQ1Q() const { return eq1Q; }
+    bool getEQBandEnabled(int band) const { return juce::isPositiveAndBelow(band, maxEqBands) && eqBandEnabled[static_cast<size_t>(band)]; }
     
-    void setEQ1Gain(float gain) {
-        eq1Gain = juce::jlimit(-15.0f, 15.0f, gain);
-        eq.setBand1Gain(eq1Gain);
+    void setEQBandFrequency(int band, float freq) {
+        if (!juce::isPositiveAndBelow(band, maxEqBands)) return;
+        eqBandFrequency[static_cast<size_t>(band)] = juce::jlimit(20.0f, 20000.0f, freq);
+        pushParameterChange([](auto& p, const auto& v) { p.eq.setBandFrequency(static_cast<int>(v[0]), v[1]); }, static_cast<float>(band), eqBandFrequency[static_cast<size_t>(band)]);
     }
-    float getEQ1Gain() const { return eq1Gain; }
+    float getEQBandFrequency(int band) const { return juce::isPositiveAndBelow(band, maxEqBands) ? eqBandFrequency[static_cast<size_t>(band)] : 1000.0f; }
     
-    void setEQ1Type(int type) {
-        eq1Type = juce::jlimit(0, 2, type);
-        BiquadFilter::FilterType filterType = BiquadFilter::PEAK;
-        if (eq1Type == 0) filterType = BiquadFilter::PEAK;
-        else if (eq1Type == 1) filterType = BiquadFilter::LOW_SHELF;
-        else if (eq1Type == 2) filterType = BiquadFilter::HIGH_PASS;
-        eq.setBand1Type(filterType);
+    void setEQBandQ(int band, float q) {
+        if (!juce::isPositiveAndBelow(band, maxEqBands)) return;
+        eqBandQ[static_cast<size_t>(band)] = juce::jlimit(0.1f, 30.0f, q);
+        pushParameterChange([](auto& p, const auto& v) { p.eq.setBandQ(static_cast<int>(v[0]), v[1]); }, static_cast<float>(band), eqBandQ[static_cast<size_t>(band)]);
     }
-    int getEQ1Type() const { return eq1Type; }
+    float getEQBandQ(int band) const { return juce::isPositiveAndBelow(band, maxEqBands) ? eqBandQ[static_cast<size_t>(band)] : 1.0f; }
     
-    // Band 2 controls
-    void setEQ2Enabled(bool enabled) {
-        eq2Enabled = enabled;
-        eq.setBand2Enabled(enabled);
+    void setEQBandGain(int band, float gain) {
+        if (!juce::isPositiveAndBelow(band, maxEqBands)) return;
+        eqBandGain[static_cast<size_t>(band)] = juce::jlimit(-15.0f, 15.0f, gain);
+        pushParameterChange([](auto& p, const auto& v) { p.eq.setBandGain(static_cast<int>(v[0]), v[1]); }, static_cast<float>(band), eqBandGain[static_cast<size_t>(band)]);
     }
-    bool getEQ2Enabled() const { return eq2Enabled; }
+    float getEQBandGain(int band) const { return juce::isPositiveAndBelow(band, maxEqBands) ? eqBandGain[static_cast<size_t>(band)] : 0.0f; }
     
-    void setEQ2Frequency(float freq) {
-        eq2Frequency = juce::jlimit(20.0f, 20000.0f, freq);
-        eq.setBand2Frequency(eq2Frequency);
+    // Any BiquadCoefficients::FilterType, 0=Peak to 5=Band pass
+    void setEQBandFilterType(int band, int type) {
+        if (!juce::isPositiveAndBelow(band, maxEqBands)) return;
+        eqBandFilterType[static_cast<size_t>(band)] = juce::jlimit(0, static_cast<int>(BiquadCoefficients::BAND_PASS), type);
+        pushParameterChange([](auto& p, const auto& v) { p.eq.setBandType(static_cast<int>(v[0]), static_cast<BiquadCoefficients::FilterType>(static_cast<int>(v[1]))); },
+                            static_cast<float>(band), static_cast<float>(eqBandFilterType[static_cast<size_t>(band)]));
     }
-    float getEQ2Frequency() const { return eq2Frequency; }
+    int getEQBandFilterType(int band) const { return juce::isPositiveAndBelow(band, maxEqBands) ? eqBandFilterType[static_cast<size_t>(band)] : 0; }
     
-    void setEQ2Q(float q) {
-        eq2Q = juce::jlimit(0.1f, 30.0f, q);
-        eq.setBand2Q(eq2Q);
-    }
-    float getEQ2Q() const { return eq2Q; }
+    // Band 1 and 2 controls for the two-band editor
+    void setEQ1Enabled(bool enabled) { setEQBandEnabled(0, enabled); }
+    bool getEQ1Enabled() const { return getEQBandEnabled(0); }
+    void setEQ1Frequency(float freq) { setEQBandFrequency(0, freq); }
+    float getEQ1Frequency() const { return getEQBandFrequency(0); }
+    void setEQ1Q(float q) { setEQBandQ(0, q); }
+    float getEQ1Q() const { return getEQBandQ(0); }
+    void setEQ1Gain(float gain) { setEQBandGain(0, gain); }
+    float getEQ1Gain() const { return getEQBandGain(0); }
     
-    void setEQ2Gain(float gain) {
-        eq2Gain = juce::jlimit(-15.0f, 15.0f, gain);
-        eq.setBand2Gain(eq2Gain);
+    void setEQ1Type(int type) {
+        eq1Type = juce::jlimit(0, 2, type);
+        const int filterTypes[] = { BiquadCoefficients::PEAK, BiquadCoefficients::LOW_SHELF, BiquadCoefficients::HIGH_PASS };
+        setEQBandFilterType(0, filterTypes[eq1Type]);
     }
-    float getEQ2Gain() const { return eq2Gain; }
+    int getEQ1Type() const { return eq1Type; }
+    
+    void setEQ2Enabled(bool enabled) { setEQBandEnabled(1, enabled); }
+    bool getEQ2Enabled() const { return getEQBandEnabled(1); }
+    void setEQ2Frequency(float freq) { setEQBandFrequency(1, freq); }
+    float getEQ2Frequency() const { return getEQBandFrequency(1); }
+    void setEQ2Q(float q) { setEQBandQ(1, q); }
+    float getEQ2Q() const { return getEQBandQ(1); }
+    void setEQ2Gain(float gain) { setEQBandGain(1, gain); }
+    float getEQ2Gain() const { return getEQBandGain(1); }
     
     void setEQ2Type(int type) {
         eq2Type = juce::jlimit(0, 2, type);
-        BiquadFilter::FilterType filterType = BiquadFilter::PEAK;
-        if (eq2Type == 0) filterType = BiquadFilter::PEAK;
-        else if (eq2Type == 1) filterType = BiquadFilter::HIGH_SHELF;
-        else if (eq2Type == 2) filterType = BiquadFilter::LOW_PASS;
-        eq.setBand2Type(filterType);
+        const int filterTypes[] = { BiquadCoefficients::PEAK, BiquadCoefficients::HIGH_SHELF, BiquadCoefficients::LOW_PASS };
+        setEQBandFilterType(1, filterTypes[eq2Type]);
     }
     int getEQ2Type() const { return eq2Type; }
     
@@ -3817,6 +3888,63 @@ public:
     
     // Callback for GUI updates when presets change
     std::function<void()> onPresetChanged;
+    
+    // Microtuning from Scala files; each returns false and keeps the current tuning if
+    // the file cannot be read or parsed
+    bool loadTuningScale(const juce::File& sclFile);
+    bool loadTuningKeyboardMapping(const juce::File& kbmFile);
+    void resetTuning();
+    juce::String getTuningDescription() const { return scalaTuning.getScaleDescription(); }
+    
+    // Impulse response for the IMPULSE reverb type. The file is read, resampled and
+    // partitioned on a background thread; until one is loaded a built-in response plays.
+    // Returns false if the file does not exist.
+    bool loadReverbImpulse(const juce::File& file);
+    void clearReverbImpulse();
+    juce::File getReverbImpulseFile() const { return reverbImpulseFile; }
+    
+    // LFO: the drawn shape plays at a free rate, restarts with every note, or follows the
+    // host tempo, and modulates up to maxLfoRoutes parameters from parameterMap
+    static constexpr int maxLfoRoutes = 8;
+    
+    void setLfoShape(const std::vector<float>& points);
+    const std::vector<float>& getLfoShape() const { return lfoShapePoints; }
+    
+    void setLfoRate(float rateHz) {
+        lfoRate = rateHz;
+        updateLfoParameters();
+    }
+    float getLfoRate() const { return lfoRate; }
+    
+    void setLfoMode(int mode) {
+        lfoMode = juce::jlimit(0, 2, mode);
+        updateLfoParameters();
+    }
+    int getLfoMode() const { return lfoMode; }
+    
+    void setLfoSyncDivision(int division) {
+        lfoSyncDivision = juce::jlimit(0, numLfoSyncDivisions - 1, division);
+        updateLfoParameters();
+    }
+    int getLfoSyncDivision() const { return lfoSyncDivision; }
+    
+    void setLfoControlInterval(int samples) {
+        lfoControlInterval = juce::jlimit(1, 1024, samples);
+        updateLfoParameters();
+    }
+    int getLfoControlInterval() const { return lfoControlInterval; }
+    
+    // Only FLOAT parameters can be routed; depth is the fraction of the parameter's range
+    // covered by a full LFO swing (-1 to 1) around the parameter's own value. The LFO only
+    // moves the engine: the setter and getter still see that value, and a setter called
+    // while the parameter is routed moves the centre of the swing.
+    bool setLfoRoute(int slot, const std::string& parameterName, float depth);
+    void clearLfoRoute(int slot);
+    std::string getLfoRouteParameter(int slot) const;
+    float getLfoRouteDepth(int slot) const;
+    
+    // Latest LFO output, for display
+    float getLfoValue() const { return lfoDisplayValue.load(); }
 
 private:
     // Parameter mapping system for AI response application
@@ -3825,6 +3953,12 @@ private:
         float minValue;
         float maxValue;
         std::function<void(float)> setter;
+        
+        // FLOAT parameters only, for LFO routes: the value the setter stored (message
+        // thread) and a change to the engine alone that leaves that value as it is (audio thread).
+        // Parameters read only at note on (the start phases) have neither and cannot be routed.
+        std::function<float()> getter = nullptr;
+        std::function<void(float)> modulate = nullptr;
     };
     
     std::map<std::string, ParameterInfo> parameterMap;
@@ -3837,6 +3971,7 @@ private:
     void updateEnvelopeParameters();
     void updateOsc1Type();
     void updateOsc1PulseWidth();
+    void updateOsc2PulseWidth();
     void updateOsc1Octave();
     void updateOsc1Semitone();
     void updateOsc1FineTune();
@@ -3851,6 +3986,51 @@ private:
     void updateOsc2EnvelopeParameters();
     void updateFilterParameters();
     void updateFilterRouting();
+    void updateLfoParameters();
+    void updateAllVoiceParameters();
+    
+    // Setters run on the message thread: they store their value and queue the engine
+    // update, and processBlock applies the queue before rendering
+    using ParameterValues = ParameterChangeQueue<SummonerXSerum2AudioProcessor>::Values;
+    void pushParameterChange(ParameterChangeQueue<SummonerXSerum2AudioProcessor>::ApplyFunction apply,
+                             float value1, float value2 = 0.0f, float value3 = 0.0f, float value4 = 0.0f);
+    void queueParameterChange(ParameterChangeQueue<SummonerXSerum2AudioProcessor>::ApplyFunction apply, const ParameterValues& values);
+    
+    // Groups the setter calls of a preset or response, so LFO routes pick up their new
+    // bases once at the end rather than after every change
+    struct ParameterBatch
+    {
+        explicit ParameterBatch(SummonerXSerum2AudioProcessor& p) : processor(p) { ++processor.parameterBatchDepth; }
+        ~ParameterBatch()
+        {
+            if (--processor.parameterBatchDepth == 0)
+                processor.updateLfoRouteBases();
+        }
+        
+        SummonerXSerum2AudioProcessor& processor;
+    };
+    int parameterBatchDepth = 0;
+    
+    template <typename Function>
+    void forEachVoice(Function&& function)
+    {
+        for (auto* voice : sineVoices)
+            function(*voice);
+    }
+    
+    // Audio thread: LFO change to one setting of the shared filters, passed on to the
+    // sounding voices only; a voice copies the shared filters when it starts
+    template <typename Function>
+    void modulateFilters(Function&& function)
+    {
+        function(osc1Filter);
+        function(osc2Filter);
+        forEachVoice([&function](SineWaveVoice& voice)
+        {
+            if (voice.isVoiceActive())
+                voice.modulateFilters(function);
+        });
+    }
     
     // Helper function to convert resonance (0.0-1.0) to Q factor
     float resonanceToQ(float resonance) const {
@@ -3865,8 +4045,11 @@ private:
     mutable juce::CriticalSection responseLock;
 
     // Synthesizer components
-    juce::Synthesiser synthesiser;
+    PolyphonicSynthesiser synthesiser; // Voice pool is allocated once in the constructor
     float masterVolume = 3.0f; // +25 dB louder (approximately)
+    float outputGain = 3.0f; // Audio thread copy of masterVolume
+    int polyphony = 8; // 1 to 64 voices
+    int voiceStealMode = 0; // 0=Oldest, 1=Quietest, 2=Same note
     float osc1Detune = 0.0f;
     float osc1StereoWidth = 0.5f;
     float osc1Pan = 0.0f;
@@ -3889,7 +4072,7 @@ private:
     // Second oscillator parameters
     float osc2Volume = 0.0f; // 0.0 to 1.0
     bool osc2Enabled = true; // true when wave button is toggled
-    int osc2Type = 1; // 0 = sine, 1 = saw, 2 = square, 3 = triangle, 4 = white noise, 5 = pink noise
+    int osc2Type = 1; // 0 = sine, 1 = saw, 2 = square, 3 = triangle, 4 = white noise, 5 = pink noise, 6 = brown noise
     int osc2VoiceCount = 1; // 1 to 16 unison voices
     float osc2Detune = 0.0f; // 0.0 to 1.0, controls detune amount
     float osc2Stereo = 0.5f; // 0.0 to 1.0, controls stereo width
@@ -3899,6 +4082,7 @@ private:
     int osc2FineTune = 0; // -100 to +100 cents
     bool osc2RandomPhase = true; // true = random phase, false = fixed phase
     float osc2Phase = 0.0f; // 0.0 to 360.0 degrees, fixed phase starting point
+    float osc2PulseWidth = 0.5f; // 0.0 to 1.0, high fraction of the square's cycle
     float osc2Attack = 0.01f;
     float osc2Decay = 0.2f;
     float osc2Sustain = 0.7f;
@@ -3912,7 +4096,9 @@ private:
     bool filterBPEnabled = false; // BP filter disabled by default
     bool filterNotchEnabled = false; // Notch filter disabled by default
     bool filterCombEnabled = false; // Comb filter disabled by default
+    bool filterCombNegative = false; // Comb feedback polarity (false = positive)
     bool filterFormantEnabled = false; // Formant filter disabled by default
+    float filterFormantVowel = 0.0f; // Formant vowel: 0 = a, 1 = e, 2 = i, 3 = o, 4 = u (morphs in between)
     bool filter12dBEnabled = true; // 12dB slope enabled by default
     bool filter24dBEnabled = false; // 24dB slope disabled by default
     bool osc1FilterEnabled = false; // OSC 1 filter disabled by default
@@ -3929,6 +4115,7 @@ private:
     float chorusFeedback = 0.2f; // 0.0 to 0.95
     float chorusLPF = 20000.0f; // 200.0 to 20000.0 Hz
     float chorusMix = 0.5f; // 0.0 to 1.0
+    int chorusVoices = 3; // 3 to 6 delay taps per channel
     ChorusEffect chorus; // Chorus effect instance
     
     // Flanger effect parameters
@@ -3972,6 +4159,7 @@ private:
     int distortionFilterType = 1; // 1=LP, 2=BP, 3=HP
     float distortionFilterFreq = 1000.0f; // 20.0 to 20000.0 Hz
     float distortionFilterQ = 0.707f; // 0.1 to 30.0
+    int distortionOversampling = 0; // 0=Off, 1=2x, 2=4x, 3=8x
     DistortionEffect distortion; // Distortion effect instance
     
     // Delay effect parameters
@@ -3993,7 +4181,7 @@ private:
     // ===== REVERB EFFECT PARAMETERS =====
     bool reverbEnabled = false;
     float reverbMix = 0.3f; // 0.0 to 1.0
-    int reverbType = 2; // 1-5 (PLATE, HALL, VINTAGE, ROOM, AMBIENCE)
+    int reverbType = 2; // 1-6 (PLATE, HALL, VINTAGE, ROOM, AMBIENCE, IMPULSE)
     float reverbLowCut = 80.0f; // 20.0 to 1000.0 Hz
     float reverbHighCut = 8000.0f; // 1000.0 to 20000.0 Hz
     float reverbSize = 0.5f; // 0.0 to 1.0
@@ -4005,33 +4193,48 @@ private:
     // EQ effect parameters and instance
     bool eqEnabled = false;
     
-    // Band 1 parameters
-    bool eq1Enabled = true; // Individual band 1 enable/disable
-    float eq1Frequency = 400.0f; // 20.0 to 20000.0 Hz
-    float eq1Q = 1.0f; // 0.1 to 30.0
-    float eq1Gain = 0.0f; // -15.0 to +15.0 dB
-    int eq1Type = 0; // 0=Peak, 1=Shelf, 2=Pass
+    int eqBandCount = 2; // 1 to maxEqBands
     
-    // Band 2 parameters  
-    bool eq2Enabled = true; // Individual band 2 enable/disable
-    float eq2Frequency = 4000.0f; // 20.0 to 20000.0 Hz
-    float eq2Q = 1.0f; // 0.1 to 30.0
-    float eq2Gain = 0.0f; // -15.0 to +15.0 dB
-    int eq2Type = 0; // 0=Peak, 1=Shelf, 2=Pass
+    // Per-band parameters, band 0 first
+    std::array<bool, maxEqBands> eqBandEnabled { true, true, true, true, true, true, true, true };
+    std::array<float, maxEqBands> eqBandFrequency { 400.0f, 4000.0f, 100.0f, 1000.0f, 2500.0f, 8000.0f, 50.0f, 12000.0f }; // 20.0 to 20000.0 Hz
+    std::array<float, maxEqBands> eqBandQ { 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f }; // 0.1 to 30.0
+    std::array<float, maxEqBands> eqBandGain {}; // -15.0 to +15.0 dB
+    std::array<int, maxEqBands> eqBandFilterType {}; // BiquadCoefficients::FilterType
+    
+    // The two-band editor's type choices, 0=Peak, 1=Shelf, 2=Pass
+    int eq1Type = 0;
+    int eq2Type = 0;
     
     ParametricEQEffect eq; // EQ effect instance
     
+    // Silence tracking so idle effects can be skipped once their tails have decayed
+    TailGate chorusGate, flangerGate, phaserGate, compressorGate;
+    TailGate distortionGate, delayGate, reverbGate, eqGate;
+    
     // Temporary buffers for separate oscillator processing
     juce::AudioBuffer<float> osc1Buffer;
     juce::AudioBuffer<float> osc2Buffer;
     
+    // Band-limited oscillator tables shared by every voice
+    WavetableBank wavetables;
+    
+    // Note frequencies read by the voices at note-on. The Scala data lives on the message
+    // thread; each change is rendered into a new table and handed over through a FIFO
+    ScalaTuning scalaTuning;
+    TuningTable tuning;
+    juce::AbstractFifo tuningFifo { 4 };
+    std::array<TuningTable, 4> pendingTunings;
+    void publishTuning();
+    void applyPendingTuning();
+    
     struct SineWaveSound : public juce::SynthesiserSound
     {
         bool appliesToNote(int) override { return true; }
         bool appliesToChannel(int) override { return true; }
     };
     
-    struct SineWaveVoice : public juce::SynthesiserVoice
+    struct SineWaveVoice : public PolyphonicSynthesiser::Voice
     {
         SineWaveVoice()
         {
@@ -4041,6 +4244,20 @@ private:
             // Initialize per-voice filter instances
             voiceOsc1Filter.setSampleRate(44100.0);
             voiceOsc2Filter.setSampleRate(44100.0);
+            
+            // Match the unison stacks to the default oscillator settings
+            setOsc1VoiceCount(osc1VoiceCount);
+            setOsc1Volume(osc1Volume);
+            setStereoWidth(stereoWidth);
+            setOsc2VoiceCount(osc2VoiceCount);
+            setOsc2Volume(osc2Volume);
+            setOsc2Stereo(osc2Stereo);
+            setDetune(detune);
+            setOsc2Detune(osc2Detune);
+            
+            // Every voice gets its own noise sequences
+            osc1Noise.seed(static_cast<uint32_t>(juce::Random::getSystemRandom().nextInt()));
+            osc2Noise.seed(static_cast<uint32_t>(juce::Random::getSystemRandom().nextInt()));
         }
         
         bool canPlaySound(juce::SynthesiserSound* sound) override
@@ -4050,84 +4267,58 @@ private:
         
         void startNote(int midiNoteNumber, float velocity, juce::SynthesiserSound*, int) override
         {
-            // Calculate oscillator 1 frequency with all its modifications
-            frequency = juce::MidiMessage::getMidiNoteInHertz(midiNoteNumber);
-            // Apply oscillator 1 octave shift: each octave doubles/halves the frequency
-            frequency *= std::pow(2.0, osc1Octave);
-            // Apply oscillator 1 semitone shift: each semitone is 2^(1/12) frequency ratio
-            frequency *= std::pow(2.0, osc1Semitone / 12.0);
-            // Apply oscillator 1 fine tune shift: each cent is 2^(1/1200) frequency ratio
-            frequency *= std::pow(2.0, osc1FineTune / 1200.0);
+            // Pitch is a table lookup: the semitone offset moves along the tuning table (so it
+            // follows a microtonal scale), octave and fine tune are a ratio kept up to date by the setters
+            frequency = tuning->getFrequency(midiNoteNumber + osc1Semitone) * osc1PitchRatio;
+            const double osc2BaseFrequency = tuning->getFrequency(midiNoteNumber + osc2Semitone) * osc2PitchRatio;
+            
+            // Keys a keyboard mapping leaves unmapped do not sound (an unmapped oscillator 2
+            // offset only mutes oscillator 2, through its zero increment)
+            if (frequency <= 0.0)
+            {
+                clearCurrentNote();
+                osc1Increment = 0.0;
+                osc2Increment = 0.0;
+                return;
+            }
+            
             level = velocity * 0.15 * 3.16f; // Increased by 10dB
             
             // Initialize oscillator 1 unison voices with detuning
             for (int i = 0; i < maxUnisonVoices; ++i)
             {
-                // Calculate detune amount: spread voices based on detune parameter
-                double detuneCents = 0.0;
-                if (osc1VoiceCount > 1)
-                {
-                    // Max detune of 50 cents * detune parameter (0.0 to 1.0)
-                    double maxDetune = 50.0 * detune;
-                    detuneCents = (i - (osc1VoiceCount - 1) / 2.0) * (maxDetune * 2.0 / (osc1VoiceCount - 1));
-                }
+                unisonFrequencies[i] = frequency * osc1DetuneRatios[i];
                 
-                // Apply detuning
-                unisonFrequencies[i] = frequency * std::pow(2.0, detuneCents / 1200.0);
-                unisonDeltas[i] = unisonFrequencies[i] * 2.0 * juce::MathConstants<double>::pi / getSampleRate();
-                
-                // Set initial phase for oscillator 1
-                if (osc1RandomPhase)
-                {
-                    unisonAngles[i] = random.nextFloat() * 2.0 * juce::MathConstants<double>::pi;
-                }
-                else
-                {
-                    // Convert fixed phase from degrees to radians
-                    unisonAngles[i] = fixedPhase * juce::MathConstants<double>::pi / 180.0;
-                }
+                // Set initial phase for oscillator 1 (in cycles, 0.0 to 1.0)
+                // Fixed phase is converted from degrees to cycles
+                const double startPhase = osc1RandomPhase ? random.nextFloat() : fixedPhase / 360.0;
+                osc1Unison.setVoice(i, startPhase, unisonFrequencies[i] / getSampleRate());
             }
             
-            // Keep legacy variables for oscillator 1 compatibility
-            angleDelta = frequency * 2.0 * juce::MathConstants<double>::pi / getSampleRate();
-            currentAngle = osc1RandomPhase ? random.nextFloat() * 2.0 * juce::MathConstants<double>::pi : (fixedPhase * juce::MathConstants<double>::pi / 180.0);
-            
-            // Initialize second oscillator with INDEPENDENT frequency and pitch offsets
-            double osc2BaseFrequency = juce::MidiMessage::getMidiNoteInHertz(midiNoteNumber);
-            // Apply oscillator 2 octave shift: each octave doubles/halves the frequency
-            osc2BaseFrequency *= std::pow(2.0, osc2Octave);
-            // Apply oscillator 2 semitone shift: each semitone is 2^(1/12) frequency ratio
-            osc2BaseFrequency *= std::pow(2.0, osc2Semitone / 12.0);
-            // Apply oscillator 2 fine tune shift: each cent is 2^(1/1200) frequency ratio
-            osc2BaseFrequency *= std::pow(2.0, osc2FineTune / 1200.0);
-            osc2AngleDelta = osc2BaseFrequency * 2.0 * juce::MathConstants<double>::pi / getSampleRate();
-            osc2CurrentAngle = osc2RandomPhase ? random.nextFloat() * 2.0 * juce::MathConstants<double>::pi : (osc2Phase * juce::MathConstants<double>::pi / 180.0);
+            osc1Increment = frequency / getSampleRate();
+            osc2Increment = osc2BaseFrequency / getSampleRate();
             
             // Initialize oscillator 2 unison voices with controllable detuning
             for (int i = 0; i < maxOsc2UnisonVoices; ++i)
             {
-                // Calculate detune amount for osc2: spread voices based on detune parameter
-                double osc2DetuneCents = 0.0;
-                if (osc2VoiceCount > 1)
-                {
-                    // Max detune of 50 cents * detune parameter (0.0 to 1.0)
-                    double maxOsc2Detune = 50.0 * osc2Detune;
-                    osc2DetuneCents = (i - (osc2VoiceCount - 1) / 2.0) * (maxOsc2Detune * 2.0 / (osc2VoiceCount - 1));
-                }
+                osc2UnisonFrequencies[i] = osc2BaseFrequency * osc2DetuneRatios[i];
                 
-                // Apply detuning to osc2
-                osc2UnisonFrequencies[i] = osc2BaseFrequency * std::pow(2.0, osc2DetuneCents / 1200.0);
-                osc2UnisonDeltas[i] = osc2UnisonFrequencies[i] * 2.0 * juce::MathConstants<double>::pi / getSampleRate();
-                
-                // Set initial phase for oscillator 2 (random or fixed based on setting)
-                osc2UnisonAngles[i] = osc2RandomPhase ? random.nextFloat() * 2.0 * juce::MathConstants<double>::pi : (osc2Phase * juce::MathConstants<double>::pi / 180.0);
+                // Set initial phase for oscillator 2 in cycles (random or fixed based on setting)
+                const double startPhase = osc2RandomPhase ? random.nextFloat() : osc2Phase / 360.0;
+                osc2Unison.setVoice(i, startPhase, osc2UnisonFrequencies[i] / getSampleRate());
             }
             
+            // Retriggers from the current level, including straight after the hard stop that
+            // precedes a steal or a repeated note
+            hardStopped = false;
             envelope.setSampleRate(getSampleRate());
             envelope.noteOn();
             
             osc2Envelope.setSampleRate(getSampleRate());
             osc2Envelope.noteOn();
+            
+            // Only sounding voices follow an LFO on the filter, so a new note catches up here
+            updatePerVoiceFilters();
         }
         
         void stopNote(float, bool allowTailOff) override
@@ -4135,272 +4326,154 @@ private:
             envelope.noteOff();
             osc2Envelope.noteOff();
             
+            // juce::Synthesiser hard-stops a voice just before restarting it, so the envelope
+            // levels are kept here; if no new note follows, the next render resets them
             if (!allowTailOff)
             {
+                hardStopped = true;
                 clearCurrentNote();
-                angleDelta = 0.0;
-                osc2AngleDelta = 0.0;
+                osc1Increment = 0.0;
+                osc2Increment = 0.0;
+                envelopeLevel = 0.0f;
             }
         }
         
+        float getEnvelopeLevel() const override { return envelopeLevel; }
+        
         void pitchWheelMoved(int) override {}
         void controllerMoved(int, int) override {}
         
         void renderNextBlock(juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples) override
         {
-            if (angleDelta != 0.0)
+            if (osc1Increment == 0.0 || wavetables == nullptr)
             {
-                while (--numSamples >= 0)
+                if (hardStopped)
                 {
-                    float leftSample = 0.0f;
-                    float rightSample = 0.0f;
-                    
-                    // Sum all active oscillator 1 unison voices with stereo panning
-                    for (int voice = 0; voice < osc1VoiceCount; ++voice)
-                    {
-                        float voiceSample;
-                        
-                        // Generate waveform based on oscillator 1 type for this voice
-                        if (osc1Type == 0) // Sine wave
-                        {
-                            voiceSample = (float)(std::sin(unisonAngles[voice]) * osc1Volume * 3.16f / 6.31f);
-                        }
-                        else if (osc1Type == 1) // Saw wave
-                        {
-                            auto normalizedAngle = std::fmod(unisonAngles[voice], 2.0 * juce::MathConstants<double>::pi) / (2.0 * juce::MathConstants<double>::pi);
-                            voiceSample = (float)((2.0 * normalizedAngle - 1.0) * osc1Volume * 3.16f / 6.31f);
-                        }
-                        else if (osc1Type == 2) // Square wave
-                        {
-                            auto normalizedAngle = std::fmod(unisonAngles[voice], 2.0 * juce::MathConstants<double>::pi) / (2.0 * juce::MathConstants<double>::pi);
-                            voiceSample = (float)((normalizedAngle < 0.5 ? 1.0 : -1.0) * osc1Volume * 3.16f / 6.31f);
-                        }
-                        else if (osc1Type == 3) // Triangle wave
-                        {
-                            auto normalizedAngle = std::fmod(unisonAngles[voice], 2.0 * juce::MathConstants<double>::pi) / (2.0 * juce::MathConstants<double>::pi);
-                            if (normalizedAngle < 0.5)
-                                voiceSample = (float)((normalizedAngle * 4.0 - 1.0) * osc1Volume * 3.16f / 6.31f);
-                            else
-                                voiceSample = (float)((3.0 - normalizedAngle * 4.0) * osc1Volume * 3.16f / 6.31f);
-                        }
-                        else if (osc1Type == 4) // White noise
-                        {
-                            // White noise: random values between -1 and 1 (same for all unison voices)
-                            voiceSample = (float)((random.nextFloat() * 2.0f - 1.0f) * osc1Volume * 3.16f / 6.31f);
-                        }
-                        else if (osc1Type == 5) // Pink noise
-                        {
-                            // Pink noise using Paul Kellett's method (same for all unison voices)
-                            float white = random.nextFloat() * 2.0f - 1.0f;
-                            
-                            pinkFilter[0] = 0.99886f * pinkFilter[0] + white * 0.0555179f;
-                            pinkFilter[1] = 0.99332f * pinkFilter[1] + white * 0.0750759f;
-                            pinkFilter[2] = 0.96900f * pinkFilter[2] + white * 0.1538520f;
-                            pinkFilter[3] = 0.86650f * pinkFilter[3] + white * 0.3104856f;
-                            pinkFilter[4] = 0.55000f * pinkFilter[4] + white * 0.5329522f;
-                            pinkFilter[5] = -0.7616f * pinkFilter[5] - white * 0.0168980f;
-                            
-                            float pink = pinkFilter[0] + pinkFilter[1] + pinkFilter[2] + pinkFilter[3] + pinkFilter[4] + pinkFilter[5] + pinkFilter[6] + white * 0.5362f;
-                            pinkFilter[6] = white * 0.115926f;
-                            
-                            voiceSample = (float)(pink * 0.11f * osc1Volume * 3.16f / 6.31f);
-                        }
-                        else
-                        {
-                            // Default to sine wave for unknown oscillator types
-                            voiceSample = (float)(std::sin(unisonAngles[voice]) * osc1Volume * 3.16f / 6.31f);
-                        }
-                        
-                        // Calculate stereo panning for this voice
-                        float voicePan = 0.0f; // Center by default
-                        if (osc1VoiceCount > 1)
-                        {
-                            // Spread voices across stereo field based on stereo width
-                            voicePan = (voice - (osc1VoiceCount - 1) / 2.0f) / ((osc1VoiceCount - 1) / 2.0f) * stereoWidth;
-                            voicePan = juce::jlimit(-1.0f, 1.0f, voicePan);
-                        }
-                        
-                        // Apply panning (equal power panning)
-                        float leftGain = std::cos((voicePan + 1.0f) * juce::MathConstants<float>::pi * 0.25f);
-                        float rightGain = std::sin((voicePan + 1.0f) * juce::MathConstants<float>::pi * 0.25f);
-                        
-                        leftSample += voiceSample * leftGain;
-                        rightSample += voiceSample * rightGain;
-                        
-                        // Update angle for this voice
-                        unisonAngles[voice] += unisonDeltas[voice];
-                    }
-                    
-                    // Apply level scaling to prevent clipping from multiple oscillator 1 voices
-                    leftSample /= std::sqrt((float)osc1VoiceCount);
-                    rightSample /= std::sqrt((float)osc1VoiceCount);
-                    
-                    // Apply envelope to oscillator 1 ONLY
-                    auto envelopeValue = envelope.getNextSample();
-                    leftSample *= envelopeValue;
-                    rightSample *= envelopeValue;
-                    
-                    // Apply overall pan to oscillator 1 (-1.0 to +1.0 range like OSC2)
-                    float normalizedPan = pan;
-                    normalizedPan = juce::jlimit(-1.0f, 1.0f, normalizedPan);
-                    
-                    // Apply overall pan using equal power panning to oscillator 1
-                    float panLeftGain = std::cos((normalizedPan + 1.0f) * juce::MathConstants<float>::pi * 0.25f);
-                    float panRightGain = std::sin((normalizedPan + 1.0f) * juce::MathConstants<float>::pi * 0.25f);
-                    
-                    leftSample *= panLeftGain;
-                    rightSample *= panRightGain;
-                    
-                    // Apply filter to OSC1 if enabled (using per-voice filter)
-                    if (osc1FilterEnabled)
-                    {
-                        leftSample = voiceOsc1Filter.processSample(leftSample, 0);
-                        rightSample = voiceOsc1Filter.processSample(rightSample, 1);
-                    }
-                    
-                    // Add second oscillator if enabled with its own envelope and unison voices
-                    if (osc2Enabled && osc2Volume > 0.0f && osc2AngleDelta != 0.0)
-                    {
-                        float osc2LeftSample = 0.0f;
-                        float osc2RightSample = 0.0f;
-                        
-                        // Sum all active oscillator 2 unison voices
-                        for (int voice = 0; voice < osc2VoiceCount; ++voice)
-                        {
-                            float voiceSample;
-                            
-                            // Generate waveform based on oscillator 2 type for this voice
-                            if (osc2Type == 0) // Sine wave
-                            {
-                                voiceSample = (float)(std::sin(osc2UnisonAngles[voice]) * osc2Volume * 3.16f / 6.31f); // +10dB then -16dB = -6dB net
-                            }
-                            else if (osc2Type == 1) // Saw wave
-                            {
-                                auto normalizedAngle = std::fmod(osc2UnisonAngles[voice], 2.0 * juce::MathConstants<double>::pi) / (2.0 * juce::MathConstants<double>::pi);
-                                voiceSample = (float)((2.0 * normalizedAngle - 1.0) * osc2Volume * 3.16f / 6.31f); // +10dB then -16dB = -6dB net
-                            }
-                            else if (osc2Type == 2) // Square wave
-                            {
-                                auto normalizedAngle = std::fmod(osc2UnisonAngles[voice], 2.0 * juce::MathConstants<double>::pi) / (2.0 * juce::MathConstants<double>::pi);
-                                voiceSample = (float)((normalizedAngle < 0.5 ? 1.0 : -1.0) * osc2Volume * 3.16f / 6.31f); // +10dB then -16dB = -6dB net
-                            }
-                            else if (osc2Type == 3) // Triangle wave
-                            {
-                                auto normalizedAngle = std::fmod(osc2UnisonAngles[voice], 2.0 * juce::MathConstants<double>::pi) / (2.0 * juce::MathConstants<double>::pi);
-                                if (normalizedAngle < 0.5)
-                                    voiceSample = (float)((normalizedAngle * 4.0 - 1.0) * osc2Volume * 3.16f / 6.31f); // +10dB then -16dB = -6dB net
-                                else
-                                    voiceSample = (float)((3.0 - normalizedAngle * 4.0) * osc2Volume * 3.16f / 6.31f); // +10dB then -16dB = -6dB net
-                            }
-                            else if (osc2Type == 4) // White noise
-                            {
-                                // White noise: same for all unison voices
-                                voiceSample = (float)((random.nextFloat() * 2.0f - 1.0f) * osc2Volume * 3.16f / 6.31f); // +10dB then -16dB = -6dB net
-                            }
-                            else if (osc2Type == 5) // Pink noise
-                            {
-                                // Pink noise: same for all unison voices
-                                float white = random.nextFloat() * 2.0f - 1.0f;
-                                
-                                osc2PinkFilter[0] = 0.99886f * osc2PinkFilter[0] + white * 0.0555179f;
-                                osc2PinkFilter[1] = 0.99332f * osc2PinkFilter[1] + white * 0.0750759f;
-                                osc2PinkFilter[2] = 0.96900f * osc2PinkFilter[2] + white * 0.1538520f;
-                                osc2PinkFilter[3] = 0.86650f * osc2PinkFilter[3] + white * 0.3104856f;
-                                osc2PinkFilter[4] = 0.55000f * osc2PinkFilter[4] + white * 0.5329522f;
-                                osc2PinkFilter[5] = -0.7616f * osc2PinkFilter[5] - white * 0.0168980f;
-                                
-                                float pink = osc2PinkFilter[0] + osc2PinkFilter[1] + osc2PinkFilter[2] + osc2PinkFilter[3] + osc2PinkFilter[4] + osc2PinkFilter[5] + osc2PinkFilter[6] + white * 0.5362f;
-                                osc2PinkFilter[6] = white * 0.115926f;
-                                
-                                voiceSample = (float)(pink * 0.11f * osc2Volume * 3.16f / 6.31f); // +10dB then -16dB = -6dB net
-                            }
-                            else
-                            {
-                                // Default to sine wave for unknown types
-                                voiceSample = (float)(std::sin(osc2UnisonAngles[voice]) * osc2Volume * 3.16f / 6.31f); // +10dB then -16dB = -6dB net
-                            }
-                            
-                            // Calculate stereo panning for this osc2 voice
-                            float voicePan = 0.0f; // Center by default
-                            if (osc2VoiceCount > 1)
-                            {
-                                // Spread voices across stereo field based on stereo width
-                                voicePan = (voice - (osc2VoiceCount - 1) / 2.0f) / ((osc2VoiceCount - 1) / 2.0f) * osc2Stereo;
-                                voicePan = juce::jlimit(-1.0f, 1.0f, voicePan);
-                            }
-                            
-                            // Apply panning (equal power panning)
-                            float leftGain = std::cos((voicePan + 1.0f) * juce::MathConstants<float>::pi * 0.25f);
-                            float rightGain = std::sin((voicePan + 1.0f) * juce::MathConstants<float>::pi * 0.25f);
-                            
-                            osc2LeftSample += voiceSample * leftGain;
-                            osc2RightSample += voiceSample * rightGain;
-                            
-                            // Update angle for this voice
-                            osc2UnisonAngles[voice] += osc2UnisonDeltas[voice];
-                        }
-                        
-                        // Apply level scaling to prevent clipping from multiple osc2 voices
-                        osc2LeftSample /= std::sqrt((float)osc2VoiceCount);
-                        osc2RightSample /= std::sqrt((float)osc2VoiceCount);
-                        
-                        // Apply osc2 envelope
-                        auto osc2EnvelopeValue = osc2Envelope.getNextSample();
-                        osc2LeftSample *= osc2EnvelopeValue;
-                        osc2RightSample *= osc2EnvelopeValue;
-                        
-                        // Apply overall pan control for oscillator 2
-                        float osc2PanLeftGain = std::cos((osc2Pan + 1.0f) * juce::MathConstants<float>::pi * 0.25f);
-                        float osc2PanRightGain = std::sin((osc2Pan + 1.0f) * juce::MathConstants<float>::pi * 0.25f);
-                        
-                        osc2LeftSample *= osc2PanLeftGain;
-                        osc2RightSample *= osc2PanRightGain;
-                        
-                        // Apply filter to OSC2 if enabled (using per-voice filter)
-                        if (osc2FilterEnabled)
-                        {
-                            osc2LeftSample = voiceOsc2Filter.processSample(osc2LeftSample, 0);
-                            osc2RightSample = voiceOsc2Filter.processSample(osc2RightSample, 1);
-                        }
-                        
-                        // Add to main mix
-                        leftSample += osc2LeftSample;
-                        rightSample += osc2RightSample;
-                        
-                        // Update legacy oscillator 2 angle for compatibility
-                        osc2CurrentAngle += osc2AngleDelta;
-                    }
-                    
-                    // Output to stereo channels
-                    if (outputBuffer.getNumChannels() >= 2)
-                    {
-                        outputBuffer.addSample(0, startSample, leftSample);
-                        outputBuffer.addSample(1, startSample, rightSample);
-                    }
-                    else if (outputBuffer.getNumChannels() == 1)
-                    {
-                        // Mono output - mix left and right
-                        outputBuffer.addSample(0, startSample, (leftSample + rightSample) * 0.5f);
-                    }
-                    
-                    ++startSample;
+                    envelope.reset();
+                    osc2Envelope.reset();
+                    hardStopped = false;
+                }
+                return;
+            }
+            
+            // Resolve the band-limited table for every unison voice once per block
+            osc1Unison.selectTables(*wavetables, getWavetableWaveform(osc1Type));
+            osc2Unison.selectTables(*wavetables, getWavetableWaveform(osc2Type));
+            
+            while (numSamples > 0)
+            {
+                const int blockSize = juce::jmin(numSamples, subBlockSize);
+                
+                // Snapshot the parameters once per sub-block
+                const int currentOsc1Type = osc1Type;
+                const int currentOsc2Type = osc2Type;
+                const bool filterOsc1 = osc1FilterEnabled;
+                const bool filterOsc2 = osc2FilterEnabled;
+                const bool renderOsc2 = osc2Enabled && osc2Volume > 0.0f && osc2Increment != 0.0;
+                const float osc1PanValue = juce::jlimit(-1.0f, 1.0f, pan);
+                const float osc2PanValue = osc2Pan;
+                
+                // Oscillator 1: unison stack, envelope as a gain ramp, overall equal power pan
+                renderOscillatorBlock(currentOsc1Type, osc1PulseWidth, osc1Unison, osc1Noise, osc1Left, osc1Right, blockSize);
+                
+                envelope.render(envelopeGains, blockSize);
+                
+                envelopeLevel = envelopeGains[blockSize - 1];
+                applyGainAndPan(osc1Left, osc1Right, envelopeGains, osc1PanValue, blockSize);
+                
+                // The state-variable types filter both oscillators at once further down
+                const bool filterInBank = (filterOsc1 || filterOsc2)
+                                       && voiceOsc1Filter.usesStateVariableCore() && voiceOsc2Filter.usesStateVariableCore();
+                
+                if (filterOsc1 && !filterInBank)
+                    voiceOsc1Filter.processBlock(osc1Left, osc1Right, blockSize);
+                
+                // Oscillator 2: the envelope keeps running even while the oscillator is silent
+                osc2Envelope.render(envelopeGains, blockSize);
+                
+                if (renderOsc2)
+                {
+                    renderOscillatorBlock(currentOsc2Type, osc2PulseWidth, osc2Unison, osc2Noise, osc2Left, osc2Right, blockSize);
+                    envelopeLevel = juce::jmax(envelopeLevel, envelopeGains[blockSize - 1]);
+                    applyGainAndPan(osc2Left, osc2Right, envelopeGains, osc2PanValue, blockSize);
                     
-                    if (!envelope.isActive() && !osc2Envelope.isActive())
-                    {
-                        clearCurrentNote();
-                        angleDelta = 0.0;
-                        osc2AngleDelta = 0.0;
-                        break;
-                    }
+                    if (filterOsc2 && !filterInBank)
+                        voiceOsc2Filter.processBlock(osc2Left, osc2Right, blockSize);
+                }
+                
+                if (filterInBank)
+                    filterOscillatorsInBank(filterOsc1, filterOsc2 && renderOsc2, renderOsc2, blockSize);
+                
+                if (renderOsc2)
+                {
+                    juce::FloatVectorOperations::add(osc1Left, osc2Left, blockSize);
+                    juce::FloatVectorOperations::add(osc1Right, osc2Right, blockSize);
+                }
+                
+                // Output to stereo channels
+                if (outputBuffer.getNumChannels() >= 2)
+                {
+                    juce::FloatVectorOperations::add(outputBuffer.getWritePointer(0, startSample), osc1Left, blockSize);
+                    juce::FloatVectorOperations::add(outputBuffer.getWritePointer(1, startSample), osc1Right, blockSize);
+                }
+                else if (outputBuffer.getNumChannels() == 1)
+                {
+                    // Mono output - mix left and right
+                    auto* mono = outputBuffer.getWritePointer(0, startSample);
+                    juce::FloatVectorOperations::addWithMultiply(mono, osc1Left, 0.5f, blockSize);
+                    juce::FloatVectorOperations::addWithMultiply(mono, osc1Right, 0.5f, blockSize);
+                }
+                
+                startSample += blockSize;
+                numSamples -= blockSize;
+                
+                // Retire as soon as no sounding oscillator's envelope can be heard, rather than
+                // waiting out the tail; a muted or disabled oscillator 2 does not hold the voice
+                const bool osc1Audible = osc1Volume > 0.0f && envelope.isAudible();
+                const bool osc2Audible = renderOsc2 && osc2Envelope.isAudible();
+                if (!osc1Audible && !osc2Audible)
+                {
+                    envelope.reset();
+                    osc2Envelope.reset();
+                    clearCurrentNote();
+                    osc1Increment = 0.0;
+                    osc2Increment = 0.0;
+                    envelopeLevel = 0.0f;
+                    break;
                 }
             }
         }
         
+        void setWavetableBank(const WavetableBank* bank)
+        {
+            wavetables = bank;
+        }
+        
+        void setTuningTable(const TuningTable* table)
+        {
+            tuning = table;
+        }
+        
         void setEnvelopeParameters(float attack, float decay, float sustain, float release)
         {
             envelope.setParameters({attack, decay, sustain, release});
         }
         
+        // Changes one stage of an envelope, for the LFO, which does not know the others
+        void setEnvelopeStage(float ExponentialEnvelope::Parameters::* stage, float value)
+        {
+            auto parameters = envelope.getParameters();
+            parameters.*stage = value;
+            envelope.setParameters(parameters);
+        }
+        
+        void setOsc2EnvelopeStage(float ExponentialEnvelope::Parameters::* stage, float value)
+        {
+            auto parameters = osc2Envelope.getParameters();
+            parameters.*stage = value;
+            osc2Envelope.setParameters(parameters);
+        }
+        
         void setOsc1Type(int type)
         {
             osc1Type = type;
@@ -4414,6 +4487,7 @@ private:
         void setOsc1Octave(int oct)
         {
             osc1Octave = oct;
+            osc1PitchRatio = getPitchRatio(osc1Octave, osc1FineTune);
         }
         
         void setOsc1Semitone(int semi)
@@ -4424,6 +4498,7 @@ private:
         void setOsc1FineTune(int fine)
         {
             osc1FineTune = fine;
+            osc1PitchRatio = getPitchRatio(osc1Octave, osc1FineTune);
         }
         
         void setOsc1RandomPhase(bool random)
@@ -4434,21 +4509,28 @@ private:
         void setOsc1VoiceCount(int count)
         {
             osc1VoiceCount = juce::jlimit(1, 16, count);
+            osc1Unison.setVoiceCount(osc1VoiceCount);
+            updateDetuneRatios(osc1DetuneRatios, osc1VoiceCount, detune);
+            retuneOsc1Unison();
         }
 
         void setOsc1Volume(float volume)
         {
             osc1Volume = volume;
+            osc1Unison.setLevel(osc1Volume * 3.16f / 6.31f); // +10dB then -16dB = -6dB net
         }
         
         void setDetune(float detuneAmount)
         {
             detune = detuneAmount;
+            updateDetuneRatios(osc1DetuneRatios, osc1VoiceCount, detune);
+            retuneOsc1Unison();
         }
         
         void setStereoWidth(float width)
         {
             stereoWidth = width;
+            osc1Unison.setStereoWidth(stereoWidth);
         }
         
         void setPan(float panValue)
@@ -4464,6 +4546,7 @@ private:
         void setOsc2Volume(float volume)
         {
             osc2Volume = volume;
+            osc2Unison.setLevel(osc2Volume * 3.16f / 6.31f); // +10dB then -16dB = -6dB net
         }
         
         void setOsc2Enabled(bool enabled)
@@ -4484,16 +4567,22 @@ private:
         void setOsc2VoiceCount(int count)
         {
             osc2VoiceCount = juce::jlimit(1, 16, count);
+            osc2Unison.setVoiceCount(osc2VoiceCount);
+            updateDetuneRatios(osc2DetuneRatios, osc2VoiceCount, osc2Detune);
+            retuneOsc2Unison();
         }
         
         void setOsc2Detune(float detune)
         {
             osc2Detune = detune;
+            updateDetuneRatios(osc2DetuneRatios, osc2VoiceCount, osc2Detune);
+            retuneOsc2Unison();
         }
         
         void setOsc2Stereo(float stereo)
         {
             osc2Stereo = stereo;
+            osc2Unison.setStereoWidth(osc2Stereo);
         }
         
         void setOsc2Pan(float pan)
@@ -4504,6 +4593,7 @@ private:
         void setOsc2Octave(int octave)
         {
             osc2Octave = juce::jlimit(-4, 4, octave);
+            osc2PitchRatio = getPitchRatio(osc2Octave, osc2FineTune);
         }
         
         void setOsc2Semitone(int semitone)
@@ -4514,6 +4604,7 @@ private:
         void setOsc2FineTune(int fineTune)
         {
             osc2FineTune = juce::jlimit(-100, 100, fineTune);
+            osc2PitchRatio = getPitchRatio(osc2Octave, osc2FineTune);
         }
         
         void setOsc2RandomPhase(bool randomPhase)
@@ -4526,6 +4617,11 @@ private:
             osc2Phase = phase;
         }
         
+        void setOsc2PulseWidth(float width)
+        {
+            osc2PulseWidth = width;
+        }
+        
         void setFilterRouting(bool osc1ToFilter, bool osc2ToFilter, SimpleStableFilter* osc1FilterPtr, SimpleStableFilter* osc2FilterPtr)
         {
             osc1FilterEnabled = osc1ToFilter;
@@ -4539,6 +4635,10 @@ private:
         
         void updatePerVoiceFilters()
         {
+            // The pool is created before the host reports a sample rate
+            if (getSampleRate() <= 0.0)
+                return;
+            
             if (osc1FilterInstance != nullptr)
             {
                 voiceOsc1Filter.setSampleRate(getSampleRate());
@@ -4546,6 +4646,8 @@ private:
                 voiceOsc1Filter.setResonance(osc1FilterInstance->getResonance());
                 voiceOsc1Filter.setFilterType(osc1FilterInstance->getFilterType());
                 voiceOsc1Filter.setFilterSlope(osc1FilterInstance->getFilterSlope());
+                voiceOsc1Filter.setCombNegative(osc1FilterInstance->getCombNegative());
+                voiceOsc1Filter.setFormantVowel(osc1FilterInstance->getFormantVowel());
                 // Don't reset - preserve filter state to avoid artifacts
             }
             if (osc2FilterInstance != nullptr)
@@ -4555,21 +4657,186 @@ private:
                 voiceOsc2Filter.setResonance(osc2FilterInstance->getResonance());
                 voiceOsc2Filter.setFilterType(osc2FilterInstance->getFilterType());
                 voiceOsc2Filter.setFilterSlope(osc2FilterInstance->getFilterSlope());
+                voiceOsc2Filter.setCombNegative(osc2FilterInstance->getCombNegative());
+                voiceOsc2Filter.setFormantVowel(osc2FilterInstance->getFormantVowel());
                 // Don't reset - preserve filter state to avoid artifacts
             }
+            
+            updateFilterBank();
+        }
+        
+        // Applies one change to both per-voice filters, for the LFO: cheaper than copying
+        // every setting from the shared filters
+        template <typename Function>
+        void modulateFilters(Function&& function)
+        {
+            if (getSampleRate() <= 0.0)
+                return;
+            
+            if (osc1FilterInstance != nullptr)
+                function(voiceOsc1Filter);
+            if (osc2FilterInstance != nullptr)
+                function(voiceOsc2Filter);
+            
+            updateFilterBank();
         }
         
         
     private:
-        double currentAngle = 0.0, angleDelta = 0.0, level = 0.0;
+        void updateFilterBank()
+        {
+            voiceFilterBank.setOscillator(0, voiceOsc1Filter.getStateVariableCoefficients(),
+                                          voiceOsc1Filter.getStateVariableMode(), voiceOsc1Filter.getNumStateVariableStages());
+            voiceFilterBank.setOscillator(1, voiceOsc2Filter.getStateVariableCoefficients(),
+                                          voiceOsc2Filter.getStateVariableMode(), voiceOsc2Filter.getNumStateVariableStages());
+        }
+        
+        // Runs both oscillators through the voice's SIMD filter lanes and keeps the filtered
+        // signal of the oscillators routed to the filter. The lanes always run together, so
+        // a silent or unrouted oscillator still feeds its lanes to keep them settled.
+        void filterOscillatorsInBank(bool filterOsc1, bool filterOsc2, bool osc2Rendered, int blockSize)
+        {
+            for (int i = 0; i < blockSize; ++i)
+            {
+                float* frame = filterFrames + VoiceFilterBank::numLanes * i;
+                frame[0] = osc1Left[i];
+                frame[1] = osc1Right[i];
+                frame[2] = osc2Rendered ? osc2Left[i] : 0.0f;
+                frame[3] = osc2Rendered ? osc2Right[i] : 0.0f;
+            }
+            
+            voiceFilterBank.processInterleaved(filterFrames, blockSize);
+            
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const float* frame = filterFrames + VoiceFilterBank::numLanes * i;
+                if (filterOsc1)
+                {
+                    osc1Left[i] = frame[0];
+                    osc1Right[i] = frame[1];
+                }
+                if (filterOsc2)
+                {
+                    osc2Left[i] = frame[2];
+                    osc2Right[i] = frame[3];
+                }
+            }
+        }
+        
+        // Renders one oscillator's unison stack into the scratch buffers (overwriting them)
+        void renderOscillatorBlock(int oscType, float pulseWidth, UnisonOscillator& unison, NoiseGenerator& noise,
+                                   float* left, float* right, int numSamples)
+        {
+            if (oscType == 2)
+            {
+                // Square is a PolyBLEP pulse so its width can be modulated
+                unison.renderPulseBlock(left, right, numSamples, pulseWidth);
+                return;
+            }
+            
+            if (oscType < 4 || oscType > 6)
+            {
+                // Sine, saw and triangle (and unknown types as sine) read the band-limited tables
+                unison.renderBlock(left, right, numSamples);
+                return;
+            }
+            
+            // Noise is generated once per block and shared by the whole unison stack
+            const auto colour = oscType == 4 ? NoiseGenerator::WHITE
+                              : oscType == 5 ? NoiseGenerator::PINK
+                                             : NoiseGenerator::BROWN;
+            noise.render(colour, noiseLeft, noiseRight, numSamples);
+            unison.renderNoiseBlock(noiseLeft, noiseRight, left, right, numSamples);
+        }
+        
+        // Octave shift and fine tune (in cents) as one frequency ratio
+        static double getPitchRatio(int octave, int fineTuneCents)
+        {
+            return std::ldexp(TuningTable::centsToRatio(fineTuneCents), octave);
+        }
+        
+        // Spreads the unison voices evenly over +/- 50 cents * detune amount (0.0 to 1.0)
+        template <size_t numVoices>
+        static void updateDetuneRatios(std::array<double, numVoices>& ratios, int voiceCount, float detuneAmount)
+        {
+            for (size_t i = 0; i < numVoices; ++i)
+            {
+                double detuneCents = 0.0;
+                if (voiceCount > 1)
+                {
+                    const double maxDetune = 50.0 * detuneAmount;
+                    detuneCents = (static_cast<double>(i) - (voiceCount - 1) / 2.0) * (maxDetune * 2.0 / (voiceCount - 1));
+                }
+                
+                ratios[i] = TuningTable::centsToRatio(detuneCents);
+            }
+        }
+        
+        // A sounding note follows detune changes (an LFO on detune, for one) without its
+        // unison phases restarting; idle voices pick the ratios up at the next startNote
+        void retuneOsc1Unison()
+        {
+            if (osc1Increment <= 0.0)
+                return;
+            
+            for (int i = 0; i < maxUnisonVoices; ++i)
+            {
+                unisonFrequencies[i] = frequency * osc1DetuneRatios[i];
+                osc1Unison.setIncrement(i, unisonFrequencies[i] / getSampleRate());
+            }
+        }
+        
+        void retuneOsc2Unison()
+        {
+            if (osc2Increment <= 0.0)
+                return;
+            
+            const double osc2BaseFrequency = osc2Increment * getSampleRate();
+            for (int i = 0; i < maxOsc2UnisonVoices; ++i)
+            {
+                osc2UnisonFrequencies[i] = osc2BaseFrequency * osc2DetuneRatios[i];
+                osc2Unison.setIncrement(i, osc2UnisonFrequencies[i] / getSampleRate());
+            }
+        }
+        
+        // Applies the envelope gain ramp and an equal power pan to a stereo scratch block
+        static void applyGainAndPan(float* left, float* right, const float* gains, float panValue, int numSamples)
+        {
+            const float panLeftGain = std::cos((panValue + 1.0f) * juce::MathConstants<float>::pi * 0.25f);
+            const float panRightGain = std::sin((panValue + 1.0f) * juce::MathConstants<float>::pi * 0.25f);
+            
+            juce::FloatVectorOperations::multiply(left, gains, numSamples);
+            juce::FloatVectorOperations::multiply(right, gains, numSamples);
+            juce::FloatVectorOperations::multiply(left, panLeftGain, numSamples);
+            juce::FloatVectorOperations::multiply(right, panRightGain, numSamples);
+        }
+        
+        // Maps the oscillator type to its wavetable (0 = sine, 1 = saw, 2 = square, 3 = triangle)
+        static int getWavetableWaveform(int oscType)
+        {
+            switch (oscType)
+            {
+                case 1: return WavetableBank::SAW;
+                case 2: return WavetableBank::SQUARE;
+                case 3: return WavetableBank::TRIANGLE;
+                default: return WavetableBank::SINE;
+            }
+        }
+        
+        double osc1Increment = 0.0, level = 0.0; // Base pitch in cycles per sample, 0 while idle
         double frequency = 0.0;
         
+        // Shared band-limited tables and note frequencies, owned by the processor
+        const WavetableBank* wavetables = nullptr;
+        const TuningTable* tuning = nullptr;
+        
         // Oscillator 1 unison voice arrays (support up to 16 voices)
         static constexpr int maxUnisonVoices = 16;
-        std::array<double, maxUnisonVoices> unisonAngles;
-        std::array<double, maxUnisonVoices> unisonDeltas;
         std::array<double, maxUnisonVoices> unisonFrequencies;
-        int osc1Type = 1; // 0 = sine, 1 = saw, 2 = square, 3 = triangle, 4 = white noise, 5 = pink noise
+        std::array<double, maxUnisonVoices> osc1DetuneRatios;
+        double osc1PitchRatio = 1.0; // Octave and fine tune
+        UnisonOscillator osc1Unison; // Phases, increments and pan gains as SIMD lanes
+        int osc1Type = 1; // 0 = sine, 1 = saw, 2 = square, 3 = triangle, 4 = white noise, 5 = pink noise, 6 = brown noise
         float osc1PulseWidth = 0.5f;
         int osc1Octave = 0; // -4 to +4 octaves
         int osc1Semitone = 0; // -12 to +12 semitones
@@ -4581,14 +4848,14 @@ private:
         float stereoWidth = 0.5f; // Stereo width (0.0 = mono, 1.0 = full stereo)
         float pan = 0.0f; // Pan position (-50 = left, 0 = center, 50 = right)
         float fixedPhase = 0.0f; // Fixed phase in degrees (0-360)
-        juce::ADSR envelope;
-        juce::ADSR osc2Envelope;
+        ExponentialEnvelope envelope;
+        ExponentialEnvelope osc2Envelope;
         juce::Random random;
         
         // Second oscillator parameters
         float osc2Volume = 0.0f;
         bool osc2Enabled = true;
-        int osc2Type = 1; // 0 = sine, 1 = saw, 2 = square, 3 = triangle, 4 = white noise, 5 = pink noise
+        int osc2Type = 1; // 0 = sine, 1 = saw, 2 = square, 3 = triangle, 4 = white noise, 5 = pink noise, 6 = brown noise
         int osc2VoiceCount = 1; // Number of unison voices (1-16)
         float osc2Detune = 0.0f; // Detune amount (0.0 to 1.0)
         float osc2Stereo = 0.5f; // Stereo width (0.0 to 1.0)
@@ -4598,20 +4865,18 @@ private:
         int osc2FineTune = 0; // Fine tune offset (-100 to +100 cents)
         bool osc2RandomPhase = true; // true = random phase, false = fixed phase
         float osc2Phase = 0.0f; // Fixed phase starting point (0.0 to 360.0 degrees)
-        double osc2CurrentAngle = 0.0;
-        double osc2AngleDelta = 0.0;
+        float osc2PulseWidth = 0.5f;
+        double osc2Increment = 0.0; // Base pitch in cycles per sample
         
         // Oscillator 2 unison voice arrays (support up to 16 voices)
         static constexpr int maxOsc2UnisonVoices = 16;
-        std::array<double, maxOsc2UnisonVoices> osc2UnisonAngles;
-        std::array<double, maxOsc2UnisonVoices> osc2UnisonDeltas;
         std::array<double, maxOsc2UnisonVoices> osc2UnisonFrequencies;
+        std::array<double, maxOsc2UnisonVoices> osc2DetuneRatios;
+        double osc2PitchRatio = 1.0; // Octave and fine tune
+        UnisonOscillator osc2Unison; // Phases, increments and pan gains as SIMD lanes
         
-        // Pink noise generation state for osc2 (Paul Kellett's method)
-        float osc2PinkFilter[7] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
-        
-        // Pink noise generation state (Paul Kellett's method)
-        float pinkFilter[7] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+        // Noise sources for the white, pink and brown oscillator types
+        NoiseGenerator osc1Noise, osc2Noise;
         
         // Filter routing
         bool osc1FilterEnabled = false;
@@ -4622,7 +4887,76 @@ private:
         // Per-voice filter instances to prevent cross-voice interference
         SimpleStableFilter voiceOsc1Filter;
         SimpleStableFilter voiceOsc2Filter;
+        VoiceFilterBank voiceFilterBank; // Both oscillators' state-variable filters as SIMD lanes
+        
+        // Last envelope gain of the louder oscillator, used by the quietest steal policy
+        float envelopeLevel = 0.0f;
+        bool hardStopped = false; // Stopped without a tail and not yet restarted
+        
+        // Voice-local scratch buffers for block rendering
+        static constexpr int subBlockSize = 32; // Parameters are snapshotted once per sub-block
+        alignas(16) float osc1Left[subBlockSize] = {};
+        alignas(16) float osc1Right[subBlockSize] = {};
+        alignas(16) float osc2Left[subBlockSize] = {};
+        alignas(16) float osc2Right[subBlockSize] = {};
+        alignas(16) float filterFrames[subBlockSize * VoiceFilterBank::numLanes] = {};
+        alignas(16) float envelopeGains[subBlockSize] = {};
+        alignas(16) float noiseLeft[subBlockSize] = {};
+        alignas(16) float noiseRight[subBlockSize] = {};
+    };
+    
+    // Audio-thread parameter handoff
+    ParameterChangeQueue<SummonerXSerum2AudioProcessor> parameterChanges;
+    std::atomic<bool> audioThreadActive { false };
+    std::vector<SineWaveVoice*> sineVoices; // The voice pool, owned by the synthesiser
+    
+    // LFO settings (message thread)
+    static constexpr int numLfoSyncDivisions = 21;
+    static double getLfoSyncBeats(int division);
+    float lfoRate = 1.0f; // Hz, 0.001 to 100
+    int lfoMode = 0; // 0 = free, 1 = retrigger, 2 = tempo sync
+    int lfoSyncDivision = 5; // 0 = 32 bars ... 5 = 1 bar ... 20 = 1/256
+    int lfoControlInterval = 32; // Samples between LFO evaluations
+    std::vector<float> lfoShapePoints;
+    struct LfoRouteSetting
+    {
+        std::string parameter; // Empty = unused
+        float depth = 0.0f;
+        float base = 0.0f; // Last value of the parameter passed to the audio thread
     };
+    std::array<LfoRouteSetting, maxLfoRoutes> lfoRouteSettings;
+    void updateLfoRouteBases();
+    
+    // LFO engine and routes (audio thread). Routes name their target by index into
+    // lfoTargets, the parameterMap entries with a modulate function, so they fit the parameter queue.
+    // Once per control block a route moves its target's engine to the base value plus
+    // the LFO offset through the target's modulate function.
+    struct LfoRoute
+    {
+        const ParameterInfo* target = nullptr;
+        float base = 0.0f;
+        float depth = 0.0f;
+    };
+    LfoEngine lfo;
+    std::array<LfoRoute, maxLfoRoutes> lfoRoutes;
+    int numActiveLfoRoutes = 0;
+    double hostBpm = 120.0; // Last tempo reported by the host
+    std::vector<const ParameterInfo*> lfoTargets;
+    std::atomic<float> lfoDisplayValue { 0.0f };
+    
+    // New shapes are compiled into tables and handed over like tunings
+    juce::AbstractFifo lfoShapeFifo { 4 };
+    std::array<LfoEngine::Table, 4> pendingLfoShapes;
+    void publishLfoShape(const LfoEngine::Table& table);
+    void applyPendingLfoShape();
+    
+    void applyLfoModulation(const juce::MidiBuffer& midiMessages, int startSample, int numSamples);
+    void renderSegment(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages, int startSample, int numSamples);
+    
+    // Reverb impulse response; an empty file means the built-in one
+    juce::File reverbImpulseFile;
+    double reverbImpulseSampleRate = 0.0; // Rate of the last queued build
+    void queueReverbImpulseBuild();
     
     // Preset management system - private members
     juce::String currentPresetName = "DEFAULT";
@@ -4630,6 +4964,10 @@ private:
     std::vector<juce::File> availablePresets;
     juce::File presetDirectory;
     
+    // Host state header, see getStateInformation
+    static constexpr int stateMagic = 0x32535853; // "SXS2" read as little-endian bytes
+    static constexpr int stateVersion = 1;
+    
     // Preset helper functions
     juce::ValueTree createPresetData();
     bool applyPresetData(const juce::ValueTree& presetData);
@@ -4646,6 +4984,10 @@ private:
                                   bool enableOsc2, float filterCutoff);
     */
     // ============================================================================
+    
+    // Builds reverb convolvers. Declared last so it is destroyed first, waiting for a
+    // running build before the reverb it hands the result to goes away.
+    juce::ThreadPool impulseLoader { 1 };
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SummonerXSerum2AudioProcessor)
 };
@@ -100,6 +100,10 @@ SynthesizerComponent::SynthesizerComponent(SummonerXSerum2AudioProcessor& proces
     // LFO MODULE
     lfoModule.setLookAndFeel(&customKnobLookAndFeel, &customWaveButtonLookAndFeel, &ledLabelLookAndFeel);
     addAndMakeVisible(lfoModule);
+    lfoModule.onShapeChanged = [this](const std::vector<float>& points) { audioProcessor.setLfoShape(points); };
+    lfoModule.onRateChanged = [this](float rateHz) { audioProcessor.setLfoRate(rateHz); };
+    lfoModule.onModeChanged = [this](int mode) { audioProcessor.setLfoMode(mode); };
+    lfoModule.onSyncDivisionChanged = [this](int division) { audioProcessor.setLfoSyncDivision(division); };
     
     // EFFECTS MODULE - Digital Screen Style
     effectsModule.setTabBarDepth(29); // Back to single row height
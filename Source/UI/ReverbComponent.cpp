@@ -38,6 +38,10 @@ ReverbComponent::ReverbComponent()
     reverbTypeValueLabel.addMouseListener(this, false);
     addAndMakeVisible(reverbTypeValueLabel);
     
+    // Impulse response file button (IMPULSE type only)
+    reverbLoadImpulseButton.setButtonText("LOAD IR");
+    addChildComponent(reverbLoadImpulseButton);
+    
     // Low Cut knob
     reverbLowCutKnob.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
     reverbLowCutKnob.setTextBoxStyle(juce::Slider::NoTextBox, false, 0, 0);
@@ -112,6 +116,7 @@ ReverbComponent::ReverbComponent()
     
     // Add listeners for reverb controls
     reverbPowerButton.addListener(this);
+    reverbLoadImpulseButton.addListener(this);
     reverbMixKnob.addListener(this);
     reverbLowCutKnob.addListener(this);
     reverbHighCutKnob.addListener(this);
@@ -174,6 +179,10 @@ void ReverbComponent::buttonClicked(juce::Button* button)
     {
         parentSynthesizer->audioProcessor.setReverbEnabled(reverbPowerButton.getToggleState());
     }
+    else if (button == &reverbLoadImpulseButton)
+    {
+        showLoadImpulseDialog();
+    }
 }
 
 void ReverbComponent::mouseDown(const juce::MouseEvent& event)
@@ -187,12 +196,13 @@ void ReverbComponent::mouseDown(const juce::MouseEvent& event)
 
 void ReverbComponent::cycleReverbType()
 {
-    // Cycle from 1 to 5, then back to 1
+    // Cycle from 1 to 6, then back to 1
     currentReverbType++;
-    if (currentReverbType > 5)
+    if (currentReverbType > 6)
         currentReverbType = 1;
         
     reverbTypeValueLabel.setText(reverbTypes[currentReverbType - 1], juce::dontSendNotification);
+    updateImpulseButton();
     
     if (parentSynthesizer != nullptr)
     {
@@ -215,15 +225,58 @@ void ReverbComponent::syncWithDSPState()
     
     // Sync reverb type
     currentReverbType = parentSynthesizer->audioProcessor.getReverbType();
-    if (currentReverbType >= 1 && currentReverbType <= 5)
+    if (currentReverbType >= 1 && currentReverbType <= 6)
     {
         reverbTypeValueLabel.setText(reverbTypes[currentReverbType - 1], juce::dontSendNotification);
     }
+    updateImpulseButton();
+}
+
+void ReverbComponent::showLoadImpulseDialog()
+{
+    if (parentSynthesizer == nullptr) return;
+    
+    auto chooser = std::make_shared<juce::FileChooser>("Load Impulse Response",
+                                                       parentSynthesizer->audioProcessor.getReverbImpulseFile(),
+                                                       "*.wav;*.aif;*.aiff",
+                                                       true);
+
+    chooser->launchAsync(juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles,
+                        [this, chooser](const juce::FileChooser& fc) mutable
+                        {
+                            auto file = fc.getResult();
+                            if (file == juce::File{} || parentSynthesizer == nullptr)
+                                return;
+
+                            if (parentSynthesizer->audioProcessor.loadReverbImpulse(file))
+                            {
+                                updateImpulseButton();
+                            }
+                            else
+                            {
+                                juce::AlertWindow::showMessageBoxAsync(
+                                    juce::AlertWindow::WarningIcon,
+                                    "Error",
+                                    "Failed to load impulse response: " + file.getFileName());
+                            }
+                        });
+}
+
+void ReverbComponent::updateImpulseButton()
+{
+    reverbLoadImpulseButton.setVisible(currentReverbType == 6);
+    
+    // The button shows which file is loaded; the built-in impulse has no file
+    juce::String tooltip = "Built-in impulse";
+    if (parentSynthesizer != nullptr && parentSynthesizer->audioProcessor.getReverbImpulseFile() != juce::File{})
+        tooltip = parentSynthesizer->audioProcessor.getReverbImpulseFile().getFileName();
+    reverbLoadImpulseButton.setTooltip(tooltip);
 }
 
 void ReverbComponent::setLookAndFeels(juce::LookAndFeel* digitalKnobLAF, juce::LookAndFeel* digitalButtonLAF, juce::LookAndFeel* ledNumberLAF)
 {
     reverbPowerButton.setLookAndFeel(digitalButtonLAF);
+    reverbLoadImpulseButton.setLookAndFeel(digitalButtonLAF);
     reverbMixKnob.setLookAndFeel(digitalKnobLAF);
     reverbLowCutKnob.setLookAndFeel(digitalKnobLAF);
     reverbHighCutKnob.setLookAndFeel(digitalKnobLAF);
@@ -253,6 +306,7 @@ void ReverbComponent::layoutControls(juce::Rectangle<int> bounds)
     // Row 2: Reverb Type (clickable label)
     reverbTypeLabel.setBounds(49, 125, 200, 15);
     reverbTypeValueLabel.setBounds(49, 145, 200, 20);
+    reverbLoadImpulseButton.setBounds(109, 166, 80, 16);
     
     // Row 3: Low Cut and High Cut
     reverbLowCutKnob.setBounds(89, 185, 50, 50);
@@ -47,10 +47,15 @@ private:
     SynthesizerComponent* parentSynthesizer = nullptr;
     
     // Reverb type cycling  
-    int currentReverbType = 1; // 1=PLATE, 2=HALL, 3=VINTAGE, 4=ROOM, 5=AMBIENCE
-    std::vector<juce::String> reverbTypes = {"PLATE", "HALL", "VINTAGE", "ROOM", "AMBIENCE"};
+    int currentReverbType = 1; // 1=PLATE, 2=HALL, 3=VINTAGE, 4=ROOM, 5=AMBIENCE, 6=IMPULSE
+    std::vector<juce::String> reverbTypes = {"PLATE", "HALL", "VINTAGE", "ROOM", "AMBIENCE", "IMPULSE"};
     void cycleReverbType();
     
+    // Impulse response loading, shown only for the IMPULSE type
+    juce::TextButton reverbLoadImpulseButton;
+    void showLoadImpulseDialog();
+    void updateImpulseButton();
+    
     // Reverb effect labels
     juce::Label reverbMixLabel;
     juce::Label reverbTypeLabel;
@@ -0,0 +1,16 @@
+#include <JuceHeader.h>
+
+// Runs every juce::UnitTest linked into the app. The exit code is non-zero if any failed,
+// so the Release and Scalar SIMD configurations can both be run from a script or CI.
+int main()
+{
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+    runner.runAllTests();
+
+    for (int i = 0; i < runner.getNumResults(); ++i)
+        if (runner.getResult(i)->failures > 0)
+            return 1;
+
+    return 0;
+}